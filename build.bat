@@ -59,11 +59,50 @@ if %ERRORLEVEL% NEQ 0 goto :error
 g++ -c src\csv_manager.cpp -I include -o obj\csv_manager.o -std=c++11 -O2 -Wall
 if %ERRORLEVEL% NEQ 0 goto :error
 
+g++ -c src\simulation.cpp -I include -o obj\simulation.o -std=c++11 -O2 -Wall -pthread
+if %ERRORLEVEL% NEQ 0 goto :error
+
+g++ -c src\platform_allocator.cpp -I include -o obj\platform_allocator.o -std=c++11 -O2 -Wall
+if %ERRORLEVEL% NEQ 0 goto :error
+
+g++ -c src\headway_optimizer.cpp -I include -o obj\headway_optimizer.o -std=c++11 -O2 -Wall
+if %ERRORLEVEL% NEQ 0 goto :error
+
+g++ -c src\service_loader.cpp -I include -o obj\service_loader.o -std=c++11 -O2 -Wall
+if %ERRORLEVEL% NEQ 0 goto :error
+
+g++ -c src\string_table.cpp -I include -o obj\string_table.o -std=c++11 -O2 -Wall
+if %ERRORLEVEL% NEQ 0 goto :error
+
+g++ -c src\ticket_journal.cpp -I include -o obj\ticket_journal.o -std=c++11 -O2 -Wall -pthread
+if %ERRORLEVEL% NEQ 0 goto :error
+
+g++ -c src\change_log.cpp -I include -o obj\change_log.o -std=c++11 -O2 -Wall
+if %ERRORLEVEL% NEQ 0 goto :error
+
+g++ -c src\mapped_csv.cpp -I include -o obj\mapped_csv.o -std=c++11 -O2 -Wall
+if %ERRORLEVEL% NEQ 0 goto :error
+
+g++ -c src\ticket_store.cpp -I include -o obj\ticket_store.o -std=c++11 -O2 -Wall -pthread
+if %ERRORLEVEL% NEQ 0 goto :error
+
+g++ -c src\system_image.cpp -I include -o obj\system_image.o -std=c++11 -O2 -Wall
+if %ERRORLEVEL% NEQ 0 goto :error
+
+g++ -c src\ticket_segment.cpp -I include -o obj\ticket_segment.o -std=c++11 -O2 -Wall
+if %ERRORLEVEL% NEQ 0 goto :error
+
+g++ -c src\ticket_archive.cpp -I include -o obj\ticket_archive.o -std=c++11 -O2 -Wall -pthread
+if %ERRORLEVEL% NEQ 0 goto :error
+
+g++ -c src\passenger_flow.cpp -I include -o obj\passenger_flow.o -std=c++11 -O2 -Wall -pthread
+if %ERRORLEVEL% NEQ 0 goto :error
+
 echo.
 echo [3/3] Linking executable...
 
 REM Link all object files
-g++ obj\*.o -o commute.exe -std=c++11
+g++ obj\*.o -o commute.exe -std=c++11 -pthread
 if %ERRORLEVEL% NEQ 0 goto :error
 
 echo.
@@ -21,7 +21,7 @@ NC='\033[0m' # No Color
 
 # Configuration
 CXX=g++
-CXXFLAGS="-std=c++11 -Wall -Wextra -I include"
+CXXFLAGS="-std=c++11 -Wall -Wextra -pthread -I include"
 OPTIMIZATION="-O2"
 TARGET="commute"
 OBJ_DIR="obj"
@@ -80,6 +80,19 @@ compile_sources() {
         "queue_manager"
         "analytics"
         "csv_manager"
+        "simulation"
+        "platform_allocator"
+        "headway_optimizer"
+        "service_loader"
+        "string_table"
+        "ticket_journal"
+        "change_log"
+        "mapped_csv"
+        "ticket_store"
+        "system_image"
+        "ticket_segment"
+        "ticket_archive"
+        "passenger_flow"
     )
     
     for src in "${sources[@]}"; do
@@ -93,7 +106,7 @@ compile_sources() {
 # Function to link executable
 link_executable() {
     print_info "Linking executable..."
-    $CXX $OBJ_DIR/*.o -o $TARGET
+    $CXX $OBJ_DIR/*.o -o $TARGET -pthread
     print_success "Executable created: $TARGET"
 }
 
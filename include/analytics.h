@@ -1,7 +1,7 @@
 /**
  * ======================================================================================
  * HEADER: analytics.h
- * DESCRIPTION: Station search using BST and analytics helper functions
+ * DESCRIPTION: Station search index and analytics helper functions
  * ======================================================================================
  */
 
@@ -14,7 +14,7 @@
 
 // Forward declaration
 class TicketSystem;
-class StationBST;  // Forward declaration - defined in station.h
+class StationDirectory;  // Forward declaration - defined in station.h
 
 // ======================================================================================
 //                                   ANALYTICS FUNCTIONS
@@ -45,4 +45,10 @@ void displayPeakHourStatistics();
  */
 void displayComprehensiveAnalytics(const TicketSystem& ticketSystem);
 
+/**
+ * Displays revenue and top origin-destination pairs over the full ticket
+ * history, scanning only the needed columns of the columnar store
+ */
+void displayTicketHistoryReport();
+
 #endif // ANALYTICS_H
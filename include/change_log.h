@@ -0,0 +1,102 @@
+/**
+ * ======================================================================================
+ * HEADER: change_log.h
+ * DESCRIPTION: Crash-safe persistence of the network - append-only change log
+ *              (write-ahead) plus periodically compacted snapshots
+ * ======================================================================================
+ */
+
+#ifndef CHANGE_LOG_H
+#define CHANGE_LOG_H
+
+#include <string>
+#include <cstdint>
+#include "station.h"
+#include "graph.h"
+
+const int CHANGE_LOG_COMPACT_RECORDS = 4096;   // Log records before an automatic snapshot
+const size_t CHANGE_LOG_FLOW_BATCH = 4096;     // Bytes of passenger-flow records per write()
+
+/**
+ * Change Log (WAL + snapshots)
+ *
+ * Files:
+ * - network.snapshot: every station and track as of sequence number N,
+ *   closed by an END line carrying a row count and checksum. Written to a
+ *   temp file, fsynced and renamed over the old one (then the directory
+ *   is fsynced), so a crash leaves either the old or the new snapshot,
+ *   never a half-written one
+ * - network.log: one line per change, "seq,type,fields...*checksum"
+ *     E,u,v,weight,distance,line   track added
+ *     B,u,v                        track blocked
+ *     P,stationId,delta            station passenger flow (ticket issued)
+ *
+ * Recovery:
+ * - Load the snapshot, replay log records with seq > N, stop at the first
+ *   torn or corrupt line (and cut it off before appending again)
+ *
+ * Cost:
+ * - A network change costs one write() + fsync. Passenger flow records are
+ *   buffered and go out with the next network change, once
+ *   CHANGE_LOG_FLOW_BATCH bytes are pending, or on close(), never fsynced
+ *   on their own: a crash loses at most that batch of counts, and the
+ *   tickets themselves are in the ticket journal
+ * - checkpoint() rewrites the snapshot and empties the log; it runs every
+ *   compactEvery records and on exit, so restart replays a bounded tail
+ *
+ * Time Complexity: O(1) per change, O(stations + tracks) per checkpoint
+ */
+class ChangeLog {
+    std::string logPath;
+    std::string snapshotPath;
+    int compactEvery;
+    int fd;
+    RailwayNetwork* network;
+
+    uint64_t nextSeq;
+    uint64_t snapshotSeq;
+    int recordsSinceSnapshot;
+    long long validLogBytes;    // Length of the replayable log prefix (-1 = unknown)
+    std::string pendingFlow;    // Passenger flow records not yet written
+    uint64_t pendingSeq;        // Seq of the first of them
+
+    bool appendRecord(char type, const long long* fields, int count, bool sync);
+    bool writePending();
+    bool replayLog(int& replayed);
+
+public:
+    explicit ChangeLog(const std::string& logPath = "data/network.log",
+                       const std::string& snapshotPath = "data/network.snapshot",
+                       int compactEvery = CHANGE_LOG_COMPACT_RECORDS);
+    ~ChangeLog();
+
+    ChangeLog(const ChangeLog&) = delete;
+    ChangeLog& operator=(const ChangeLog&) = delete;
+
+    // Startup: snapshot -> allStations / adj (via network), then the log tail.
+    // Returns false if there is no valid snapshot (caller seeds from CSV or
+    // built-in data, then calls open() and checkpoint())
+    bool recover(RailwayNetwork* network, int& replayed);
+
+    // Startup from a newer base (the binary system image): the network is
+    // already installed as of baseSeq; replay only the records after it.
+    // canResume() is false if the text snapshot is newer than baseSeq (the
+    // log no longer holds every record since then) or missing.
+    bool canResume(uint64_t baseSeq) const;
+    void resume(RailwayNetwork* network, uint64_t baseSeq, int& replayed);
+
+    bool open(RailwayNetwork* network);     // Start appending (drops a torn tail)
+    bool checkpoint();                       // Snapshot current state, empty the log
+    bool close();                            // Writes pending flow, fsyncs
+
+    // Change events (call after applying the change in memory). Return
+    // false if the record could not be written (or fsynced)
+    bool logTrackAdded(int u, int v, int weight, int distance, LineType line);
+    bool logTrackBlocked(int u, int v);
+    bool logPassengerFlow(int stationId, int delta);
+
+    uint64_t getSnapshotSeq() const { return snapshotSeq; }
+    int getPendingRecords() const { return recordsSinceSnapshot; }
+};
+
+#endif // CHANGE_LOG_H
@@ -13,6 +13,10 @@
 #include "station.h"
 #include "ticketing.h"
 #include "graph.h"
+#include "scheduling.h"
+
+// Bytes of tickets.csv per loader thread below which fewer threads are used
+const size_t TICKET_CHUNK_MIN_BYTES = 1 << 20;
 
 /**
  * Class: CSVManager
@@ -25,20 +29,23 @@ public:
     static const std::string TICKET_FILE;
     static const std::string ROUTE_FILE;
     static const std::string USER_FILE;
+    static const std::string TIMETABLE_FILE;
 
-    // Station Operations
-    static void saveStations(const std::vector<Station>& stations);
+    // Station Operations (save = CSV export, temp file + rename)
+    static bool saveStations(const std::vector<Station>& stations);
     static bool loadStations(std::vector<Station>& stations);
 
     // Ticket Operations
-    static void saveTickets(const std::vector<Passenger>& tickets);
-    static bool loadTickets(std::vector<Passenger>& tickets);
-    
-    // Append a single ticket (for real-time tracking)
-    static void appendTicket(const Passenger& ticket);
+    static bool saveTickets(const std::vector<Passenger>& tickets, const std::string& path = TICKET_FILE);
+    // Parallel, order-preserving load (threads: 0 = one per core)
+    static bool loadTickets(std::vector<Passenger>& tickets, int threads = 0);
+
+    // Timetable Operations (streamed straight into the Scheduler's bulk loader)
+    // Returns number of trains loaded, or -1 if the file cannot be opened
+    static int loadTimetable(Scheduler& scheduler, const std::string& path = TIMETABLE_FILE);
 
-    // Route Operations
-    static void saveRoutes(RailwayNetwork* network);
+    // Route Operations (save = CSV export of the adjacency list, temp file + rename)
+    static bool saveRoutes(const std::vector<std::vector<Edge>>& tracks);
     static bool loadRoutes(RailwayNetwork* network);
     
     // Directory Initialization
@@ -24,8 +24,7 @@ extern double FARE_PER_KM;
 
 // Station Management
 extern std::vector<Station> allStations;
-extern std::unordered_map<std::string, int> stationNameToId;
-extern std::unordered_map<int, std::string> stationIdToName;
+extern StationDirectory stationDirectory;   // Name <-> id (case-insensitive), prefix and fuzzy search
 
 // Graph Adjacency List
 extern std::vector<std::vector<Edge>> adj;
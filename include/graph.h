@@ -39,12 +39,16 @@ struct Edge {
 class RailwayNetwork {
     int V; // Number of vertices (stations)
     
+    // getDistance scratch, kept between calls so a fare lookup does not allocate
+    std::vector<int> distanceScratch;
+    std::vector<std::pair<int, int>> frontierScratch;
+    
 public:
     RailwayNetwork(int v);
     
     // Track Management
     void addTrack(int u, int v, int w, int distance, LineType line);
-    void blockTrack(int u, int v);
+    void blockTrack(int u, int v, bool announce = true);
     
     // Path Finding Algorithms
     void findFastestRoute(int src, int dest);  // Uses Dijkstra + Custom MyStack
@@ -54,7 +58,11 @@ public:
     void displayNetworkStats();                // Display graph statistics
     
     // Distance Query
-    int getDistance(int src, int dest);        // Get distance between two stations
+    int getDistance(int src, int dest);        // Get distance between two stations (not thread-safe)
+    
+    // Line Tracing
+    std::vector<Edge> traceLineRoute(int startNode, LineType line);  // Walk one line from a station
+    int getMinTravelTime();                    // Fastest open track (simulation lookahead)
 };
 
 #endif // GRAPH_H
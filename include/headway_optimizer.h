@@ -0,0 +1,82 @@
+/**
+ * ======================================================================================
+ * HEADER: headway_optimizer.h
+ * DESCRIPTION: Demand-driven headway planning from ticket history (time-bucketed
+ *              origin-destination demand -> per-line headways and extra trains)
+ * ======================================================================================
+ */
+
+#ifndef HEADWAY_OPTIMIZER_H
+#define HEADWAY_OPTIMIZER_H
+
+#include <vector>
+#include "scheduling.h"
+#include "ticketing.h"
+#include "ticket_archive.h"
+
+const int DEMAND_BUCKET_MINUTES = 15;
+const int DEMAND_BUCKETS = 24 * 60 / DEMAND_BUCKET_MINUTES;   // 96 per day
+
+// ======================================================================================
+//                                   PLAN STRUCTURES
+// ======================================================================================
+
+/**
+ * Plan for one (line, 15-minute bucket) that has demand
+ */
+struct LineBucketPlan {
+    LineType line;
+    int bucket;                 // 0..95, bucket * 15 = minutes from midnight
+    int forecastPassengers;     // Average daily tickets for this line/bucket
+    int scheduledTrains;        // Trains already departing in the bucket
+    int requiredTrains;         // ceil(forecast / the line's train capacity)
+    int extraTrains;            // max(0, required - scheduled)
+    int headwayMinutes;         // Resulting gap between departures
+    int originStationId;        // Busiest origin - extra trains start here
+};
+
+struct HeadwayPlan {
+    int historyDays;            // Distinct service days in the ticket history
+    int ticketsUsed;
+    std::vector<LineBucketPlan> buckets;
+    TrainBatch extraTrains;
+    double planningMs;
+};
+
+// ======================================================================================
+//                                   HEADWAY OPTIMIZER
+// ======================================================================================
+
+/**
+ * Headway Optimizer
+ *
+ * Algorithm:
+ * 1. Bucket every ticket by (line of origin, 15-minute slot of entryTime) and
+ *    keep origin-destination counts to find each bucket's busiest origin
+ * 2. Forecast = tickets in the bucket / number of distinct history days
+ * 3. Conservatively assume everyone in the bucket rides at the same time, so
+ *    trains needed = ceil(forecast / capacity), capacity being the mean
+ *    TrainInfo::capacity of the trains scheduled on the line (the default
+ *    capacity on a line with none)
+ * 4. Extra trains = needed - already scheduled, spread evenly in the bucket,
+ *    each with its line's capacity
+ *
+ * The Scheduler receives all extra trains in one batch (single heap build).
+ * History is pulled from a TicketHistoryCursor (day partitions + live
+ * store), so memory use does not grow with the number of tickets.
+ *
+ * Time Complexity: O(T + L * B) for T tickets, L lines, B buckets
+ */
+class HeadwayOptimizer {
+    int defaultCapacity;        // For lines with no scheduled train
+
+public:
+    HeadwayOptimizer(int defaultCapacity = DEFAULT_TRAIN_CAPACITY) : defaultCapacity(defaultCapacity) {}
+
+    // history needs source, dest and entryTime projected
+    HeadwayPlan plan(TicketHistoryCursor& history, const Scheduler& scheduler) const;
+};
+
+void showHeadwayPlan(const HeadwayPlan& plan);
+
+#endif // HEADWAY_OPTIMIZER_H
@@ -0,0 +1,138 @@
+/**
+ * ======================================================================================
+ * HEADER: mapped_csv.h
+ * DESCRIPTION: Zero-copy CSV reading - memory-mapped files and an in-place
+ *              field cursor (no getline / stringstream / stoi per field)
+ * ======================================================================================
+ */
+
+#ifndef MAPPED_CSV_H
+#define MAPPED_CSV_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+// ======================================================================================
+//                                   MAPPED FILE
+// ======================================================================================
+
+/**
+ * Read-only view of a whole file
+ * - POSIX: mmap(PROT_READ, MAP_PRIVATE) + madvise(SEQUENTIAL); nothing is copied
+ * - _WIN32: fallback that reads the file into one heap buffer
+ * An empty file opens successfully with begin() == end().
+ * openRange() maps only [offset, offset + length) of the file (the mapping
+ * starts at the enclosing page boundary), so a reader can touch one column
+ * of a binary file without mapping the rest.
+ */
+class MappedFile {
+    const char* data;
+    size_t length;
+    void* mapBase;          // Page-aligned start of the mapping (POSIX)
+    size_t mapLength;
+#ifdef _WIN32
+    std::vector<char> buffer;
+#endif
+
+public:
+    MappedFile() : data(NULL), length(0), mapBase(NULL), mapLength(0) {}
+    ~MappedFile() { close(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& path);
+    bool openRange(const std::string& path, size_t offset, size_t length);
+    void close();
+
+    const char* begin() const { return data; }
+    const char* end() const { return data + length; }
+    size_t size() const { return length; }
+};
+
+// ======================================================================================
+//                                   CSV CURSOR
+// ======================================================================================
+
+/**
+ * CSV Cursor - parses fields in place from a [begin, end) buffer
+ *
+ * Usage per row:
+ *   bool ok = in.readInt(a) && in.readString(s) && ...;
+ *   if (in.endRow() && ok) keep the row;    // endRow() always moves to the next line
+ *
+ * Features:
+ * - Skips a UTF-8 BOM; accepts LF and CRLF line endings
+ * - Line ends found with memchr (vectorised in the C library), fields
+ *   split with memchr over the current line only
+ * - Integers parsed by a digit loop (optional '-'); a field that is not
+ *   entirely a number fails the row instead of throwing
+ * - Quoted strings: "a, b" and "say ""hi""" are unescaped; a quoted field
+ *   may span lines
+ *
+ * Time Complexity: O(bytes) for the whole file
+ */
+class CsvCursor {
+    const char* pos;
+    const char* stop;       // End of buffer
+    const char* lineEnd;    // '\n' ending the current row (or stop)
+
+    void findLineEnd();
+    bool endOfField(const char* p) const {
+        return p == lineEnd || *p == ',' || *p == '\r';
+    }
+    void finishField();
+    bool readInteger(long long minValue, long long maxValue, long long& out);
+
+public:
+    CsvCursor(const char* begin, const char* end);
+
+    bool atEnd() const { return pos >= stop; }
+    const char* position() const { return pos; }
+    size_t countLines() const;  // Remaining lines (for reserve)
+
+    bool readInt(int& out);         // Fails on values outside int / long long
+    bool readLong(long long& out);
+    bool readString(std::string& out);
+
+    bool endRow();              // True if the row had no trailing garbage
+    void skipLine() { endRow(); }
+};
+
+/**
+ * Splits [begin, end) into at most 'parts' ranges for parallel parsing
+ * Returns the range edges (front() == begin, back() == end, strictly increasing).
+ * Every inner edge is the start of a row: just after a '\n' that is not
+ * inside a quoted field. Quote parity at each split point comes from
+ * counting '"' per range on 'parts' threads, so a quoted name holding a
+ * line break never straddles two ranges.
+ * 'begin' must itself be a row start (e.g. just past the header).
+ *
+ * Time Complexity: O(bytes / parts) per thread
+ */
+std::vector<const char*> splitCsvRows(const char* begin, const char* end, int parts);
+
+// ======================================================================================
+//                                   WRITING
+// ======================================================================================
+
+/**
+ * Appends 'text' as one CSV field, quoted only if it contains a comma,
+ * quote or line break - so names written here read back unchanged
+ */
+template <typename Out>
+void appendCsvText(Out& out, const std::string& text) {
+    if (text.find_first_of(",\"\r\n") == std::string::npos) {
+        out.insert(out.end(), text.begin(), text.end());
+        return;
+    }
+    out.push_back('"');
+    for (char c : text) {
+        if (c == '"') out.push_back('"');
+        out.push_back(c);
+    }
+    out.push_back('"');
+}
+
+#endif // MAPPED_CSV_H
@@ -0,0 +1,144 @@
+/**
+ * ======================================================================================
+ * HEADER: mpmc_queue.h
+ * DESCRIPTION: Bounded lock-free multi-producer / multi-consumer queue
+ *              (array of sequence-stamped cells, after D. Vyukov)
+ * ======================================================================================
+ */
+
+#ifndef MPMC_QUEUE_H
+#define MPMC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+/**
+ * Template Class: BoundedMPMCQueue
+ *
+ * Data Structure:
+ * - Ring of 2^k cells; each cell carries a sequence number next to its value
+ * - enqueuePos / dequeuePos are free-running tickets, each on its own cache line
+ *
+ * Protocol:
+ * - Producer at ticket p owns cell p & mask once cell.sequence == p; it claims
+ *   the ticket with a CAS, writes the value, then publishes sequence = p + 1
+ * - Consumer at ticket c owns the cell once sequence == c + 1; after reading
+ *   it releases the cell for the next lap with sequence = c + capacity
+ * - sequence < expected means full (push) / empty (pop): fail without blocking
+ *
+ * Properties:
+ * - No locks; one CAS per operation in the uncontended case
+ * - Producers and consumers only share the cell they hand over
+ * - Cells are constructed once and reused lap after lap: tryPushWith() /
+ *   tryPopWith() hand the caller the cell's object itself, so a producer can
+ *   assign into it and a consumer can swap it out, and heap buffers (e.g. a
+ *   std::string's) circulate instead of being freed and reallocated
+ *
+ * Time Complexity: O(1) per operation (lock-free, may retry under contention)
+ */
+template <typename T>
+class BoundedMPMCQueue {
+    static const size_t CACHE_LINE = 64;
+
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T data;
+    };
+
+    char padStart[CACHE_LINE];
+    Cell* buffer;
+    size_t mask;
+    char padBuffer[CACHE_LINE - sizeof(Cell*) - sizeof(size_t)];
+    std::atomic<size_t> enqueuePos;
+    char padEnqueue[CACHE_LINE - sizeof(std::atomic<size_t>)];
+    std::atomic<size_t> dequeuePos;
+    char padDequeue[CACHE_LINE - sizeof(std::atomic<size_t>)];
+
+public:
+    // Capacity is rounded up to a power of two (minimum 2)
+    explicit BoundedMPMCQueue(size_t capacity = 1024) {
+        size_t size = 2;
+        while (size < capacity) size <<= 1;
+        buffer = new Cell[size];
+        mask = size - 1;
+        for (size_t i = 0; i < size; i++) buffer[i].sequence.store(i, std::memory_order_relaxed);
+        enqueuePos.store(0, std::memory_order_relaxed);
+        dequeuePos.store(0, std::memory_order_relaxed);
+    }
+
+    ~BoundedMPMCQueue() { delete[] buffer; }
+
+    BoundedMPMCQueue(const BoundedMPMCQueue&) = delete;
+    BoundedMPMCQueue& operator=(const BoundedMPMCQueue&) = delete;
+
+    // fill(T& cell) writes the new element into the claimed cell in place
+    template <typename Fill>
+    bool tryPushWith(Fill&& fill) {
+        size_t pos = enqueuePos.load(std::memory_order_relaxed);
+        while (true) {
+            Cell* cell = &buffer[pos & mask];
+            size_t seq = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+            if (diff == 0) {
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    fill(cell->data);
+                    cell->sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;   // Full
+            } else {
+                pos = enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // take(T& cell) consumes the element in place; whatever it leaves in the
+    // cell is overwritten by a later push
+    template <typename Take>
+    bool tryPopWith(Take&& take) {
+        size_t pos = dequeuePos.load(std::memory_order_relaxed);
+        while (true) {
+            Cell* cell = &buffer[pos & mask];
+            size_t seq = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+            if (diff == 0) {
+                if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    take(cell->data);
+                    cell->sequence.store(pos + mask + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;   // Empty
+            } else {
+                pos = dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool tryPush(const T& value) { return tryPushWith([&](T& cell) { cell = value; }); }
+    bool tryPush(T&& value) { return tryPushWith([&](T& cell) { cell = std::move(value); }); }
+    bool tryPop(T& out) { return tryPopWith([&](T& cell) { out = std::move(cell); }); }
+
+    // Exchanges 'out' with the front element: the cell keeps out's old buffers
+    bool tryPopSwap(T& out) {
+        return tryPopWith([&](T& cell) {
+            using std::swap;
+            swap(out, cell);
+        });
+    }
+
+    // Snapshot only - exact when no other thread is operating on the queue
+    size_t sizeApprox() const {
+        size_t tail = enqueuePos.load(std::memory_order_acquire);
+        size_t head = dequeuePos.load(std::memory_order_acquire);
+        return tail > head ? tail - head : 0;
+    }
+
+    bool emptyApprox() const { return sizeApprox() == 0; }
+    size_t capacity() const { return mask + 1; }
+};
+
+#endif // MPMC_QUEUE_H
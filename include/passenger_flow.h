@@ -0,0 +1,98 @@
+/**
+ * ======================================================================================
+ * HEADER: passenger_flow.h
+ * DESCRIPTION: Time-bucketed passenger flow counters - per station, per direction,
+ *              per 15 minutes, sharded so booking threads record without contention
+ * ======================================================================================
+ */
+
+#ifndef PASSENGER_FLOW_H
+#define PASSENGER_FLOW_H
+
+#include <atomic>
+#include <vector>
+#include <cstdint>
+#include <ctime>
+#include "station.h"
+
+const int FLOW_BUCKET_MINUTES = 15;
+const int FLOW_BUCKETS = 24 * 60 / FLOW_BUCKET_MINUTES;     // 96 per day
+const int FLOW_SHARDS = 8;
+
+enum FlowDirection { FLOW_BOARDING, FLOW_ALIGHTING, FLOW_DIRECTIONS };
+
+// Bucket (0..95) of a time: local minutes from midnight / 15
+int flowBucketOf(time_t t);
+
+// ======================================================================================
+//                                   AGGREGATED VIEW
+// ======================================================================================
+
+/**
+ * Sum over every shard, taken by PassengerFlowCounters::summarize()
+ * Buckets are time of day, so a session running past midnight folds the
+ * days together.
+ */
+struct PassengerFlowSummary {
+    std::vector<uint64_t> station[FLOW_DIRECTIONS];     // By station id
+    uint64_t bucket[FLOW_DIRECTIONS][FLOW_BUCKETS];     // System-wide
+    uint64_t total[FLOW_DIRECTIONS];
+
+    uint64_t bucketTotal(int b) const { return bucket[FLOW_BOARDING][b] + bucket[FLOW_ALIGHTING][b]; }
+    uint64_t stationTotal(int id) const { return station[FLOW_BOARDING][id] + station[FLOW_ALIGHTING][id]; }
+    int busiestBucket() const;          // -1 if nothing was recorded
+};
+
+// ======================================================================================
+//                                   FLOW COUNTERS
+// ======================================================================================
+
+/**
+ * Passenger Flow Counters
+ *
+ * Data Structure:
+ * - FLOW_SHARDS shards, each a cache-line-aligned block of relaxed atomic
+ *   counters laid out [station][direction][bucket] for MAX_STATIONS stations
+ * - A thread takes a shard (round robin) the first time it records and keeps
+ *   it, so with up to FLOW_SHARDS threads no two writers share a cache line
+ *   and a record is one uncontended fetch_add
+ * - Readers sum the shards; a summary taken while threads record may miss
+ *   counts still in flight but never reads a torn value
+ *
+ * Memory: FLOW_SHARDS x MAX_STATIONS x 2 x 96 x 4 bytes (~600 KB), cleared
+ * on construction. Counts cover the running session. Every ticket path also
+ * adds to Station::passengerCount, which stays the persisted load read by
+ * congestion, top-station and snapshot code.
+ *
+ * Time Complexity: O(1) per record, O(shards x stations x buckets) per summary
+ */
+class PassengerFlowCounters {
+    static const size_t CACHE_LINE = 64;
+    static const int COUNTERS = MAX_STATIONS * FLOW_DIRECTIONS * FLOW_BUCKETS;
+
+    struct alignas(CACHE_LINE) Shard {
+        std::atomic<uint32_t> count[COUNTERS];
+    };
+    static_assert(sizeof(Shard) % CACHE_LINE == 0, "shards must not share a cache line");
+
+    Shard shards[FLOW_SHARDS];
+    std::atomic<unsigned> nextShard;
+
+    Shard& localShard();
+
+public:
+    PassengerFlowCounters();
+
+    // Count 'passengers' at a station in the bucket of 'when' (ids outside
+    // 0 .. MAX_STATIONS-1 are ignored). Safe from any thread.
+    void record(int stationId, FlowDirection direction, time_t when, uint32_t passengers = 1);
+    void recordBucket(int stationId, FlowDirection direction, int bucket, uint32_t passengers = 1);
+
+    PassengerFlowSummary summarize(size_t stationCount) const;
+    void reset();
+};
+
+// Session passenger flow fed by ticketing and read by the analytics reports
+extern PassengerFlowCounters passengerFlow;
+
+#endif // PASSENGER_FLOW_H
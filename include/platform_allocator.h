@@ -0,0 +1,80 @@
+/**
+ * ======================================================================================
+ * HEADER: platform_allocator.h
+ * DESCRIPTION: Per-station platform assignment as interval-graph coloring over
+ *              train dwell windows (sweep-line with a min-heap of free-at times)
+ * ======================================================================================
+ */
+
+#ifndef PLATFORM_ALLOCATOR_H
+#define PLATFORM_ALLOCATOR_H
+
+#include <vector>
+#include "scheduling.h"
+
+// ======================================================================================
+//                                   ALLOCATION RECORDS
+// ======================================================================================
+
+struct PlatformAssignment {
+    int trainId;
+    int arrivalTime;     // Scheduled arrival (minutes from midnight)
+    int occupiedFrom;    // When the train actually gets the platform
+    int occupiedUntil;   // occupiedFrom + dwell
+    int platform;        // 1-based platform number
+    int waitMinutes;     // occupiedFrom - arrivalTime (0 = no conflict)
+};
+
+struct StationPlatformPlan {
+    int stationId;
+    int platforms;                          // Station::platforms
+    int requiredPlatforms;                  // Maximum overlapping dwell windows
+    int conflicts;                          // Trains that had to wait outside
+    int totalWaitMinutes;
+    std::vector<PlatformAssignment> assignments;
+};
+
+// ======================================================================================
+//                                   PLATFORM ALLOCATOR
+// ======================================================================================
+
+/**
+ * Platform Allocator (Interval Scheduling)
+ *
+ * Model:
+ * - Every itinerary call is an interval [arrival, arrival + dwell)
+ * - Platforms are colors; overlapping intervals need different colors
+ *
+ * Algorithm (per station):
+ * - Sort calls by arrival (sweep line)
+ * - Min-heap of (freeAt, platform): the earliest-free platform is on top
+ * - If it is free by the arrival time the train takes it, otherwise every
+ *   platform is busy: a conflict is recorded and the train waits for it
+ * - A second heap of end times counts the platforms an ideal plan would need
+ *
+ * Incremental Update:
+ * - Stations are independent, so after a delay only the stations in
+ *   DelayReport::stationsAffected are re-swept
+ *
+ * Time Complexity: O(c log c) per station, c = calls at that station
+ */
+class PlatformAllocator {
+    std::vector<StationPlatformPlan> plans;     // Indexed by stationId
+    int dwellMinutes;
+
+    void allocateStation(const Scheduler& scheduler, int stationId);
+
+public:
+    PlatformAllocator(int dwell = 2) : dwellMinutes(dwell) {}
+
+    void allocateAll(const Scheduler& scheduler);
+    void reallocate(const Scheduler& scheduler, const std::vector<int>& stations);
+
+    const StationPlatformPlan* getPlan(int stationId) const;
+    int getTotalConflicts() const;
+
+    void showReport() const;                    // Network-wide summary
+    void showStationPlan(int stationId) const;  // Detailed per-platform listing
+};
+
+#endif // PLATFORM_ALLOCATOR_H
@@ -10,6 +10,10 @@
 #define QUEUE_MANAGER_H
 
 #include <iostream>
+#include <vector>
+#include <utility>
+#include <new>
+#include <type_traits>
 
 // ======================================================================================
 //                                   CUSTOM DATA STRUCTURES
@@ -17,7 +21,7 @@
 
 /**
  * Template Class: MyNode
- * Generic node for Linked List, Stack, and Queue.
+ * Generic node for the doubly linked MyList.
  */
 template <typename T>
 class MyNode {
@@ -26,98 +30,188 @@ public:
     MyNode* next;
     MyNode* prev; // For Doubly Linked List
 
-    MyNode(T val) : data(val), next(NULL), prev(NULL) {}
+    MyNode(T val) : data(std::move(val)), next(NULL), prev(NULL) {}
+};
+
+/**
+ * Template Class: MyNodePool
+ * Slab allocator for MyNode<T>.
+ *
+ * - Nodes are carved out of slabs of NODES_PER_SLAB, so a push costs one
+ *   allocation per slab instead of one per element
+ * - Released nodes go on an intrusive free list and are reused first
+ * - Slabs never move, so node pointers stay valid while the list grows
+ *
+ * Time Complexity: O(1) amortized create / destroy
+ */
+template <typename T>
+class MyNodePool {
+    typedef typename std::aligned_storage<sizeof(MyNode<T>), alignof(MyNode<T>)>::type Slot;
+    static const int NODES_PER_SLAB = 64;
+
+    std::vector<Slot*> slabs;
+    Slot* freeList;         // Released slots, linked through their first bytes
+    int usedInSlab;         // Slots handed out from the newest slab
+
+    void* allocate() {
+        if (freeList) {
+            Slot* slot = freeList;
+            freeList = *reinterpret_cast<Slot**>(slot);
+            return slot;
+        }
+        if (usedInSlab == NODES_PER_SLAB) {
+            slabs.push_back(new Slot[NODES_PER_SLAB]);
+            usedInSlab = 0;
+        }
+        return &slabs.back()[usedInSlab++];
+    }
+
+public:
+    MyNodePool() : freeList(NULL), usedInSlab(NODES_PER_SLAB) {}
+    MyNodePool(MyNodePool&& other)
+        : slabs(std::move(other.slabs)), freeList(other.freeList), usedInSlab(other.usedInSlab) {
+        other.slabs.clear();
+        other.freeList = NULL;
+        other.usedInSlab = NODES_PER_SLAB;
+    }
+    MyNodePool(const MyNodePool&) = delete;
+    MyNodePool& operator=(const MyNodePool&) = delete;
+
+    // Nodes must already be destroyed (MyList::clear does this)
+    ~MyNodePool() {
+        for (Slot* slab : slabs) delete[] slab;
+    }
+
+    void swap(MyNodePool& other) {
+        slabs.swap(other.slabs);
+        std::swap(freeList, other.freeList);
+        std::swap(usedInSlab, other.usedInSlab);
+    }
+
+    MyNode<T>* create(T val) {
+        return new (allocate()) MyNode<T>(std::move(val));
+    }
+
+    void destroy(MyNode<T>* node) {
+        node->~MyNode<T>();
+        Slot* slot = reinterpret_cast<Slot*>(node);
+        *reinterpret_cast<Slot**>(slot) = freeList;
+        freeList = slot;
+    }
 };
 
 /**
  * Template Class: MyStack
- * Custom implementation of Stack using Linked List.
+ * Custom implementation of Stack on a contiguous array (std::vector).
  * Operations: push, pop, top, empty.
- * Time Complexity: O(1) for all operations.
+ * Time Complexity: O(1) amortized for all operations.
  */
 template <typename T>
 class MyStack {
-    MyNode<T>* topNode;
-    int count;
+    std::vector<T> items;
 
 public:
-    MyStack() : topNode(NULL), count(0) {}
+    void push(T val) { items.push_back(std::move(val)); }
 
-    void push(T val) {
-        MyNode<T>* newNode = new MyNode<T>(val);
-        newNode->next = topNode;
-        topNode = newNode;
-        count++;
+    void pop() {
+        if (!items.empty()) items.pop_back();
     }
 
-    void pop() {
-        if (topNode) {
-            MyNode<T>* temp = topNode;
-            topNode = topNode->next;
-            delete temp;
-            count--;
-        }
+    // Reference to the top element (no copy); default value if empty
+    const T& top() const {
+        if (!items.empty()) return items.back();
+        return emptyValue();
     }
 
-    T top() {
-        if (topNode) return topNode->data;
-        return T(); // Return default if empty
+    static const T& emptyValue() {
+        static const T value = T();
+        return value;
     }
 
-    bool empty() { return topNode == NULL; }
-    int size() { return count; }
+    bool empty() { return items.empty(); }
+    int size() { return items.size(); }
 };
 
 /**
  * Template Class: MyQueue
- * Custom implementation of Queue using Linked List.
- * Operations: push, pop, front, empty.
- * Time Complexity: O(1) for all operations.
+ * Custom implementation of Queue as a growable circular buffer.
+ * Operations: push, emplace, pop, take, front, empty.
+ *
+ * - front() returns a reference and take() moves the element out, so
+ *   elements with heap members (strings) are never copied on the way through
+ * - Capacity is a power of two, so wrap-around is a mask instead of modulo
+ * - When full, elements are moved (in queue order) into a buffer twice the size
+ * - Popped slots are reset so strings etc. release their memory immediately
+ *
+ * Time Complexity: O(1) amortized for all operations.
  */
 template <typename T>
 class MyQueue {
-    MyNode<T>* frontNode;
-    MyNode<T>* rearNode;
+    std::vector<T> slots;
+    int head;
     int count;
 
+    void grow() {
+        int capacity = slots.empty() ? 16 : (int)slots.size() * 2;
+        std::vector<T> bigger(capacity);
+        for (int i = 0; i < count; i++) {
+            bigger[i] = std::move(slots[(head + i) & (slots.size() - 1)]);
+        }
+        slots.swap(bigger);
+        head = 0;
+    }
+
 public:
-    MyQueue() : frontNode(NULL), rearNode(NULL), count(0) {}
+    MyQueue() : head(0), count(0) {}
 
     void push(T val) {
-        MyNode<T>* newNode = new MyNode<T>(val);
-        if (rearNode == NULL) {
-            frontNode = rearNode = newNode;
-        } else {
-            rearNode->next = newNode;
-            rearNode = newNode;
-        }
+        if (count == (int)slots.size()) grow();
+        slots[(head + count) & (slots.size() - 1)] = std::move(val);
+        count++;
+    }
+
+    template <typename... Args>
+    void emplace(Args&&... args) {
+        if (count == (int)slots.size()) grow();
+        slots[(head + count) & (slots.size() - 1)] = T(std::forward<Args>(args)...);
         count++;
     }
 
     void pop() {
-        if (frontNode == NULL) return;
-        MyNode<T>* temp = frontNode;
-        frontNode = frontNode->next;
-        if (frontNode == NULL) rearNode = NULL;
-        delete temp;
+        if (count == 0) return;
+        slots[head] = T();
+        head = (head + 1) & (slots.size() - 1);
         count--;
     }
 
-    T front() {
-        if (frontNode) return frontNode->data;
-        return T();
+    // Reference to the oldest element (no copy); default value if empty
+    const T& front() const {
+        if (count > 0) return slots[head];
+        return MyStack<T>::emptyValue();
+    }
+
+    // Moves the oldest element out and pops it; default value if empty
+    T take() {
+        if (count == 0) return T();
+        T val = std::move(slots[head]);
+        pop();
+        return val;
     }
 
-    bool empty() { return frontNode == NULL; }
+    bool empty() { return count == 0; }
     int size() { return count; }
 };
 
 /**
  * Template Class: MyList
  * Custom implementation of Doubly Linked List.
+ * Nodes come from a per-list MyNodePool; the list owns them (RAII) and
+ * copies are deep.
  */
 template <typename T>
 class MyList {
+    MyNodePool<T> pool;
+
 public:
     MyNode<T>* head;
     MyNode<T>* tail;
@@ -125,8 +219,33 @@ public:
 
     MyList() : head(NULL), tail(NULL), count(0) {}
 
+    MyList(const MyList& other) : head(NULL), tail(NULL), count(0) {
+        for (MyNode<T>* node = other.head; node; node = node->next) push_back(node->data);
+    }
+
+    MyList(MyList&& other)
+        : pool(std::move(other.pool)), head(other.head), tail(other.tail), count(other.count) {
+        other.head = other.tail = NULL;
+        other.count = 0;
+    }
+
+    // Copy-and-swap: handles both copy and move assignment
+    MyList& operator=(MyList other) {
+        swap(other);
+        return *this;
+    }
+
+    ~MyList() { clear(); }
+
+    void swap(MyList& other) {
+        pool.swap(other.pool);
+        std::swap(head, other.head);
+        std::swap(tail, other.tail);
+        std::swap(count, other.count);
+    }
+
     void push_back(T val) {
-        MyNode<T>* newNode = new MyNode<T>(val);
+        MyNode<T>* newNode = pool.create(std::move(val));
         if (!head) {
             head = tail = newNode;
         } else {
@@ -137,6 +256,23 @@ public:
         count++;
     }
 
+    void pop_front() {
+        if (!head) return;
+        MyNode<T>* temp = head;
+        head = head->next;
+        if (head) head->prev = NULL;
+        else tail = NULL;
+        pool.destroy(temp);
+        count--;
+    }
+
+    void clear() {
+        while (head) pop_front();
+    }
+
+    bool empty() const { return head == NULL; }
+    int size() const { return count; }
+
     void display() {
         MyNode<T>* temp = head;
         while (temp) {
@@ -185,4 +321,15 @@ public:
     int getCapacity() const { return capacity; }
 };
 
+// ======================================================================================
+//                                   STRUCTURE TIMING
+// ======================================================================================
+
+/**
+ * Times MyQueue / MyStack / MyList against the linked-node versions they
+ * replaced (one heap node per element) on the same int workload, checks
+ * both produce the same pop order and prints the table
+ */
+void showStructureTiming(int operations);
+
 #endif // QUEUE_MANAGER_H
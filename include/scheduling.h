@@ -10,20 +10,29 @@
 
 #include <string>
 #include <vector>
+#include <unordered_map>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <cstdint>
 #include "station.h"
+#include "string_table.h"
+#include "graph.h"
 
 // ======================================================================================
 //                                   TRAIN STRUCTURE
 // ======================================================================================
 
+/**
+ * Hot scheduling record - everything the heap compares or updates.
+ * Kept at 16 bytes with no owning members so heap swaps are plain copies.
+ */
 struct Train {
-    int trainId;
-    std::string name;
-    int capacity;
-    int currentLoad;
-    int nextStationId;
-    int arrivalTime; // Minutes from midnight
-    TrainStatus status;
+    int32_t trainId;
+    int32_t arrivalTime;        // Minutes from midnight
+    int16_t nextStationId;
+    uint16_t currentLoad;
+    uint8_t status;             // TrainStatus
 
     // Operator for MinHeap
     bool operator>(const Train& other) const {
@@ -34,6 +43,77 @@ struct Train {
     }
 };
 
+static_assert(sizeof(Train) == 16, "Train hot record must stay 16 bytes");
+
+const int DEFAULT_TRAIN_CAPACITY = 2000;    // Standard Mumbai Local capacity
+
+/**
+ * Cold metadata - only read for display and load planning
+ */
+struct TrainInfo {
+    uint32_t nameId;            // Index into trainNames
+    int capacity;
+};
+
+// Interned train names ("Virar Fast" is stored once for all its departures)
+extern StringTable trainNames;
+
+/**
+ * A batch of new trains: hot records for the heap plus parallel metadata
+ */
+struct TrainBatch {
+    std::vector<Train> trains;
+    std::vector<TrainInfo> info;
+
+    void add(int trainId, uint32_t nameId, int departure, int startStationId,
+             int capacity = DEFAULT_TRAIN_CAPACITY) {
+        Train t;
+        t.trainId = trainId;
+        t.arrivalTime = departure;
+        t.nextStationId = startStationId;
+        t.currentLoad = 0;
+        t.status = ON_TIME;
+        trains.push_back(t);
+
+        TrainInfo i = { nameId, capacity };
+        info.push_back(i);
+    }
+    void reserve(size_t n) { trains.reserve(n); info.reserve(n); }
+    size_t size() const { return trains.size(); }
+    bool empty() const { return trains.empty(); }
+};
+
+/**
+ * One stop of a train's itinerary (arrival time in minutes from midnight)
+ */
+struct TrainStop {
+    int stationId;
+    int arrivalTime;
+};
+
+// A stop pattern shared by every train that runs it (times relative to an offset)
+typedef std::shared_ptr<const std::vector<TrainStop>> SharedRoute;
+
+/**
+ * A reported delay: trainId is running delayMinutes late at stationId
+ */
+struct DelayEvent {
+    int trainId;
+    int stationId;
+    int delayMinutes;
+};
+
+/**
+ * Summary of one propagation run
+ */
+struct DelayReport {
+    int trainsAffected;     // Distinct trains whose times changed
+    int stopsUpdated;       // Total stop arrival times rewritten
+    int connectionsHeld;    // Connecting trains held at interchanges
+    int connectionsBroken;  // Connections missed (hold would exceed limit)
+    std::vector<int> stationsAffected;  // Stations whose call times changed
+};
+
 // ======================================================================================
 //                                   MIN HEAP TEMPLATE
 // ======================================================================================
@@ -94,6 +174,149 @@ public:
     std::vector<T> getVector() { return heap; }
 };
 
+/**
+ * Template Class: IndexedMinHeap
+ * Min Heap that also remembers where each element lives (keyed by trainId),
+ * so one element's priority can be changed without rebuilding the heap.
+ * 
+ * Extra Operations:
+ * - contains(id) / find(id): O(1) lookup via position index
+ * - update(val): replace the element with the same trainId, sift up or down, O(log n)
+ *
+ * trainIds are unique: pushing an id that is already present replaces that
+ * element (the later one wins) instead of adding a second entry.
+ */
+template <typename T>
+class IndexedMinHeap {
+    std::vector<T> heap;
+    std::unordered_map<int, int> position;  // trainId -> index in heap
+
+    void swapNodes(int a, int b) {
+        std::swap(heap[a], heap[b]);
+        position[heap[a].trainId] = a;
+        position[heap[b].trainId] = b;
+    }
+
+    void heapifyUp(int index) {
+        if (index == 0) return;
+        int parent = (index - 1) / 2;
+        if (heap[parent] > heap[index]) {
+            swapNodes(parent, index);
+            heapifyUp(parent);
+        }
+    }
+
+    void heapifyDown(int index) {
+        int left = 2 * index + 1;
+        int right = 2 * index + 2;
+        int smallest = index;
+
+        if (left < (int)heap.size() && heap[left] < heap[smallest]) smallest = left;
+        if (right < (int)heap.size() && heap[right] < heap[smallest]) smallest = right;
+
+        if (smallest != index) {
+            swapNodes(index, smallest);
+            heapifyDown(smallest);
+        }
+    }
+
+public:
+    void push(T val) {
+        if (contains(val.trainId)) {
+            update(val);
+            return;
+        }
+        heap.push_back(std::move(val));
+        position[heap.back().trainId] = (int)heap.size() - 1;
+        heapifyUp((int)heap.size() - 1);
+    }
+
+    void pop() {
+        if (heap.empty()) return;
+        position.erase(heap[0].trainId);
+        heap[0] = heap.back();
+        heap.pop_back();
+        if (!heap.empty()) {
+            position[heap[0].trainId] = 0;
+            heapifyDown(0);
+        }
+    }
+
+    T top() {
+        if (!heap.empty()) return heap[0];
+        return T();
+    }
+
+    bool contains(int id) const { return position.count(id) > 0; }
+
+    const T* find(int id) const {
+        auto it = position.find(id);
+        return it == position.end() ? NULL : &heap[it->second];
+    }
+
+    // Replace the element carrying val.trainId and restore heap order
+    void update(const T& val) {
+        auto it = position.find(val.trainId);
+        if (it == position.end()) return;
+        int index = it->second;
+        heap[index] = val;
+        heapifyUp(index);
+        heapifyDown(position[val.trainId]);
+    }
+
+    /**
+     * Appends a range of elements and restores heap order with one bottom-up
+     * (Floyd) build: O(n + k) instead of k separate O(log n) pushes.
+     * Pass std::move_iterator to move elements instead of copying them.
+     */
+    template <typename Iterator>
+    void pushBatch(Iterator first, Iterator last) {
+        if (first == last) return;
+        for (; first != last; ++first) {
+            auto slot = position.insert(std::make_pair((*first).trainId, (int)heap.size()));
+            if (slot.second) heap.push_back(*first);
+            else heap[slot.first->second] = *first;     // Duplicate id: replace
+        }
+        buildHeap();
+    }
+
+    // Takes ownership of a whole vector; when the heap is empty no element is copied
+    void pushBatch(std::vector<T>&& vals) {
+        if (heap.empty()) {
+            heap = std::move(vals);
+            position.clear();
+            position.reserve(heap.size());
+            int kept = 0;
+            for (int i = 0; i < (int)heap.size(); i++) {
+                auto slot = position.insert(std::make_pair(heap[i].trainId, kept));
+                if (!slot.second) {
+                    heap[slot.first->second] = std::move(heap[i]);  // Duplicate id: replace
+                } else {
+                    if (kept != i) heap[kept] = std::move(heap[i]);
+                    kept++;
+                }
+            }
+            heap.erase(heap.begin() + kept, heap.end());
+            buildHeap();
+        } else {
+            pushBatch(std::make_move_iterator(vals.begin()), std::make_move_iterator(vals.end()));
+            vals.clear();
+        }
+    }
+
+    // Floyd's build-heap: sift down every internal node, last to first
+    void buildHeap() {
+        for (int i = (int)heap.size() / 2 - 1; i >= 0; i--) {
+            heapifyDown(i);
+        }
+    }
+
+    bool empty() const { return heap.empty(); }
+    int size() const { return heap.size(); }
+    
+    std::vector<T> getVector() const { return heap; }
+};
+
 // ======================================================================================
 //                                   SCHEDULER CLASS
 // ======================================================================================
@@ -104,28 +327,87 @@ public:
  * Features:
  * - Priority-based scheduling (earliest arrival time first)
  * - Automatic sorting via MinHeap (O(log n) insertion)
- * - Peak hour optimization with dynamic frequency adjustment
+ * - Demand-driven frequency optimization (batched heap build)
  * - Real-time schedule display with time formatting
  * - Train status tracking (ON_TIME, DELAYED, CANCELLED)
  * 
- * Data Structure: MinHeap<Train>
+ * Data Structure: IndexedMinHeap<Train>
  * - Maintains trains sorted by arrivalTime
  * - Efficient O(log n) operations for add/remove
  * - Custom operator< in Train struct defines priority
+ * - trainId index allows in-place re-keying when a train is delayed
+ * - Heap holds 16-byte hot records; names (interned) and capacity live in
+ *   the trainInfo side table and are only looked up for display
+ * 
+ * Delay Propagation:
+ * - Each train may carry an itinerary (ordered TrainStop list)
+ * - A delay shifts that train's later stops and holds connecting trains at
+ *   interchange stations (MIN_TRANSFER_TIME, at most MAX_CONNECTION_HOLD)
+ * - Only affected trains are re-keyed in the heap
  */
 class Scheduler {
-    MinHeap<Train> trainSchedule;  // Priority queue using custom MinHeap
+    IndexedMinHeap<Train> trainSchedule;  // Priority queue using custom MinHeap (hot records)
+    std::unordered_map<int, TrainInfo> trainInfo;  // trainId -> cold metadata
+    
+    /**
+     * A train's itinerary: a shared route shifted by 'offset' minutes, so
+     * trains on the same stop pattern share one stop list. A delay gives the
+     * train its own copy ('own', route reset) before changing any time.
+     * The heap entry refers to stop 0.
+     */
+    struct TrainRun {
+        SharedRoute route;
+        int offset;
+        std::vector<TrainStop> own;
+
+        int size() const { return route ? (int)route->size() : (int)own.size(); }
+        int station(int i) const { return route ? (*route)[i].stationId : own[i].stationId; }
+        int arrival(int i) const { return route ? (*route)[i].arrivalTime + offset : own[i].arrivalTime; }
+        void makeOwn();
+    };
+    struct StopRef {
+        int trainId;
+        int stopIndex;
+    };
+    std::unordered_map<int, TrainRun> runs;                       // trainId -> itinerary
+    std::unordered_map<int, std::vector<StopRef>> stationStops;   // stationId -> visiting stops
+    
+    void attachRun(int trainId, TrainRun&& run);
+    void propagate(const DelayEvent& event, DelayReport& report, std::vector<int>& touched);
+    void refreshHeapEntry(int trainId, bool markDelayed);
 
 public:
+    static const int MIN_TRANSFER_TIME = 3;     // Minutes to change platforms
+    static const int MAX_CONNECTION_HOLD = 5;   // Longest a connection is held
+
     // Core Scheduling Operations
     void scheduleTrain(int id, std::string name, int time, int startStationId);
+    
+    // Bulk loading: append the whole batch, then one O(n) heap build
+    void scheduleTrains(TrainBatch&& batch);
     void showUpcomingTrains();          // Display schedule in chronological order
     void showTrainsAtStation(int stationId);  // Show trains arriving at a specific station
-    void optimizeFrequency(bool isPeakHour);  // Dynamic frequency management
+    void optimizeFrequency(TrainBatch&& extraTrains);  // Batched insert (one heap build)
+    std::vector<Train> getScheduledTrains() const { return trainSchedule.getVector(); }
+    const TrainInfo* getTrainInfo(int trainId) const;
+    const std::string& getTrainName(int trainId) const;
+    
+    // Itineraries & Delay Propagation
+    void setItinerary(int trainId, const std::vector<TrainStop>& stops);
+    void setItinerary(int trainId, const SharedRoute& route, int offset);  // Shares 'route'
+    bool appendItinerary(int trainId, std::vector<TrainStop>& out) const;  // Resolved stop times
+    std::vector<std::pair<int, int>> getStationCalls(int stationId) const;  // (arrivalTime, trainId)
+    std::vector<int> getServedStations() const;
+    DelayReport applyDelay(int trainId, int stationId, int delayMinutes);
+    DelayReport applyDelays(const std::vector<DelayEvent>& events);  // Batched, one heap fix per train
     
     // Getters for monitoring
     int getTotalScheduledTrains() const { return trainSchedule.size(); }
     bool hasScheduledTrains() const { return !trainSchedule.empty(); }
 };
 
+// Builds stop times by walking 'line' from startStationId (1 min dwell per stop)
+std::vector<TrainStop> buildItinerary(RailwayNetwork* network, int startStationId,
+                                      LineType line, int departureTime);
+
 #endif // SCHEDULING_H
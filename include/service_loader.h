@@ -0,0 +1,77 @@
+/**
+ * ======================================================================================
+ * HEADER: service_loader.h
+ * DESCRIPTION: Streaming ingester for the service definitions in data/routes.json
+ *              (station sequence + frequencies -> a full day of Train departures)
+ * ======================================================================================
+ */
+
+#ifndef SERVICE_LOADER_H
+#define SERVICE_LOADER_H
+
+#include <string>
+#include <vector>
+#include "scheduling.h"
+
+const int SERVICE_START_MINUTE = 4 * 60;    // First departure of the day (04:00)
+const int SERVICE_END_MINUTE = 24 * 60;     // No departures at or after midnight
+
+// ======================================================================================
+//                                   SERVICE DEFINITION
+// ======================================================================================
+
+/**
+ * One entry of the "routes" array in routes.json
+ * Station names are resolved to ids while parsing; unknown names are dropped.
+ */
+struct ServiceDefinition {
+    int id;
+    std::string name;
+    std::string type;               // "fast" / "slow"
+    std::vector<int> stationIds;    // Calling pattern in travel order
+    int frequencyMinutes;           // Off-peak headway (train_frequency_min)
+    int peakFrequencyMinutes;       // Peak headway (peak_hour_frequency_min)
+    int runTimeMinutes;             // estimated_time_min, first to last stop
+};
+
+// ======================================================================================
+//                                   SERVICE LOADER
+// ======================================================================================
+
+/**
+ * Service Loader
+ *
+ * Parsing:
+ * - Pull parser over 64 KB fread() blocks - no DOM is built; each service
+ *   object is decoded field by field and unknown keys are skipped in place
+ *
+ * Expansion:
+ * - Departures from SERVICE_START_MINUTE until midnight, stepping by the peak
+ *   headway inside the peak windows (08:00-11:00, 17:00-21:00) and by the
+ *   normal headway otherwise
+ * - Stop times are spread evenly over estimated_time_min; the stop list is
+ *   built once per service (times from 0) and shared by its departures
+ *
+ * Loading:
+ * - All departures go to Scheduler::scheduleTrains in one batch, then each
+ *   train is attached to its service's route at its departure time
+ *
+ * Time Complexity: O(file size + services * stops + trains)
+ */
+class ServiceLoader {
+public:
+    static const std::string SERVICE_FILE;
+
+    // Returns false if the file cannot be opened or is not valid JSON
+    static bool parseServices(const std::string& path, std::vector<ServiceDefinition>& services);
+
+    // Appends one day of departures for 'service' and, per departure, its
+    // shared route (offset = departure time); returns the number added
+    static int expandService(const ServiceDefinition& service, int& nextTrainId,
+                             TrainBatch& trains, std::vector<SharedRoute>& routes);
+
+    // Parse + expand + bulk load. Returns trains loaded, or -1 on failure
+    static int loadServices(Scheduler& scheduler, const std::string& path = SERVICE_FILE);
+};
+
+#endif // SERVICE_LOADER_H
@@ -0,0 +1,97 @@
+/**
+ * ======================================================================================
+ * HEADER: simulation.h
+ * DESCRIPTION: Discrete-event simulation of a full operating day, partitioned by line
+ *              and run on up to one worker thread per line (conservative synchronization)
+ * ======================================================================================
+ */
+
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include <vector>
+#include "station.h"
+#include "graph.h"
+
+// ======================================================================================
+//                                   SIMULATION INPUT
+// ======================================================================================
+
+/**
+ * One train service to simulate: departs route's origin at departureTime and
+ * visits every hop of the traced line route in order.
+ */
+struct SimTrain {
+    int trainId;
+    LineType line;
+    int originId;               // First station of the service
+    int departureTime;          // Minutes from midnight
+    int capacity;
+    std::vector<Edge> route;    // Hops from RailwayNetwork::traceLineRoute
+};
+
+// ======================================================================================
+//                                   SIMULATION OUTPUT
+// ======================================================================================
+
+struct SimulationResult {
+    std::vector<long long> boarded;     // Per-station boardings
+    std::vector<long long> alighted;    // Per-station alightings
+    std::vector<long long> transfersIn; // Per-station passengers arriving from another line
+    long long totalBoarded;
+    long long totalTransfers;
+    int peakLoad;                       // Highest load seen on any train
+    int eventsProcessed;
+    int windows;                        // Synchronization windows used (parallel only)
+    int workers;                        // Threads the partitions ran on
+    unsigned long long checksum;        // FNV-1a over all counters (bit-for-bit comparison)
+    double elapsedMs;
+};
+
+// ======================================================================================
+//                                   TRAIN SIMULATOR
+// ======================================================================================
+
+/**
+ * Line-Partitioned Train Simulator
+ *
+ * Partitioning:
+ * - One logical process per LineType (Western, Central, Harbour, Trans-Harbour)
+ * - Each partition owns its trains and its own waiting-passenger pools
+ * - Partitions interact only through transfer messages at isInterchange stations
+ *
+ * Synchronization (conservative, window based):
+ * - Lookahead per line pair = dwell + shortest hop from one line into an
+ *   interchange the other serves (never below the network's fastest track)
+ * - A transfer is announced when a train departs towards an interchange, so its
+ *   timestamp is at least that lookahead in the future
+ * - Each partition processes events up to its own window end - the earliest a
+ *   transfer could still reach it - then all exchange messages at a barrier;
+ *   no rollback is ever required
+ *
+ * Determinism:
+ * - Events are totally ordered by (time, kind, source, sequence)
+ * - Random draws are stateless hashes of (seed, train, stop)
+ * - runSequential() and runParallel() therefore produce identical results
+ */
+class TrainSimulator {
+    std::vector<SimTrain> trains;
+    int numStations;
+    int lookahead;
+    unsigned int seed;
+
+public:
+    TrainSimulator(int stations, int lookaheadMinutes, unsigned int randomSeed = 2026);
+
+    void addTrain(const SimTrain& train);
+    int getTrainCount() const { return trains.size(); }
+
+    SimulationResult runSequential();   // Single global event queue (reference)
+    SimulationResult runParallel();     // Line partitions on up to one thread per core
+};
+
+// Builds a full-day timetable (both directions of every line) and compares
+// the sequential and parallel runs
+void runDaySimulation(RailwayNetwork* network, int headwayMinutes);
+
+#endif // SIMULATION_H
@@ -11,11 +11,9 @@
 #include <string>
 #include <vector>
 #include <algorithm>
+#include <cstdint>
 #include "queue_manager.h"
 
-// Forward declaration
-struct Train;
-
 // ======================================================================================
 //                                   CONSTANTS & ENUMS
 // ======================================================================================
@@ -40,7 +38,7 @@ struct Station {
     int passengerCount;
     bool isInterchange;
     std::vector<std::string> exitPoints;
-    MyList<Train> trainsAtStation; // Using Custom List
+    MyList<int> trainsAtStation;   // Train ids (Custom List)
 
     Station(int _id = 0, std::string _name = "", LineType _line = WESTERN, int _platforms = 2);
 };
@@ -50,55 +48,110 @@ struct Station {
 // ======================================================================================
 
 // ======================================================================================
-//                               STATION BST CLASS
+//                               STATION DIRECTORY CLASS
 // ======================================================================================
 
-class StationBST {
+/**
+ * Station Directory - the one place station names and ids are resolved
+ *
+ * Data Structures:
+ * - names: id -> display name, dense (station ids are 0 .. n-1)
+ * - slots: open-addressing hash over case-folded names (linear probing,
+ *   power-of-two capacity, at most half full); a slot keeps the full hash
+ *   next to the id, so names are compared only on a hash match
+ * - entries + pool: lowercased keys and display names sorted in one flat
+ *   array, for lexical listing and prefix search
+ * - bigram postings: candidate filter for the fuzzy search
+ * - when the station table starts with the built-in catalogue, names are
+ *   first resolved by its compile-time perfect hash (station_catalogue.h);
+ *   anything added at run time falls through to the slots
+ *
+ * Lookups take (pointer, length) as well as std::string and fold case while
+ * hashing and comparing, so resolving raw user input or a parsed field
+ * never builds a lowercased temporary.
+ */
+class StationDirectory {
 private:
-    struct BSTNode {
-        std::string name;        // Original case-preserved name
-        std::string nameLower;   // Lowercase for comparisons
+    struct Slot {
+        uint32_t hash;
+        int id;                 // -1 = empty
+    };
+
+    struct Entry {
+        uint32_t offset;        // Lowercased key at pool[offset], display name right after
+        uint32_t length;        // Key length (= display name length)
         int stationId;
-        BSTNode* left;
-        BSTNode* right;
-        
-        BSTNode(const std::string& _name, int _id)
-            : name(_name), stationId(_id), left(nullptr), right(nullptr) {
-            nameLower = _name;
-            std::transform(nameLower.begin(), nameLower.end(), nameLower.begin(), ::tolower);
-        }
     };
-    
-    BSTNode* root;
-    
-    void insertHelper(BSTNode*& node, const std::string& name, int id);
-    int searchHelper(BSTNode* node, const std::string& name) const;
-    void listHelper(BSTNode* node) const;
-    void matchHelper(BSTNode* node, const std::string& prefix, 
-                    std::vector<std::pair<std::string, int>>& results, int& count) const;
-    void deleteHelper(BSTNode*& node);
-    
+
+    std::vector<std::string> names;         // By station id
+    std::vector<Slot> slots;
+    size_t count;
+    bool catalogueIds;                      // Ids 0 .. CATALOGUE_SIZE-1 are the built-in catalogue
+
+    std::vector<Entry> entries;             // Ascending by key
+    std::string pool;
+
+    // Bigram -> entries containing it (CSR: postings[gramOffsets[g] .. gramOffsets[g+1]))
+    std::vector<uint16_t> gramKeys;         // Ascending
+    std::vector<uint32_t> gramOffsets;
+    std::vector<uint32_t> postings;         // Entry indices by (key length, index), once per gram
+    std::vector<uint8_t> postingCounts;     // Occurrences of the gram in that key
+    std::vector<uint32_t> byLength;         // All entry indices by (key length, index)
+
+    const char* key(const Entry& e) const { return pool.data() + e.offset; }
+    const char* displayName(const Entry& e) const { return pool.data() + e.offset + e.length; }
+
+    void insertSlot(uint32_t hash, int id);
+    void rebuildIndexes();
+
+    // First entry whose key is not less than 'query' (compared case-folded,
+    // on at most 'limit' characters of each key)
+    size_t lowerBound(const std::string& query, size_t limit) const;
+
+    // First position in list[begin, end) (ordered by key length) whose key
+    // is at least 'length' long
+    uint32_t lengthBound(const std::vector<uint32_t>& list, uint32_t begin, uint32_t end,
+                         uint32_t length) const;
+
 public:
-    StationBST() : root(nullptr) {}
-    ~StationBST() { deleteHelper(root); }
-    
-    // Add a station to the BST
-    void addStation(const std::string& name, int stationId);
-    
-    // Get station ID by name (case-insensitive)
-    int getStationId(const std::string& name) const;
-    
+    StationDirectory() : count(0), catalogueIds(false) {}
+
+    // Rebuild everything from the station table (ids are Station::id)
+    void build(const std::vector<Station>& stations);
+
+    // Register one name for 'id' while the station set is being assembled.
+    // Returns the id already registered under the name (case-insensitive),
+    // else 'id'. Listing, prefix and fuzzy search see it after build().
+    int add(const std::string& name, int id);
+
+    size_t size() const { return count; }
+    bool contains(int id) const { return id >= 0 && (size_t)id < names.size() && !names[id].empty(); }
+
+    // Display name of a station id ("" if unknown)
+    const std::string& name(int id) const;
+
+    // Get station ID by name (case-insensitive), -1 if absent
+    int getStationId(const char* name, size_t length) const;
+    int getStationId(const std::string& name) const { return getStationId(name.data(), name.size()); }
+
     // List all stations in lexical order
     void listStations() const;
-    
+
     // Get up to 10 stations matching a prefix (case-insensitive, lexical order)
     std::vector<std::pair<std::string, int>> listMatchingStations(const std::string& prefix) const;
+
+    // Get up to 'limit' stations within a small edit distance of 'query'
+    // (case-insensitive), closest first, busier stations (passengerCount in
+    // 'stations') first on ties
+    std::vector<std::pair<std::string, int>> listSimilarStations(const std::string& query,
+                                                                 const std::vector<Station>& stations,
+                                                                 size_t limit = 5) const;
 };
 
 // Forward declarations
 class RailwayNetwork;
 
 std::string getLineName(LineType l);
-void initializeStations(StationBST& stationDirectory, RailwayNetwork* mumbaiLocal);
+void initializeStations(StationDirectory& stationDirectory, RailwayNetwork* mumbaiLocal);
 
 #endif // STATION_H
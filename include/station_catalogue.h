@@ -0,0 +1,295 @@
+/**
+ * ======================================================================================
+ * HEADER: station_catalogue.h
+ * DESCRIPTION: Built-in station catalogue - stations, line routes and a perfect
+ *              hash over the names, all generated at compile time
+ * ======================================================================================
+ */
+
+#ifndef STATION_CATALOGUE_H
+#define STATION_CATALOGUE_H
+
+#include <cstddef>
+#include <cstdint>
+#include "station.h"
+
+// ======================================================================================
+//                                   STATIONS
+// ======================================================================================
+
+struct CatalogueStation {
+    const char* name;
+    LineType line;              // First line the station appears on
+};
+
+/**
+ * Built-in stations; the index is the station id. Names must be unique
+ * case-insensitively (checked at compile time).
+ */
+constexpr CatalogueStation STATION_CATALOGUE[] = {
+    // WESTERN LINE
+    { "Churchgate", WESTERN }, { "Marine Lines", WESTERN }, { "Charni Road", WESTERN },
+    { "Grant Road", WESTERN }, { "Mumbai Central", WESTERN }, { "Lower Parel", WESTERN },
+    { "Elphinstone Road", WESTERN }, { "Dadar", WESTERN }, { "Mahalaxmi", WESTERN },
+    { "Byculla", WESTERN }, { "Worli", WESTERN }, { "Bandra", WESTERN },
+    { "Mahim Junction", WESTERN }, { "Bombay Central", WESTERN }, { "Andheri", WESTERN },
+    { "Vile Parle", WESTERN }, { "Vilhedev Station", WESTERN }, { "Jogeshwari", WESTERN },
+    { "Goregaon", WESTERN }, { "Malad", WESTERN }, { "Borivali", WESTERN },
+    { "Dahisar", WESTERN }, { "Mira Road", WESTERN }, { "Bhayandar", WESTERN },
+    { "Vasai Road", WESTERN }, { "Virar East", WESTERN }, { "Virar", WESTERN },
+
+    // CENTRAL LINE
+    { "CST", CENTRAL }, { "Masjid", CENTRAL }, { "Sandhurst Road", CENTRAL },
+    { "Parel", CENTRAL }, { "Sion", CENTRAL }, { "Kurla", CENTRAL },
+    { "Vidyavihar", CENTRAL }, { "Ghatkopar", CENTRAL }, { "Vikhroli", CENTRAL },
+    { "Kanjur Marg", CENTRAL }, { "Mulund", CENTRAL }, { "Thane", CENTRAL },
+    { "Mulund East", CENTRAL }, { "Vangani", CENTRAL }, { "Kalyan", CENTRAL },
+    { "Vithalwadi", CENTRAL }, { "Ulhasnagar", CENTRAL }, { "Ambernath", CENTRAL },
+    { "Badlapur", CENTRAL }, { "Kasara", CENTRAL }, { "Dombivli East", CENTRAL },
+    { "Dombivli", CENTRAL },
+
+    // HARBOUR LINE
+    { "Dockyard Road", HARBOUR }, { "Cotton Green", HARBOUR }, { "Reay Road", HARBOUR },
+    { "Govandi", HARBOUR }, { "Mankhurd", HARBOUR }, { "Vashi", HARBOUR },
+    { "Turbhe", HARBOUR }, { "New Panvel", HARBOUR }, { "Nerul", HARBOUR },
+    { "Seawood-Darave", HARBOUR }, { "Belapur CBD", HARBOUR }, { "Belapur", HARBOUR },
+    { "Kharghar", HARBOUR }, { "Panvel", HARBOUR }, { "Khandeshwar", HARBOUR },
+    { "Uran", HARBOUR }, { "Penned", HARBOUR }, { "Dahanu", HARBOUR },
+    { "Panvel Central", HARBOUR },
+
+    // TRANS-HARBOUR LINE
+    { "Shivaji Maharaj Terminus", TRANS_HARBOUR }, { "Mazagon", TRANS_HARBOUR },
+    { "Wadala", TRANS_HARBOUR }, { "Sewri", TRANS_HARBOUR }, { "Seawood", TRANS_HARBOUR },
+    { "Alibaug", TRANS_HARBOUR }, { "Murud", TRANS_HARBOUR }, { "Kashid", TRANS_HARBOUR },
+    { "Dapoli", TRANS_HARBOUR }
+};
+
+constexpr int CATALOGUE_SIZE = (int)(sizeof(STATION_CATALOGUE) / sizeof(STATION_CATALOGUE[0]));
+static_assert(CATALOGUE_SIZE < 255 && CATALOGUE_SIZE <= MAX_STATIONS, "catalogue ids must fit a uint8_t slot");
+
+// ======================================================================================
+//                                   PERFECT HASH
+// ======================================================================================
+
+/**
+ * Name -> id without probing:
+ *   slot = top CATALOGUE_SLOT_BITS bits of (foldedHash(name) ^ seed) * golden ratio
+ *   id   = CATALOGUE_SLOTS.id[slot], then one name compare to reject strangers
+ *
+ * foldedHash is FNV-1a over the lowercased bytes (the StationDirectory hash).
+ * The compiler tries seeds 0, 1, 2, ... until no two catalogue names share a
+ * slot and fills the slot table with the result, so the hash is perfect by
+ * construction and editing the catalogue needs no generator step. The ids
+ * it yields are dense (0 .. CATALOGUE_SIZE-1).
+ *
+ * C++11 constexpr functions are single return statements, hence the
+ * recursion; every recursion is at most CATALOGUE_SIZE (or log2 of a
+ * range) deep.
+ */
+constexpr int CATALOGUE_SLOT_BITS = 10;
+constexpr uint32_t CATALOGUE_SLOT_COUNT = 1u << CATALOGUE_SLOT_BITS;
+constexpr uint8_t CATALOGUE_EMPTY = 0xFF;
+constexpr uint32_t CATALOGUE_SEED_LIMIT = 1u << 12;
+
+constexpr unsigned char catalogueFold(char c) {
+    return (c >= 'A' && c <= 'Z') ? (unsigned char)(c + ('a' - 'A')) : (unsigned char)c;
+}
+
+constexpr uint32_t catalogueHash(const char* s, uint32_t hash = 2166136261u) {
+    return *s ? catalogueHash(s + 1, (hash ^ catalogueFold(*s)) * 16777619u) : hash;
+}
+
+constexpr uint32_t catalogueSlot(uint32_t hash, uint32_t seed) {
+    return ((hash ^ seed) * 2654435769u) >> (32 - CATALOGUE_SLOT_BITS);
+}
+
+constexpr bool catalogueNameEquals(const char* a, const char* b) {
+    return catalogueFold(*a) != catalogueFold(*b) ? false : (*a == '\0' || catalogueNameEquals(a + 1, b + 1));
+}
+
+// Compile-time index lists (std::index_sequence is C++14); built by
+// doubling, so a list of n indices needs only log2(n) instantiations
+template<int... I> struct CatalogueIndices {};
+
+template<class List, int Half, bool Odd> struct DoubleCatalogueIndices;
+template<int... I, int Half> struct DoubleCatalogueIndices<CatalogueIndices<I...>, Half, false> {
+    typedef CatalogueIndices<I..., (Half + I)...> type;
+};
+template<int... I, int Half> struct DoubleCatalogueIndices<CatalogueIndices<I...>, Half, true> {
+    typedef CatalogueIndices<I..., (Half + I)..., 2 * Half> type;
+};
+
+template<int N> struct MakeCatalogueIndices {
+    typedef typename DoubleCatalogueIndices<typename MakeCatalogueIndices<N / 2>::type, N / 2, N % 2 == 1>::type type;
+};
+template<> struct MakeCatalogueIndices<0> {
+    typedef CatalogueIndices<> type;
+};
+
+// Name hashes, computed once so the searches below only mix them
+struct CatalogueHashes {
+    uint32_t hash[CATALOGUE_SIZE];
+};
+
+template<int... I>
+constexpr CatalogueHashes makeCatalogueHashes(CatalogueIndices<I...>) {
+    return CatalogueHashes{ { catalogueHash(STATION_CATALOGUE[I].name)... } };
+}
+
+constexpr CatalogueHashes CATALOGUE_HASHES = makeCatalogueHashes(MakeCatalogueIndices<CATALOGUE_SIZE>::type());
+
+// True if a station before 'i' (from 'j' on) has the same name
+constexpr bool catalogueNameRepeated(int i, int j = 0) {
+    return j < i && (catalogueNameEquals(STATION_CATALOGUE[j].name, STATION_CATALOGUE[i].name) ||
+                     catalogueNameRepeated(i, j + 1));
+}
+
+constexpr bool catalogueNamesUnique(int i = 0) {
+    return i == CATALOGUE_SIZE || (!catalogueNameRepeated(i) && catalogueNamesUnique(i + 1));
+}
+
+static_assert(catalogueNamesUnique(), "STATION_CATALOGUE names must be unique (case-insensitive)");
+
+// True if a station before 'i' (from 'j' on) shares its slot
+constexpr bool catalogueSlotTaken(uint32_t seed, int i, int j = 0) {
+    return j < i && (catalogueSlot(CATALOGUE_HASHES.hash[j], seed) == catalogueSlot(CATALOGUE_HASHES.hash[i], seed) ||
+                     catalogueSlotTaken(seed, i, j + 1));
+}
+
+constexpr bool catalogueSeedIsPerfect(uint32_t seed, int i = 0) {
+    return i == CATALOGUE_SIZE || (!catalogueSlotTaken(seed, i) && catalogueSeedIsPerfect(seed, i + 1));
+}
+
+// First perfect seed in [lo, hi), or CATALOGUE_SEED_LIMIT; halves the range
+// left first, so seeds are still tried in ascending order
+constexpr uint32_t firstPerfectSeed(uint32_t lo, uint32_t hi);
+
+constexpr uint32_t perfectSeedOr(uint32_t found, uint32_t lo, uint32_t hi) {
+    return found != CATALOGUE_SEED_LIMIT ? found : firstPerfectSeed(lo, hi);
+}
+
+constexpr uint32_t firstPerfectSeed(uint32_t lo, uint32_t hi) {
+    return hi - lo == 1 ? (catalogueSeedIsPerfect(lo) ? lo : CATALOGUE_SEED_LIMIT)
+                        : perfectSeedOr(firstPerfectSeed(lo, lo + (hi - lo) / 2), lo + (hi - lo) / 2, hi);
+}
+
+constexpr uint32_t CATALOGUE_SEED = firstPerfectSeed(0, CATALOGUE_SEED_LIMIT);
+static_assert(CATALOGUE_SEED != CATALOGUE_SEED_LIMIT,
+              "no perfect seed: raise CATALOGUE_SLOT_BITS");
+
+// Slot -> station id (CATALOGUE_EMPTY if no station hashes there)
+struct CatalogueSlots {
+    uint8_t id[CATALOGUE_SLOT_COUNT];
+};
+
+constexpr uint8_t catalogueSlotEntry(uint32_t slot, int i = 0) {
+    return i == CATALOGUE_SIZE ? CATALOGUE_EMPTY
+         : catalogueSlot(CATALOGUE_HASHES.hash[i], CATALOGUE_SEED) == slot ? (uint8_t)i
+         : catalogueSlotEntry(slot, i + 1);
+}
+
+template<int... S>
+constexpr CatalogueSlots makeCatalogueSlots(CatalogueIndices<S...>) {
+    return CatalogueSlots{ { catalogueSlotEntry(S)... } };
+}
+
+constexpr CatalogueSlots CATALOGUE_SLOTS = makeCatalogueSlots(MakeCatalogueIndices<CATALOGUE_SLOT_COUNT>::type());
+
+constexpr int catalogueIdInSlot(uint8_t id, const char* name) {
+    return id != CATALOGUE_EMPTY && catalogueNameEquals(STATION_CATALOGUE[id].name, name) ? id : -1;
+}
+
+/**
+ * Function: catalogueStationId
+ * Station id of a catalogue name (case-insensitive), -1 if it is not one.
+ * Usable in constant expressions; at run time see lookupCatalogueStation().
+ */
+constexpr int catalogueStationId(const char* name) {
+    return catalogueIdInSlot(CATALOGUE_SLOTS.id[catalogueSlot(catalogueHash(name), CATALOGUE_SEED)], name);
+}
+
+// Route stop: the station's id, or a compile error if it is not in the catalogue
+constexpr uint8_t catalogueStop(const char* name) {
+    return catalogueStationId(name) >= 0 ? (uint8_t)catalogueStationId(name)
+                                         : throw "route stop is not in STATION_CATALOGUE";
+}
+
+// ======================================================================================
+//                                   LINE ROUTES
+// ======================================================================================
+
+// WESTERN LINE (Churchgate to Virar)
+constexpr uint8_t WESTERN_ROUTE[] = {
+    catalogueStop("Churchgate"), catalogueStop("Marine Lines"), catalogueStop("Charni Road"),
+    catalogueStop("Grant Road"), catalogueStop("Mumbai Central"), catalogueStop("Lower Parel"),
+    catalogueStop("Elphinstone Road"), catalogueStop("Dadar"), catalogueStop("Mahalaxmi"),
+    catalogueStop("Byculla"), catalogueStop("Worli"), catalogueStop("Bandra"),
+    catalogueStop("Mahim Junction"), catalogueStop("Bombay Central"), catalogueStop("Andheri"),
+    catalogueStop("Vile Parle"), catalogueStop("Vilhedev Station"), catalogueStop("Jogeshwari"),
+    catalogueStop("Goregaon"), catalogueStop("Malad"), catalogueStop("Borivali"),
+    catalogueStop("Dahisar"), catalogueStop("Mira Road"), catalogueStop("Bhayandar"),
+    catalogueStop("Vasai Road"), catalogueStop("Virar East"), catalogueStop("Virar")
+};
+
+// CENTRAL LINE (CST to Dombivli)
+constexpr uint8_t CENTRAL_ROUTE[] = {
+    catalogueStop("CST"), catalogueStop("Masjid"), catalogueStop("Sandhurst Road"),
+    catalogueStop("Byculla"), catalogueStop("Dadar"), catalogueStop("Grant Road"),
+    catalogueStop("Parel"), catalogueStop("Sion"), catalogueStop("Kurla"),
+    catalogueStop("Vidyavihar"), catalogueStop("Ghatkopar"), catalogueStop("Vikhroli"),
+    catalogueStop("Kanjur Marg"), catalogueStop("Mulund"), catalogueStop("Thane"),
+    catalogueStop("Mulund East"), catalogueStop("Vangani"), catalogueStop("Kalyan"),
+    catalogueStop("Vithalwadi"), catalogueStop("Ulhasnagar"), catalogueStop("Ambernath"),
+    catalogueStop("Badlapur"), catalogueStop("Kasara"), catalogueStop("Dombivli East"),
+    catalogueStop("Dombivli")
+};
+
+// HARBOUR LINE (CST to Panvel Central)
+constexpr uint8_t HARBOUR_ROUTE[] = {
+    catalogueStop("CST"), catalogueStop("Dockyard Road"), catalogueStop("Cotton Green"),
+    catalogueStop("Reay Road"), catalogueStop("Govandi"), catalogueStop("Mankhurd"),
+    catalogueStop("Vashi"), catalogueStop("Turbhe"), catalogueStop("New Panvel"),
+    catalogueStop("Nerul"), catalogueStop("Seawood-Darave"), catalogueStop("Belapur CBD"),
+    catalogueStop("Belapur"), catalogueStop("Kharghar"), catalogueStop("Panvel"),
+    catalogueStop("Khandeshwar"), catalogueStop("Uran"), catalogueStop("Penned"),
+    catalogueStop("Dahanu"), catalogueStop("Panvel Central")
+};
+
+// TRANS-HARBOUR LINE (Shivaji Maharaj Terminus to Dapoli)
+constexpr uint8_t TRANS_HARBOUR_ROUTE[] = {
+    catalogueStop("Shivaji Maharaj Terminus"), catalogueStop("Byculla"), catalogueStop("Mazagon"),
+    catalogueStop("Wadala"), catalogueStop("Sewri"), catalogueStop("Vashi"),
+    catalogueStop("Turbhe"), catalogueStop("Nerul"), catalogueStop("Seawood"),
+    catalogueStop("Belapur"), catalogueStop("Kharghar"), catalogueStop("Panvel"),
+    catalogueStop("Khandeshwar"), catalogueStop("Alibaug"), catalogueStop("Murud"),
+    catalogueStop("Kashid"), catalogueStop("Dapoli")
+};
+
+struct CatalogueRoute {
+    LineType line;
+    const uint8_t* stops;
+    int stopCount;
+    int minDistance;            // Track distance: minDistance .. minDistance+2 km
+    int minTime;                // Track time: minTime .. minTime+2 min
+};
+
+constexpr CatalogueRoute CATALOGUE_ROUTES[] = {
+    { WESTERN, WESTERN_ROUTE, (int)sizeof(WESTERN_ROUTE), 2, 3 },
+    { CENTRAL, CENTRAL_ROUTE, (int)sizeof(CENTRAL_ROUTE), 2, 3 },
+    { HARBOUR, HARBOUR_ROUTE, (int)sizeof(HARBOUR_ROUTE), 3, 4 },
+    { TRANS_HARBOUR, TRANS_HARBOUR_ROUTE, (int)sizeof(TRANS_HARBOUR_ROUTE), 4, 5 }
+};
+
+// ======================================================================================
+//                                   RUN-TIME LOOKUP
+// ======================================================================================
+
+/**
+ * Function: lookupCatalogueStation
+ * Catalogue id of (name, length) given its foldedHash, -1 if it is not a
+ * catalogue name: one table read and one name compare
+ * Time Complexity: O(|name|)
+ */
+int lookupCatalogueStation(const char* name, size_t length, uint32_t hash);
+
+#endif // STATION_CATALOGUE_H
@@ -0,0 +1,46 @@
+/**
+ * ======================================================================================
+ * HEADER: string_table.h
+ * DESCRIPTION: String interning - each distinct string is stored once and referred
+ *              to by a 32-bit id
+ * ======================================================================================
+ */
+
+#ifndef STRING_TABLE_H
+#define STRING_TABLE_H
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <cstdint>
+
+/**
+ * String Table (Interning)
+ *
+ * Data Structures:
+ * - deque<string>: id -> string (deque so references stay valid as it grows)
+ * - unordered_map<string, id>: string -> id
+ *
+ * Features:
+ * - intern() returns the existing id for a known string, so thousands of
+ *   departures of the same service share one copy of its name
+ * - The (pointer, length) overload reuses a scratch key, so interning a
+ *   name that is already known does not allocate
+ *
+ * Time Complexity: O(length) average for intern(), O(1) for get()
+ */
+class StringTable {
+    std::deque<std::string> strings;
+    std::unordered_map<std::string, uint32_t> ids;
+    std::string scratch;
+
+public:
+    uint32_t intern(const std::string& s);
+    uint32_t intern(const char* s, size_t length);
+
+    const std::string& get(uint32_t id) const { return strings[id]; }
+    size_t size() const { return strings.size(); }
+};
+
+#endif // STRING_TABLE_H
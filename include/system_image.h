@@ -0,0 +1,191 @@
+/**
+ * ======================================================================================
+ * HEADER: system_image.h
+ * DESCRIPTION: Fast-start binary image of the system state (stations, graph,
+ *              startup schedule) loaded with one mmap
+ * ======================================================================================
+ */
+
+#ifndef SYSTEM_IMAGE_H
+#define SYSTEM_IMAGE_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "station.h"
+#include "graph.h"
+#include "scheduling.h"
+#include "mapped_csv.h"
+
+const char SYSTEM_IMAGE_FILE[] = "data/system.img";
+const uint32_t SYSTEM_IMAGE_VERSION = 2;     // 2: name index section dropped
+
+// ======================================================================================
+//                                   ON-DISK LAYOUT
+// ======================================================================================
+
+enum ImageSectionId {
+    IMAGE_STATIONS,         // ImageStation[stations]
+    IMAGE_EDGE_OFFSETS,     // uint32[vertices + 1] - CSR row starts
+    IMAGE_EDGES,            // ImageEdge[tracks * 2]
+    IMAGE_STRINGS,          // Name bytes referenced by offset/length
+    IMAGE_TRAINS,           // Train[trains] (16-byte hot records, heap order)
+    IMAGE_TRAIN_INFO,       // ImageTrainInfo[trains]
+    IMAGE_STOP_OFFSETS,     // uint32[trains + 1] - itinerary starts
+    IMAGE_STOPS,            // TrainStop[]
+    IMAGE_SECTION_COUNT
+};
+
+struct ImageSection {
+    uint64_t offset;        // From the start of the file (8-byte aligned)
+    uint64_t count;         // Elements
+    uint64_t bytes;
+};
+
+// Size + modification time of an input file the schedule was built from
+struct SourceStamp {
+    int64_t size;           // -1 if the file did not exist
+    int64_t modified;
+};
+
+/**
+ * system.img:
+ *   ImageHeader, then the sections in ImageSectionId order
+ *
+ * - checksum: FNV-1a (64-bit) over every byte after the header
+ * - networkSeq: change-log sequence number the station/graph sections
+ *   reflect; newer log records are replayed on top
+ * - The schedule sections hold the timetable as built at startup, valid
+ *   while timetable.csv / routes.json keep their stamps and the graph
+ *   still hashes to scheduleGraphHash
+ */
+struct ImageHeader {
+    char magic[8];          // "CMTIMG1"
+    uint32_t version;
+    uint32_t sectionCount;
+    uint64_t payloadBytes;
+    uint64_t checksum;
+    uint64_t networkSeq;
+    uint64_t scheduleGraphHash;
+    SourceStamp timetable;
+    SourceStamp services;
+    ImageSection sections[IMAGE_SECTION_COUNT];
+};
+
+struct ImageStation {
+    int32_t id;
+    int32_t line;
+    int32_t platforms;
+    int32_t passengerCount;
+    int32_t interchange;
+    uint32_t nameOffset;
+    uint32_t nameLength;
+    uint32_t reserved;
+};
+
+struct ImageEdge {
+    int32_t to;
+    int32_t weight;
+    int32_t distance;
+    int32_t line;
+};
+
+struct ImageTrainInfo {
+    int32_t trainId;
+    int32_t capacity;
+    uint32_t nameOffset;
+    uint32_t nameLength;
+};
+
+// ======================================================================================
+//                                   SCHEDULE CAPTURE
+// ======================================================================================
+
+/**
+ * Startup schedule in image form
+ * Captured once the schedule has been built (or copied from a loaded
+ * image) and written with every later image, so runtime delays and extra
+ * trains never leak into the next start.
+ */
+struct ScheduleImage {
+    bool valid;
+    uint64_t graphHash;
+    SourceStamp timetable;
+    SourceStamp services;
+    std::vector<Train> trains;
+    std::vector<ImageTrainInfo> info;
+    std::string names;
+    std::vector<uint32_t> stopOffsets;
+    std::vector<TrainStop> stops;
+
+    ScheduleImage() : valid(false), graphHash(0) {}
+};
+
+ScheduleImage captureSchedule(const Scheduler& scheduler);
+
+// Hash of the current adjacency lists (order-sensitive)
+uint64_t hashGraph();
+
+/**
+ * Writes allStations, adj and 'schedule' as a new image (temp file +
+ * rename). Call right after a successful ChangeLog::checkpoint(), passing
+ * its sequence number, so the image and the text snapshot agree.
+ */
+bool writeSystemImage(uint64_t networkSeq, const ScheduleImage& schedule,
+                      const std::string& path = SYSTEM_IMAGE_FILE);
+
+// ======================================================================================
+//                                   LOADER
+// ======================================================================================
+
+/**
+ * System Image (loader)
+ *
+ * open():
+ *   1. One read-only mmap of the whole file
+ *   2. Header checks (magic, version, size) and the payload checksum
+ *   3. Fix-ups: every section offset is bounds- and alignment-checked and
+ *      turned into a typed pointer into the mapping
+ *
+ * install*() then copy from those arrays into the live structures in bulk
+ * (exact reserves, CSR slices straight into adj, one directory build for
+ * the names, one heap build for the trains) - no text parsing and no
+ * per-row searching.
+ *
+ * Time Complexity: O(file size) to open, O(stations + tracks + stops) to install
+ */
+class SystemImage {
+    MappedFile file;
+    ImageHeader header;
+    bool valid;
+
+    const ImageStation* stations;
+    const uint32_t* edgeOffsets;
+    const ImageEdge* edges;
+    const char* strings;
+    const Train* trains;
+    const ImageTrainInfo* trainInfo;
+    const uint32_t* stopOffsets;
+    const TrainStop* stops;
+
+    const char* section(int id, size_t elementSize) const;
+    std::string text(uint32_t offset, uint32_t length) const;
+
+public:
+    SystemImage();
+
+    bool open(const std::string& path = SYSTEM_IMAGE_FILE);
+    void close();
+    bool isOpen() const { return valid; }
+    uint64_t getNetworkSeq() const { return header.networkSeq; }
+
+    // allStations, adj (via network size), station directory
+    bool installNetwork(StationDirectory& directory);
+
+    // True if timetable.csv / routes.json are unchanged and the live graph
+    // still matches the one the schedule was built on
+    bool scheduleIsCurrent() const;
+    bool installSchedule(Scheduler& scheduler, ScheduleImage& startup) const;
+};
+
+#endif // SYSTEM_IMAGE_H
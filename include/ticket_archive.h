@@ -0,0 +1,171 @@
+/**
+ * ======================================================================================
+ * HEADER: ticket_archive.h
+ * DESCRIPTION: Ticket history partitioned by service day - one compressed
+ *              segment per closed day, each with a min/max + per-station totals footer
+ * ======================================================================================
+ */
+
+#ifndef TICKET_ARCHIVE_H
+#define TICKET_ARCHIVE_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <ctime>
+#include "ticket_store.h"
+#include "ticket_segment.h"
+
+const char TICKET_ARCHIVE_DIR[] = "data/archive";
+const uint32_t TICKET_PARTITION_VERSION = 1;
+
+// Service day of a ticket: local calendar date as yyyymmdd (same day
+// boundary the headway optimizer uses)
+int serviceDayOf(time_t t);
+
+// data/archive/tickets-YYYYMMDD.seg
+std::string partitionPath(int serviceDay, const std::string& dir = TICKET_ARCHIVE_DIR);
+
+// data/archive/names.dict - the name dictionary shared by every partition
+std::string nameDictionaryPath(const std::string& dir = TICKET_ARCHIVE_DIR);
+
+// ======================================================================================
+//                                   ON-DISK LAYOUT
+// ======================================================================================
+
+struct StationTotals {
+    uint32_t departures;        // Tickets starting at the station
+    uint32_t arrivals;          // Tickets ending at the station
+    int64_t revenue;            // Fares of tickets starting at the station
+};
+
+/**
+ * tickets-YYYYMMDD.seg:
+ *   a ticket segment (see ticket_segment.h), rows in entryTime order,
+ *   then StationTotals[stationCount], then PartitionFooter as the last bytes
+ *
+ * The segment part opens with TicketSegment / TicketSegmentCursor; the
+ * footer is read from the end of the file on its own, so pruning and daily
+ * totals never decode a row.
+ */
+struct PartitionFooter {
+    char magic[8];              // "TKTDAY1"
+    uint32_t version;
+    int32_t serviceDay;         // yyyymmdd
+    uint64_t rows;
+    int64_t minEntryTime;
+    int64_t maxEntryTime;
+    int64_t revenue;
+    uint32_t stationCount;      // Entries in the totals table (ids 0 .. stationCount-1)
+    uint32_t unindexedRows;     // Rows with a station id outside the table
+};
+
+/**
+ * One sealed day, as described by its footer
+ */
+struct TicketPartition {
+    std::string path;
+    PartitionFooter footer;
+    std::vector<StationTotals> stations;
+
+    // False only if no row of the partition can pass the filter
+    bool mayMatch(const TicketFilter& filter) const;
+    int busiestOrigin() const;              // -1 if the day had no indexed tickets
+};
+
+// ======================================================================================
+//                                   SEALING
+// ======================================================================================
+
+/**
+ * Moves the tickets of closed service days (before the day of 'now') out of
+ * tickets.csv into their day partitions; only the open day stays in the CSV
+ *
+ * Algorithm:
+ * 1. Parallel-load tickets.csv and split it by service day
+ * 2. Per closed day: merge with an existing partition (rows already there
+ *    are not added twice), sort by entryTime, append new names to the
+ *    shared dictionary (fsync), write segment + footer (temp file + fsync
+ *    + rename, then the directory is synced)
+ * 3. Delete tickets.col (a stale copy would pass its size check), then
+ *    rewrite tickets.csv with the open day's rows (temp file + fsync + rename)
+ *
+ * A crash between steps 2 and 3 leaves rows in both places; the next seal
+ * drops them as duplicates. Partitions left in the older columnar layout
+ * (tickets-YYYYMMDD.col) are rewritten as segments first. Call with the
+ * journal closed.
+ *
+ * Returns: tickets moved, or -1 if a partition or the CSV could not be written
+ * Time Complexity: O(T log T) for T tickets in tickets.csv (+ rows of the
+ *                  partitions merged into)
+ */
+long long sealTicketPartitions(time_t now = time(NULL),
+                               const std::string& dir = TICKET_ARCHIVE_DIR);
+
+// ======================================================================================
+//                                   READERS
+// ======================================================================================
+
+/**
+ * Ticket Archive - the footers of every partition in a directory
+ * open() reads only the footers (and totals tables), ascending by day, and
+ * the shared name dictionary, which the archive must outlive its cursors for.
+ */
+class TicketArchive {
+    std::vector<TicketPartition> partitions;
+    TicketNameDictionary names;
+
+public:
+    bool open(const std::string& dir = TICKET_ARCHIVE_DIR);
+
+    const std::vector<TicketPartition>& getPartitions() const { return partitions; }
+    const TicketNameDictionary& getNames() const { return names; }
+    uint64_t rows() const;
+    long long revenue() const;
+};
+
+/**
+ * Ticket History Cursor - segment cursors over the archive, then a
+ * TicketCursor over the live store
+ *
+ * Partitions whose footer rules out the filter (entryTime min/max, or no
+ * ticket at the station) are skipped without opening them; inside the rest
+ * the block zone maps skip blocks. TicketRecord::row is the row within the
+ * current file.
+ *
+ * Time Complexity: O(rows in unskipped blocks of unskipped partitions)
+ */
+class TicketHistoryCursor {
+    std::vector<std::string> partitions;    // Left after pruning
+    const TicketNameDictionary* names;      // The archive's
+    std::string liveStore;
+    size_t nextPartition;
+    bool liveDone;
+    TicketFilter filter;
+    unsigned fields;
+
+    TicketSegment segment;
+    TicketSegmentCursor segmentCursor;
+    TicketStoreReader store;
+    TicketCursor cursor;
+    int active;                         // 0 = none, 1 = segment, 2 = live store
+
+    uint32_t partitionsSkipped;
+    uint32_t blocksSkipped;
+    uint32_t blocksScanned;
+
+    bool openNext();
+
+public:
+    TicketHistoryCursor();
+
+    bool open(const TicketArchive& archive, const std::string& liveStore = TICKET_STORE_FILE,
+              const TicketFilter& filter = TicketFilter(), unsigned fields = TICKET_FIELD_ALL);
+    bool next(TicketRecord& out);
+
+    uint32_t getPartitionsSkipped() const { return partitionsSkipped; }
+    uint32_t getBlocksSkipped() const;
+    uint32_t getBlocksScanned() const;
+};
+
+#endif // TICKET_ARCHIVE_H
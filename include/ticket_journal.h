@@ -0,0 +1,129 @@
+/**
+ * ======================================================================================
+ * HEADER: ticket_journal.h
+ * DESCRIPTION: Group-commit write-ahead journal for issued tickets (tickets.csv)
+ * ======================================================================================
+ */
+
+#ifndef TICKET_JOURNAL_H
+#define TICKET_JOURNAL_H
+
+#include <string>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <cstdint>
+#include "ticketing.h"
+#include "mpmc_queue.h"
+
+const int JOURNAL_BUFFER_CAPACITY = 8192;   // Tickets waiting for the writer
+const int JOURNAL_MAX_BATCH = 1024;         // Tickets per write() call
+
+// When a written batch is forced to stable storage
+enum JournalDurability {
+    DURABILITY_NONE,            // write() only - survives a crash of the app, not of the OS
+    DURABILITY_FSYNC_BATCH,     // fsync after every batch
+    DURABILITY_FSYNC_INTERVAL   // fsync at most every fsyncIntervalMs
+};
+
+struct JournalConfig {
+    std::string path;
+    JournalDurability durability;
+    int fsyncIntervalMs;
+    int maxBatch;
+
+    JournalConfig(const std::string& path = "data/tickets.csv",
+                  JournalDurability durability = DURABILITY_FSYNC_BATCH,
+                  int fsyncIntervalMs = 100, int maxBatch = JOURNAL_MAX_BATCH)
+        : path(path), durability(durability), fsyncIntervalMs(fsyncIntervalMs), maxBatch(maxBatch) {}
+};
+
+// Buffer slot: the ticket plus the time it was handed to the journal
+struct JournalEntry {
+    Passenger ticket;
+    long long queuedAtNs;
+
+    // Cells are reused lap after lap; the reserve saves the first lap's allocations
+    JournalEntry() : queuedAtNs(0) { ticket.name.reserve(TICKET_NAME_RESERVE); }
+};
+
+struct JournalStats {
+    long long tickets;
+    long long batches;
+    long long bytes;
+    long long fsyncs;
+    WaitHistogram flushUs;      // write (+ fsync) time per batch
+    WaitHistogram commitUs;     // append() -> on disk, per ticket
+};
+
+/**
+ * Ticket Journal (group commit)
+ *
+ * Data Structures:
+ * - BoundedMPMCQueue<JournalEntry>: lock-free hand-off from any booking
+ *   thread; cells are filled in place, so appending does not allocate
+ * - One reusable byte buffer the writer formats a batch into
+ *
+ * Writer thread:
+ * - Drains up to maxBatch tickets, formats them as CSV rows without
+ *   iostreams and issues ONE write() for the whole batch
+ * - fsync per batch, per interval or never (JournalConfig::durability)
+ * - Sleeps on a condition variable when idle; append() only takes the
+ *   mutex to wake it, never on the busy path
+ *
+ * Durability barrier:
+ * - flush() blocks until every ticket appended before the call is written
+ *   (and fsynced if durability != NONE); durableCount only advances after
+ *   a successful write and fsync, a failed batch is kept and retried
+ *
+ * Time Complexity: O(1) per append; one syscall (+ fsync) per batch
+ */
+class TicketJournal {
+    JournalConfig config;
+    BoundedMPMCQueue<JournalEntry> pending;
+    int fd;
+
+    std::thread writer;
+    std::atomic<bool> running;
+    std::atomic<bool> writerIdle;
+    std::atomic<bool> failing;          // Writer is retrying a batch it could not persist
+    std::mutex wakeLock;
+    std::condition_variable wake;       // append -> writer
+    std::condition_variable durable;    // writer -> flush()
+
+    std::atomic<uint64_t> appendedCount;
+    std::atomic<uint64_t> durableCount;
+    std::atomic<long long> lastFsyncNs;
+
+    std::vector<char> batch;            // Writer-only: formatted rows
+    std::vector<long long> batchQueuedNs;   // Writer-only: append time per row
+    std::mutex statsLock;
+    JournalStats stats;
+
+    void writerLoop();
+    int drainBatch();
+    bool writeAll(const char* data, size_t length, size_t& done);
+    bool persistBatch(size_t& written, bool& dirty, long long intervalNs);
+    bool syncFile();
+
+public:
+    explicit TicketJournal(const JournalConfig& config = JournalConfig());
+    ~TicketJournal();
+
+    TicketJournal(const TicketJournal&) = delete;
+    TicketJournal& operator=(const TicketJournal&) = delete;
+
+    bool open();                        // Creates the file (with header) and starts the writer
+    bool close();                       // Writes everything pending, then stops the writer (false: tickets lost)
+    bool isOpen() const { return fd >= 0; }
+
+    bool append(const Passenger& ticket);   // Lock-free, any thread; waits only if the buffer is full
+    bool flush();                            // Durability barrier (false: writer is failing)
+
+    JournalStats getStats();
+    void showStats();
+};
+
+#endif // TICKET_JOURNAL_H
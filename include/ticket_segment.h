@@ -0,0 +1,220 @@
+/**
+ * ======================================================================================
+ * HEADER: ticket_segment.h
+ * DESCRIPTION: Compressed ticket segments - delta + varint columns and
+ *              dictionary-coded names/types, used for sealed day partitions
+ * ======================================================================================
+ */
+
+#ifndef TICKET_SEGMENT_H
+#define TICKET_SEGMENT_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include "ticket_store.h"
+
+const uint32_t TICKET_SEGMENT_VERSION = 2;      // 2: names are ids into a TicketNameDictionary
+const int TICKET_SEGMENT_BLOCK = 1024;      // Rows per block (zone map granularity)
+
+// ======================================================================================
+//                                   ON-DISK LAYOUT
+// ======================================================================================
+
+/**
+ * Segment (little-endian):
+ *
+ *   SegmentHeader
+ *   name dictionary     version 1 only: nameCount x (varint length, bytes),
+ *                       first-seen order. Version 2 stores none; its name
+ *                       codes are ids into the shared TicketNameDictionary
+ *                       and nameCount is that dictionary's size when written
+ *   type dictionary     typeCount x varint type
+ *   per block:
+ *     SegmentBlock
+ *     one stream per TicketColumnId, columnBytes[c] bytes each
+ *
+ * Column streams (ref = SegmentBlock::reference[c]):
+ *   TCOL_ID, TCOL_ENTRY_TIME   varint zigzag(value - previous), previous = ref
+ *                              (the block's first value) at block start
+ *   TCOL_AGE, SOURCE, DEST,
+ *   PRICE                      varint (value - ref), ref = block minimum
+ *   TCOL_TYPE, TCOL_NAME       dictionary index, bit-packed LSB first at
+ *                              bitWidth(dictionary size - 1) bits per row
+ *
+ * Rows are written in entryTime order, so time and id deltas are one byte,
+ * a station id, age or fare is one byte, a passenger type a couple of bits
+ * and a name ~2 bytes - ~8 bytes a row against ~45 in tickets.csv, with each
+ * distinct name stored once for the whole archive. A reader skips the
+ * streams it does not need by their lengths. Anything after segmentBytes
+ * (e.g. a partition footer) is not part of the segment.
+ */
+struct SegmentHeader {
+    char magic[8];              // "TKTSEG1"
+    uint32_t version;
+    uint32_t blockCount;
+    uint64_t rows;
+    uint64_t segmentBytes;      // Header + dictionaries + blocks
+    uint32_t nameCount;
+    uint32_t typeCount;
+};
+
+struct SegmentBlock {
+    uint32_t rows;
+    uint32_t reserved;
+    int64_t minEntryTime;
+    int64_t maxEntryTime;
+    int32_t minSource;
+    int32_t maxSource;
+    int32_t minDest;
+    int32_t maxDest;
+    int64_t reference[TCOL_COUNT];
+    uint32_t columnBytes[TCOL_COUNT];
+};
+
+// ======================================================================================
+//                                   NAME DICTIONARY
+// ======================================================================================
+
+/**
+ * Ticket Name Dictionary - the passenger names of every version-2 segment
+ *
+ * File (append-only): "TKTNAME1", then one entry per id in id order:
+ * varint length + bytes. Ids never change, so a segment written against
+ * the first n entries stays valid as the file grows. A torn last entry
+ * (crash while appending) is ignored on load and cut off by the next flush.
+ *
+ * Commuters buy many tickets under one name; a per-day copy of the names
+ * was the largest part of a day partition.
+ *
+ * Time Complexity: O(file bytes) to open, O(1) average per intern / lookup
+ */
+class TicketNameDictionary {
+    std::string path;
+    std::string blob;                       // All names back to back
+    std::vector<uint32_t> offsets;          // Name i = blob[offsets[i], offsets[i + 1])
+    std::unordered_map<std::string, uint32_t> ids;  // Built by open(path, true)
+    uint64_t validBytes;                    // File bytes up to the last whole entry
+    size_t persisted;                       // Entries already in the file
+
+public:
+    TicketNameDictionary() : validBytes(0), persisted(0) { offsets.push_back(0); }
+
+    // Loads 'path' (a missing file is an empty dictionary). 'writable'
+    // also builds the name -> id index used by intern()/find().
+    bool open(const std::string& path, bool writable = false);
+
+    uint32_t intern(const std::string& name);       // Adds in memory; flush() persists
+    bool find(const std::string& name, uint32_t& id) const;
+    bool flush();                                   // Append new entries + fsync
+
+    uint32_t size() const { return (uint32_t)offsets.size() - 1; }
+    const char* name(uint32_t id, size_t& length) const {
+        length = offsets[id + 1] - offsets[id];
+        return blob.data() + offsets[id];
+    }
+};
+
+// ======================================================================================
+//                                   WRITER
+// ======================================================================================
+
+/**
+ * Encodes 'tickets' (in the given order) as a segment, appends 'trailer' and
+ * writes the file (temp file + fsync + rename). With 'names', every name must
+ * already be in that dictionary (flushed) and a version-2 segment is written;
+ * without, the names are stored in the segment (version 1).
+ * Returns: false if the file cannot be written or a name has no id
+ * Time Complexity: O(rows + name bytes)
+ */
+bool writeTicketSegment(const std::vector<Passenger>& tickets, const std::string& path,
+                        const std::string& trailer = std::string(),
+                        const TicketNameDictionary* names = NULL);
+
+// ======================================================================================
+//                                   READERS
+// ======================================================================================
+
+/**
+ * One mapped segment
+ * open() validates the header, parses both dictionaries and walks the block
+ * headers once (every stream length checked against the file); column
+ * streams are decoded on demand, a block at a time. A version-2 segment
+ * needs the shared name dictionary, which must outlive the segment.
+ */
+class TicketSegment {
+    MappedFile map;
+    SegmentHeader header;
+    bool valid;
+    const TicketNameDictionary* sharedNames;
+
+    std::vector<const char*> nameData;
+    std::vector<uint32_t> nameLength;
+    std::vector<int> types;
+    std::vector<SegmentBlock> blocks;
+    std::vector<const unsigned char*> streams;     // First column stream of each block
+    uint32_t nameBits;
+    uint32_t typeBits;
+
+public:
+    TicketSegment() : valid(false), sharedNames(NULL), nameBits(0), typeBits(0) {}
+
+    bool open(const std::string& path, const TicketNameDictionary* names = NULL);
+    bool isOpen() const { return valid; }
+    uint64_t rows() const { return valid ? header.rows : 0; }
+    uint32_t getBlockCount() const { return valid ? header.blockCount : 0; }
+    const SegmentBlock& block(uint32_t b) const { return blocks[b]; }
+
+    // Decodes column c of block b into out[0 .. rows); dictionary columns
+    // yield their index. Returns: rows, or -1 if the stream is corrupt
+    int decodeColumn(uint32_t b, int column, int64_t* out) const;
+
+    const char* name(uint32_t index, size_t& length) const;
+    int type(uint32_t index) const { return types[index]; }
+    uint32_t getNameCount() const { return header.nameCount; }
+    uint32_t getTypeCount() const { return (uint32_t)types.size(); }
+
+    bool loadAll(std::vector<Passenger>& tickets) const;
+};
+
+/**
+ * Ticket Segment Cursor - TicketCursor's pull interface over a segment
+ * Block zone maps (entryTime, source, dest min/max) skip whole blocks;
+ * predicate streams are decoded first and the rest of the projection only
+ * for blocks with a match. TicketRecord::row is the row in the segment.
+ *
+ * Time Complexity: O(bytes of the projected streams in unskipped blocks)
+ */
+class TicketSegmentCursor {
+    const TicketSegment* segment;
+    TicketFilter filter;
+    unsigned fields;
+
+    std::vector<int64_t> values;        // TCOL_COUNT x TICKET_SEGMENT_BLOCK decoded values
+    std::vector<uint16_t> selection;
+    int selected;
+    int nextSelected;
+    uint32_t nextBlock;
+    uint64_t blockFirstRow;
+    uint64_t nextBlockFirstRow;
+
+    uint32_t blocksSkipped;
+    uint32_t blocksScanned;
+
+    int64_t* column(int c) { return values.data() + (size_t)c * TICKET_SEGMENT_BLOCK; }
+    bool blockMayMatch(const SegmentBlock& block) const;
+    bool loadNextBlock();
+
+public:
+    TicketSegmentCursor();
+
+    bool open(const TicketSegment& segment, const TicketFilter& filter = TicketFilter(),
+              unsigned fields = TICKET_FIELD_ALL);
+    bool next(TicketRecord& out);
+
+    uint32_t getBlocksSkipped() const { return blocksSkipped; }
+    uint32_t getBlocksScanned() const { return blocksScanned; }
+};
+
+#endif // TICKET_SEGMENT_H
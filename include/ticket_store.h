@@ -0,0 +1,290 @@
+/**
+ * ======================================================================================
+ * HEADER: ticket_store.h
+ * DESCRIPTION: Binary columnar copy of the ticket history (tickets.col) with
+ *              memory-mapped, per-column readers for analytics scans
+ * ======================================================================================
+ */
+
+#ifndef TICKET_STORE_H
+#define TICKET_STORE_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <climits>
+#include "ticketing.h"
+#include "mapped_csv.h"
+
+const char TICKET_STORE_FILE[] = "data/tickets.col";
+const uint32_t TICKET_STORE_VERSION = 2;      // 2: per-block min/max (zone maps)
+const int TICKET_STORE_BLOCK = 1024;        // Values per bit-packed block
+const int TICKET_STORE_ALIGN = 4096;        // Column sections start on page boundaries
+
+enum TicketColumnId {
+    TCOL_ID,
+    TCOL_AGE,
+    TCOL_TYPE,
+    TCOL_SOURCE,
+    TCOL_DEST,
+    TCOL_PRICE,
+    TCOL_ENTRY_TIME,
+    TCOL_NAME,          // Name heap (offsets + bytes), not bit-packed
+    TCOL_COUNT
+};
+
+enum ColumnEncoding {
+    ENCODING_FOR,       // value - block minimum, bit-packed
+    ENCODING_DELTA,     // zigzag(value - previous value), bit-packed
+    ENCODING_HEAP       // uint64 offsets[rows + 1] followed by the bytes
+};
+
+// ======================================================================================
+//                                   ON-DISK LAYOUT
+// ======================================================================================
+
+/**
+ * tickets.col (little-endian, fixed-width fields):
+ *
+ *   TicketStoreHeader
+ *   per column, at a TICKET_STORE_ALIGN boundary:
+ *     ColumnBlock[blockCount]      one per TICKET_STORE_BLOCK rows
+ *     uint64 words[]               packed values, 'width' bits each
+ *
+ * A block decodes on its own: value[i] = reference + packed[i] (FOR), or a
+ * running sum of zigzag-decoded deltas starting at reference (DELTA).
+ * Blocks whose values are all equal have width 0 and no words.
+ * minValue / maxValue bound the block's values, so a scan can skip a block
+ * without decoding it.
+ */
+struct ColumnInfo {
+    uint32_t encoding;
+    uint32_t blockCount;
+    uint64_t offset;            // Section start in the file
+    uint64_t length;            // Section bytes
+};
+
+struct TicketStoreHeader {
+    char magic[8];              // "TKTCOL1"
+    uint32_t version;
+    uint32_t columnCount;
+    uint64_t rows;
+    uint64_t sourceBytes;       // Size of tickets.csv this copy was built from
+    ColumnInfo columns[TCOL_COUNT];
+};
+
+struct ColumnBlock {
+    int64_t reference;
+    int64_t minValue;
+    int64_t maxValue;
+    uint32_t width;             // Bits per value (0 - 64)
+    uint32_t count;             // Values in this block
+    uint64_t wordOffset;        // First packed word (index into the words[] array)
+};
+
+// ======================================================================================
+//                                   WRITER
+// ======================================================================================
+
+/**
+ * Writes 'tickets' as a columnar file (temp file + rename, so readers see
+ * either the old or the new copy)
+ * Returns: false if the file cannot be written
+ * Time Complexity: O(rows)
+ */
+bool writeTicketStore(const std::vector<Passenger>& tickets, uint64_t sourceBytes,
+                      const std::string& path = TICKET_STORE_FILE);
+
+/**
+ * Rebuilds tickets.col from tickets.csv if the CSV has changed size since
+ * the last build, or if the store is missing (the journal only appends, so
+ * size is the change marker; sealTicketPartitions, the one writer that cuts
+ * tickets.csv, deletes tickets.col first)
+ * Returns: rows in the store, or -1 if neither file is usable
+ */
+long long refreshTicketStore(const std::string& path = TICKET_STORE_FILE);
+
+// ======================================================================================
+//                                   READERS
+// ======================================================================================
+
+/**
+ * One mapped, bit-packed column
+ * Only this column's section of the file is mapped; decoding works a block
+ * at a time into a small stack buffer.
+ */
+class TicketColumn {
+    MappedFile map;
+    const ColumnBlock* blocks;
+    const uint64_t* words;
+    uint32_t blockCount;
+    uint32_t encoding;
+
+public:
+    TicketColumn() : blocks(NULL), words(NULL), blockCount(0), encoding(ENCODING_FOR) {}
+
+    bool open(const std::string& path, const ColumnInfo& info, uint64_t rows);
+    uint32_t getBlockCount() const { return blockCount; }
+    const ColumnBlock& block(uint32_t b) const { return blocks[b]; }
+    size_t mappedBytes() const { return map.size(); }
+
+    // Decodes block b into out[0 .. count); returns count
+    int decodeBlock(uint32_t b, int64_t* out) const;
+
+    // fn(row, value) for every row, in row order
+    template <typename Fn>
+    void forEach(Fn fn) const {
+        int64_t values[TICKET_STORE_BLOCK];
+        uint64_t row = 0;
+        for (uint32_t b = 0; b < blockCount; b++) {
+            int count = decodeBlock(b, values);
+            for (int i = 0; i < count; i++) fn(row++, values[i]);
+        }
+    }
+};
+
+/**
+ * Name heap column: names[i] = bytes[offsets[i] .. offsets[i + 1])
+ */
+class TicketNames {
+    MappedFile map;
+    const uint64_t* offsets;
+    const char* bytes;
+    uint64_t rows;
+
+public:
+    TicketNames() : offsets(NULL), bytes(NULL), rows(0) {}
+
+    bool open(const std::string& path, const ColumnInfo& info, uint64_t rows);
+    std::string get(uint64_t row) const;
+    const char* data(uint64_t row, size_t& length) const;    // No copy
+    size_t mappedBytes() const { return map.size(); }
+};
+
+/**
+ * Ticket Store Reader
+ *
+ * open() reads only the header; each query maps just the columns it needs:
+ * - totalRevenue: price column
+ * - originDestination: source and dest columns
+ * - loadAll: every column (rebuilds Passenger rows)
+ *
+ * Time Complexity: O(rows) per query, O(bytes of the touched columns) I/O
+ */
+class TicketStoreReader {
+    std::string path;
+    TicketStoreHeader header;
+    bool valid;
+
+public:
+    TicketStoreReader() : valid(false) {}
+
+    bool open(const std::string& path = TICKET_STORE_FILE);
+    bool isOpen() const { return valid; }
+    uint64_t rows() const { return valid ? header.rows : 0; }
+    uint64_t sourceBytes() const { return valid ? header.sourceBytes : 0; }
+
+    bool openColumn(TicketColumnId id, TicketColumn& column) const;
+    bool openNames(TicketNames& names) const;
+
+    // Queries (bytesMapped, if given, receives the column bytes touched)
+    long long totalRevenue(size_t* bytesMapped = NULL) const;
+    bool originDestination(int stations, std::vector<long long>& counts,
+                           size_t* bytesMapped = NULL) const;     // counts[src * stations + dest]
+    bool loadAll(std::vector<Passenger>& tickets) const;
+};
+
+// ======================================================================================
+//                                   STREAMING CURSOR
+// ======================================================================================
+
+// Projection bits for TicketCursor::open (one per TicketColumnId)
+const unsigned TICKET_FIELD_ALL = (1u << TCOL_COUNT) - 1;
+inline unsigned ticketField(TicketColumnId id) { return 1u << id; }
+
+/**
+ * Rows a cursor should return; every condition is optional
+ * - entryTime in [fromTime, toTime)
+ * - stationId: ticket starts or ends there (-1 = any station)
+ */
+struct TicketFilter {
+    long long fromTime;
+    long long toTime;
+    int stationId;
+
+    TicketFilter() : fromTime(LLONG_MIN), toTime(LLONG_MAX), stationId(-1) {}
+    bool hasTimeRange() const { return fromTime != LLONG_MIN || toTime != LLONG_MAX; }
+};
+
+/**
+ * One ticket as seen through a cursor
+ * Fields outside the projection are left 0; name points into the mapped
+ * name heap and stays valid while the cursor is open.
+ */
+struct TicketRecord {
+    uint64_t row;
+    int id;
+    int age;
+    PassengerType type;
+    int sourceId;
+    int destId;
+    int ticketPrice;
+    time_t entryTime;
+    const char* name;
+    size_t nameLength;
+};
+
+/**
+ * Ticket Cursor - pull-based scan over tickets.col
+ *
+ *   TicketCursor cursor;
+ *   cursor.open(store, filter, ticketField(TCOL_SOURCE) | ticketField(TCOL_PRICE));
+ *   TicketRecord t;
+ *   while (cursor.next(t)) { ... }
+ *
+ * Algorithm (per 1024-row block):
+ *   1. Zone maps: skip the block if the entryTime min/max misses the time
+ *      range, or neither the source nor dest min/max can hold the station
+ *   2. Decode only the predicate columns and build a selection vector
+ *   3. If any row matched, decode the remaining projected columns
+ *   4. next() hands out the selected rows, then moves to the next block
+ *
+ * Memory: one decoded block per projected column, whatever the history
+ * size - nothing is materialised.
+ * Time Complexity: O(rows in unskipped blocks), O(1) extra space
+ */
+class TicketCursor {
+    TicketColumn columns[TCOL_NAME];
+    TicketNames names;
+    TicketFilter filter;
+    unsigned fields;            // Projected columns
+    unsigned opened;            // Projected + predicate columns
+
+    std::vector<int64_t> values;    // TCOL_NAME x TICKET_STORE_BLOCK decoded values
+    std::vector<uint16_t> selection;
+    int selected;
+    int nextSelected;
+    uint32_t nextBlock;
+    uint32_t blockCount;
+    uint64_t blockFirstRow;
+    uint64_t rows;
+
+    uint32_t blocksSkipped;
+    uint32_t blocksScanned;
+
+    int64_t* column(int c) { return values.data() + (size_t)c * TICKET_STORE_BLOCK; }
+    bool blockMayMatch(uint32_t b) const;
+    bool loadNextBlock();
+
+public:
+    TicketCursor();
+
+    bool open(const TicketStoreReader& store, const TicketFilter& filter = TicketFilter(),
+              unsigned fields = TICKET_FIELD_ALL);
+    bool next(TicketRecord& out);
+
+    uint32_t getBlocksSkipped() const { return blocksSkipped; }
+    uint32_t getBlocksScanned() const { return blocksScanned; }
+};
+
+#endif // TICKET_STORE_H
@@ -10,8 +10,24 @@
 
 #include <string>
 #include <ctime>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <cstdint>
 #include "station.h"
 #include "queue_manager.h"
+#include "mpmc_queue.h"
+
+const int TICKET_LANE_CAPACITY = 4096;     // Passengers waiting per lane
+const int DEFAULT_SENIOR_WEIGHT = 4;       // DRR quantum: passengers per round
+const int DEFAULT_LADIES_WEIGHT = 2;
+const int DEFAULT_GENERAL_WEIGHT = 1;
+const int DEFAULT_MAX_WAIT_MS = 50;        // A waiting lane unserved this long jumps the round
+const int TICKET_LEDGER_CAPACITY = 8192;   // Issued tickets addressable by handle
+const int TICKET_NAME_RESERVE = 48;        // Name bytes reserved up front per ledger slot / journal cell
+
+enum TicketLane { SENIOR_LANE, LADIES_LANE, GENERAL_LANE, LANE_COUNT };
 
 // ======================================================================================
 //                                   PASSENGER STRUCTURE
@@ -28,38 +44,201 @@ struct Passenger {
     time_t entryTime;
 };
 
+// Lane slot: the passenger plus the steady-clock time it joined the lane
+struct LaneEntry {
+    Passenger passenger;
+    long long queuedAtNs;
+};
+
+// ======================================================================================
+//                                   WAIT-TIME HISTOGRAM
+// ======================================================================================
+
+/**
+ * Log2 histogram of queue waits in microseconds
+ * Bucket 0 holds waits under 1 us, bucket b holds [2^(b-1), 2^b) us.
+ * percentile() reports the upper edge of the bucket holding that rank,
+ * i.e. within a factor of two of the true value.
+ */
+struct WaitHistogram {
+    static const int BUCKETS = 32;
+
+    long long counts[BUCKETS];
+    long long samples;
+    long long totalUs;
+    long long maxUs;
+
+    WaitHistogram() { reset(); }
+    void reset();
+    void record(long long waitUs);
+    void merge(const WaitHistogram& other);
+    long long percentile(double p) const;
+};
+
+// Per-consumer deficit round robin state (each counter thread keeps its own)
+struct LaneSchedule {
+    int deficit[LANE_COUNT];
+    int cursor;
+    LaneSchedule();
+};
+
+// ======================================================================================
+//                                   TICKET LEDGER
+// ======================================================================================
+
+struct TicketHandle {
+    uint64_t serial;    // 1-based issue number; 0 = no ticket
+    bool valid() const { return serial != 0; }
+};
+
+/**
+ * Ticket Ledger - issued tickets, referenced by handle
+ *
+ * Data Structure:
+ * - Ring of Passenger records (capacity rounded up to a power of two), each
+ *   slot with a one-byte spin lock and the serial of the ticket it holds
+ * - issued: atomic serial counter; ticket n lives in slot n & mask
+ *
+ * Features:
+ * - record() swaps the passenger into its slot, handing the caller the
+ *   record it overwrote - name buffers circulate between lanes, counters and
+ *   ledger, so issuing a ticket allocates nothing. Slot names are reserved
+ *   at construction, so that holds from the first lap for names shorter
+ *   than TICKET_NAME_RESERVE
+ * - A handle stays valid until the ring laps it; visit() then returns false
+ *
+ * Time Complexity: O(1) record / visit
+ */
+class TicketLedger {
+    struct Slot {
+        std::atomic<bool> busy;
+        uint64_t serial;
+        Passenger ticket;
+    };
+
+    Slot* slots;
+    size_t mask;
+    std::atomic<uint64_t> issued;
+
+    static void lock(Slot& slot) {
+        while (slot.busy.exchange(true, std::memory_order_acquire)) std::this_thread::yield();
+    }
+    static void unlock(Slot& slot) { slot.busy.store(false, std::memory_order_release); }
+
+public:
+    explicit TicketLedger(size_t capacity = TICKET_LEDGER_CAPACITY);
+    ~TicketLedger() { delete[] slots; }
+
+    TicketLedger(const TicketLedger&) = delete;
+    TicketLedger& operator=(const TicketLedger&) = delete;
+
+    // Moves 'p' into the ledger; p is left holding a recycled record
+    TicketHandle record(Passenger& p);
+
+    // Calls visit(const Passenger&) while the slot is locked
+    template <typename Visit>
+    bool visit(TicketHandle handle, Visit&& fn) {
+        if (!handle.valid()) return false;
+        Slot& slot = slots[handle.serial & mask];
+        lock(slot);
+        bool live = (slot.serial == handle.serial);
+        if (live) fn((const Passenger&)slot.ticket);
+        unlock(slot);
+        return live;
+    }
+
+    uint64_t size() const { return issued.load(std::memory_order_relaxed); }
+};
+
 // ======================================================================================
 //                                   TICKET SYSTEM CLASS
 // ======================================================================================
 
 /**
- * Queue Management for Ticketing using Custom MyQueue
+ * Queue Management for Ticketing with Concurrent Counters
  * 
  * Features:
- * - Multi-queue priority system (Senior > Ladies > General)
- * - Custom MyQueue data structure usage
- * - Revenue and analytics tracking
+ * - Three lanes (Senior, Ladies, General) served by deficit round robin:
+ *   each round a lane may issue up to its weight in tickets, so seniors and
+ *   ladies are favoured without starving the general lane
+ * - Max-wait promotion: a lane with passengers that no counter has served
+ *   for maxWait is served next, ahead of the round
+ * - Per-lane wait-time histograms (p50 / p99) for tuning the weights
+ * - Each lane is a bounded lock-free MPMC queue: any number of booking
+ *   channels (UTS app, ATVMs, windows) enqueue while counter threads dequeue
+ * - startCounters(n) / stopCounters() run n ticket counters in parallel
+ * - Revenue and analytics tracking (atomic totals, per-counter batching;
+ *   Station::passengerCount as before, timed flow also goes to the sharded
+ *   passengerFlow counters)
  * - Fare calculation based on distance
+ * - Passengers are written into lane cells in place (emplace), swapped out
+ *   by the counter and swapped into the TicketLedger on issue; callers keep
+ *   a TicketHandle, never a copy
  */
 class TicketSystem {
-    MyQueue<Passenger> generalQueue;   // Standard passengers
-    MyQueue<Passenger> ladiesQueue;    // Female passengers (priority)
-    MyQueue<Passenger> seniorQueue;    // Senior citizens (highest priority)
-    int totalTicketsSold;              // Total tickets counter
-    long long totalRevenue;            // Cumulative revenue in Rupees
+    BoundedMPMCQueue<LaneEntry> generalQueue;   // Standard passengers
+    BoundedMPMCQueue<LaneEntry> ladiesQueue;    // Female passengers (priority)
+    BoundedMPMCQueue<LaneEntry> seniorQueue;    // Senior citizens (highest priority)
+    std::atomic<int> totalTicketsSold;          // Total tickets counter
+    std::atomic<long long> totalRevenue;        // Cumulative revenue in Rupees
+    bool trackStations;                         // Feed Station::passengerCount and passengerFlow
+    TicketLedger ledger;                        // Issued tickets
+    
+    // Counter workers
+    std::vector<std::thread> counters;
+    std::atomic<bool> countersOpen;
+    std::mutex stationMergeLock;                // Guards allStations while merging
+    
+    // Lane scheduling
+    int laneWeights[LANE_COUNT];
+    long long maxWaitNs;
+    std::atomic<long long> lastServedNs[LANE_COUNT];  // Last pop, or last time seen empty
+    WaitHistogram laneWaits[LANE_COUNT];
+    std::mutex waitStatsLock;                   // Guards laneWaits while merging
+    
+    BoundedMPMCQueue<LaneEntry>& lane(int laneId);
+    bool popLane(int laneId, LaneEntry& entry, long long now);
+    bool nextPassenger(LaneEntry& entry, LaneSchedule& schedule, int& laneId, long long now);
+    void counterLoop(int counterId);
 
 public:
-    TicketSystem();
+    TicketSystem(bool trackStations = true);
+    ~TicketSystem();
     
-    // Queue Operations
-    void joinQueue(Passenger p);       // Add passenger to appropriate queue
-    void processQueues();              // Process all queues in priority order
-    void processTicket(Passenger p);   // Process individual ticket
-    void showStats();                  // Display analytics and revenue
+    // Queue Operations (lock-free, any thread; false if the lane is full)
+    bool emplace(int id, const std::string& name, int age, PassengerType type,
+                 int sourceId, int destId);  // Built inside the lane cell
+    bool enqueue(Passenger&& p);
+    void joinQueue(const Passenger& p);      // Add passenger to appropriate queue (interactive)
+    void processQueues();                    // Process all queues by deficit round robin
+    TicketHandle processTicket(Passenger& p);  // Fare, display, issue; p is recycled
+    void showStats();                        // Display analytics, revenue and lane waits
+    
+    // Issued Tickets
+    TicketHandle issueTicket(Passenger& p);  // p.ticketPrice already set; p is recycled
+    template <typename Visit>
+    bool withTicket(TicketHandle handle, Visit&& visit) {
+        return ledger.visit(handle, std::forward<Visit>(visit));
+    }
+    
+    // Lane Scheduling
+    void setLaneWeights(int senior, int ladies, int general);   // Minimum 1 each
+    void setMaxWaitMs(int ms);
+    WaitHistogram getLaneWaits(int laneId);
+    
+    // Concurrent Counters
+    void startCounters(int count);     // Spawn counter worker threads
+    void stopCounters();               // Drain the lanes, then join the workers
+    int getOpenCounters() const { return counters.size(); }
+    int getWaitingPassengers() const;
     
     // Getters for analytics
-    int getTotalTickets() const { return totalTicketsSold; }
-    long long getTotalRevenue() const { return totalRevenue; }
+    int getTotalTickets() const { return totalTicketsSold.load(); }
+    long long getTotalRevenue() const { return totalRevenue.load(); }
+    
+    // Adds to Station::passengerCount under stationMergeLock, the lock the
+    // counter threads merge under (bookings made outside the lanes)
+    void addStationLoad(int stationId, int passengers);
     
     // Direct revenue tracking for ticketing
     void recordTicket(int fare) {
@@ -68,4 +247,23 @@ public:
     }
 };
 
+// ======================================================================================
+//                                   COUNTER RUSH SIMULATION
+// ======================================================================================
+
+struct CounterRushResult {
+    int counters;
+    int bookingThreads;
+    int passengers;
+    double elapsedMs;
+    double ticketsPerSecond;
+    long long p99WaitUs[LANE_COUNT];
+};
+
+// Floods a fresh TicketSystem from bookingThreads producers, served by 'counters' workers
+CounterRushResult runCounterRush(int counters, int bookingThreads, int passengers);
+
+// Runs the rush with 1, 2, 4, ... counters up to the core count and prints the scaling
+void showCounterRushScaling(int passengers);
+
 #endif // TICKETING_H
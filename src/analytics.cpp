@@ -1,27 +1,46 @@
 /**
  * ======================================================================================
  * IMPLEMENTATION: analytics.cpp
- * DESCRIPTION: Station BST and Comprehensive Analytics System
+ * DESCRIPTION: Comprehensive Analytics System
  * 
  * FEATURES:
- * 1. Station BST for efficient station searching
+ * 1. Station-level passenger statistics
  * 2. Passenger flow analytics and congestion reports
  * 3. Peak-hour statistics and trend analysis
  * 4. Historical data tracking and reporting
  * 5. Integration with ticketing and station data
+ * 6. Ticket history scans over the columnar store (tickets.col)
+ * 7. Live 15-minute flow from the sharded passengerFlow counters
  * ======================================================================================
  */
 
 #include "../include/analytics.h"
 #include "../include/globals.h"
 #include "../include/ticketing.h"
+#include "../include/ticket_archive.h"
+#include "../include/passenger_flow.h"
 #include <iostream>
 #include <iomanip>
 #include <algorithm>
 #include <map>
 #include <ctime>
+#include <cstdio>
 #include "../include/colors.h"
 
+namespace {
+
+// "08:15-08:30" for a flow bucket
+std::string bucketLabel(int bucket) {
+    int start = bucket * FLOW_BUCKET_MINUTES;
+    int end = start + FLOW_BUCKET_MINUTES;
+    char label[16];
+    snprintf(label, sizeof(label), "%02d:%02d-%02d:%02d",
+             (start / 60) % 24, start % 60, (end / 60) % 24, end % 60);
+    return label;
+}
+
+} // namespace
+
 // ======================================================================================
 //                                   PASSENGER FLOW ANALYTICS
 // ======================================================================================
@@ -35,14 +54,18 @@
  * - Top 5 busiest stations by passenger count
  * - Average passengers per station
  * - Flow distribution by line (Western, Central, Harbour)
+ * - Live flow this session: boardings / alightings, busiest 15 minutes,
+ *   busiest stations (summed from the passengerFlow shards)
  * 
  * Algorithm:
  * 1. Aggregate passenger counts from all stations
  * 2. Sort stations by passenger count (descending)
  * 3. Calculate statistics and percentages
- * 4. Display in formatted report
+ * 4. Summarize the flow counters, rank stations by flow
+ * 5. Display in formatted report
  * 
- * Time Complexity: O(n log n) for sorting
+ * Time Complexity: O(n log n) for sorting, O(shards x n x buckets) for the
+ *                  flow summary
  * 
  * Real-world use: Capacity planning, resource allocation
  */
@@ -112,6 +135,36 @@ void displayPassengerFlowAnalytics() {
                   << "(" << std::fixed << std::setprecision(1) << percentage << "%)\n";
     }
     
+    // Live flow (this session)
+    PassengerFlowSummary flow = passengerFlow.summarize(allStations.size());
+    std::cout << "\n📡 LIVE FLOW (THIS SESSION):\n";
+    std::cout << "━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n";
+    if (flow.total[FLOW_BOARDING] + flow.total[FLOW_ALIGHTING] == 0) {
+        std::cout << "No passenger flow recorded yet.\n";
+    } else {
+        int busiest = flow.busiestBucket();
+        std::cout << "Boardings: " << flow.total[FLOW_BOARDING]
+                  << "   Alightings: " << flow.total[FLOW_ALIGHTING] << "\n";
+        std::cout << "Busiest 15 Minutes: " << bucketLabel(busiest)
+                  << " (" << flow.bucketTotal(busiest) << " passengers)\n\n";
+        
+        std::vector<std::pair<uint64_t, int>> stationsByFlow;
+        for (size_t id = 0; id < flow.station[FLOW_BOARDING].size(); id++) {
+            if (flow.stationTotal(id) > 0) stationsByFlow.push_back({flow.stationTotal(id), (int)id});
+        }
+        std::sort(stationsByFlow.rbegin(), stationsByFlow.rend());
+        
+        std::cout << std::left << std::setw(25) << "Station" << std::setw(12) << "Boarded"
+                  << "Alighted\n";
+        std::cout << "──────────────────────────────────────────────────────────\n";
+        for (size_t i = 0; i < stationsByFlow.size() && i < 5; i++) {
+            int id = stationsByFlow[i].second;
+            std::cout << std::left << std::setw(25) << allStations[id].name
+                      << std::setw(12) << flow.station[FLOW_BOARDING][id]
+                      << flow.station[FLOW_ALIGHTING][id] << "\n";
+        }
+    }
+    
     std::cout << "══════════════════════════════════════════════════════════\n\n";
 }
 
@@ -207,12 +260,14 @@ void displayCongestionReport() {
  * - Predicted passenger load for next hour
  * - Historical peak hour patterns
  * - Capacity utilization recommendations
+ * - Live flow for the last hour in 15-minute buckets, and the busiest
+ *   bucket so far (passengerFlow counters)
  * 
  * Peak Hours Definition:
  * - Morning Peak: 08:00 - 11:00
  * - Evening Peak: 17:00 - 21:00
  * 
- * Time Complexity: O(n)
+ * Time Complexity: O(n), plus O(shards x n x buckets) for the flow summary
  * 
  * Real-world use: Dynamic resource allocation, predictive scheduling
  */
@@ -233,7 +288,7 @@ void displayPeakHourStatistics() {
     
     std::cout << "⏰ CURRENT TIME ANALYSIS:\n";
     std::cout << "━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n";
-    std::cout << "Current Hour: " << std::setw(2) << std::setfill('0') << currentHour 
+    std::cout << "Current Hour: " << std::right << std::setw(2) << std::setfill('0') << currentHour 
               << ":00" << std::setfill(' ') << "\n";
     std::cout << "Status: ";
     
@@ -272,6 +327,26 @@ void displayPeakHourStatistics() {
         std::cout << "✓ Capacity within normal range\n";
     }
     
+    // Live flow, last hour by 15-minute bucket
+    PassengerFlowSummary flow = passengerFlow.summarize(allStations.size());
+    int currentBucket = flowBucketOf(now);
+    std::cout << "\n📡 LIVE FLOW (LAST HOUR, 15-MIN BUCKETS):\n";
+    std::cout << "━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n";
+    uint64_t lastHour = 0;
+    for (int back = 3; back >= 0; back--) {
+        int b = (currentBucket - back + FLOW_BUCKETS) % FLOW_BUCKETS;
+        lastHour += flow.bucketTotal(b);
+        std::cout << bucketLabel(b) << "  Boarded: " << std::left << std::setw(8)
+                  << flow.bucket[FLOW_BOARDING][b] << "Alighted: "
+                  << flow.bucket[FLOW_ALIGHTING][b] << (back == 0 ? "  (now)" : "") << "\n";
+    }
+    std::cout << "Passengers in the Last Hour: " << lastHour << "\n";
+    int busiest = flow.busiestBucket();
+    if (busiest >= 0) {
+        std::cout << "Busiest 15 Minutes: " << bucketLabel(busiest)
+                  << " (" << flow.bucketTotal(busiest) << " passengers)\n";
+    }
+    
     // Peak hour predictions
     std::cout << "\n🔮 PEAK HOUR PATTERNS:\n";
     std::cout << "━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n";
@@ -440,3 +515,120 @@ void displayComprehensiveAnalytics(const TicketSystem& ticketSystem) {
     
     std::cout << "══════════════════════════════════════════════════════════\n\n";
 }
+
+// ======================================================================================
+//                                   TICKET HISTORY (COLUMNAR)
+// ======================================================================================
+
+/**
+ * Function: displayTicketHistoryReport
+ * Revenue, daily totals and busiest origin-destination pairs over the whole
+ * ticket history: sealed day partitions in data/archive plus tickets.col
+ * 
+ * Algorithm:
+ * 1. Partition footers give row counts and revenue of every sealed day
+ *    without mapping a column; refreshTicketStore() brings tickets.col up
+ *    to date for the open day
+ * 2. Revenue: footer totals + the live price column; last 7 days through a
+ *    TicketHistoryCursor (partitions outside the range are never opened)
+ * 3. OD pairs: source and dest streams of every partition and the live
+ *    store into a stations x stations count matrix, then partial sort for
+ *    the top 5
+ * 
+ * Time Complexity: O(P + T + S^2) where P = partitions, T = tickets, S = stations
+ */
+void displayTicketHistoryReport() {
+    std::cout << "\n══════════════════════════════════════════════════════════\n";
+    std::cout << "          TICKET HISTORY (COLUMNAR STORE)\n";
+    std::cout << "══════════════════════════════════════════════════════════\n\n";
+
+    TicketArchive archive;
+    archive.open();
+    const std::vector<TicketPartition>& days = archive.getPartitions();
+    TicketStoreReader store;
+    bool live = refreshTicketStore() >= 0 && store.open();
+    if (!live && days.empty()) {
+        std::cout << RED << "No ticket history available.\n" << RESET;
+        return;
+    }
+    uint64_t totalRows = archive.rows() + store.rows();
+    std::cout << "Tickets in history: " << totalRows << "  (" << archive.rows() << " in "
+              << days.size() << " sealed days, " << store.rows() << " in the open day)\n";
+    if (totalRows == 0) return;
+
+    size_t priceBytes = 0;
+    long long revenue = archive.revenue() + (live ? std::max(0LL, store.totalRevenue(&priceBytes)) : 0);
+    std::cout << "Total Revenue: Rs. " << revenue << "\n";
+    std::cout << "Average Ticket Price: Rs. " << std::fixed << std::setprecision(2)
+              << (double)revenue / totalRows << "\n";
+    std::cout << "  (sealed days from footers, open day price column: " << priceBytes << " bytes mapped)\n";
+
+    // Last 7 days: partitions pruned by footer, then blocks by entryTime min/max
+    TicketFilter lastWeek;
+    lastWeek.fromTime = (long long)time(NULL) - 7LL * 24 * 60 * 60;
+    TicketHistoryCursor recent;
+    if (recent.open(archive, live ? TICKET_STORE_FILE : "", lastWeek, ticketField(TCOL_PRICE))) {
+        TicketRecord t;
+        long long recentTickets = 0, recentRevenue = 0;
+        while (recent.next(t)) {
+            recentTickets++;
+            recentRevenue += t.ticketPrice;
+        }
+        std::cout << "Last 7 days: " << recentTickets << " tickets, Rs. " << recentRevenue
+                  << "  (partitions skipped " << recent.getPartitionsSkipped() << ", blocks scanned "
+                  << recent.getBlocksScanned() << ", skipped " << recent.getBlocksSkipped() << ")\n";
+    }
+    std::cout << "\n";
+
+    // Daily totals straight from the footers of the latest sealed days
+    if (!days.empty()) {
+        std::cout << "📅 RECENT SERVICE DAYS (partition footers):\n";
+        std::cout << "━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n";
+        for (size_t i = days.size() - std::min<size_t>(7, days.size()); i < days.size(); i++) {
+            const PartitionFooter& f = days[i].footer;
+            int origin = days[i].busiestOrigin();
+            char date[16];
+            snprintf(date, sizeof(date), "%04d-%02d-%02d", f.serviceDay / 10000,
+                     (f.serviceDay / 100) % 100, f.serviceDay % 100);
+            std::cout << "  " << date << std::setw(8) << f.rows << " tickets  Rs. " << std::setw(8)
+                      << f.revenue << "  busiest: "
+                      << (stationDirectory.contains(origin) ? stationDirectory.name(origin) : "-") << "\n";
+        }
+        std::cout << "\n";
+    }
+
+    int stations = (int)allStations.size();
+    if (stations <= 0) return;
+    std::vector<long long> counts((size_t)stations * stations, 0);
+    TicketHistoryCursor trips;
+    trips.open(archive, live ? TICKET_STORE_FILE : "", TicketFilter(),
+               ticketField(TCOL_SOURCE) | ticketField(TCOL_DEST));
+    TicketRecord trip;
+    while (trips.next(trip)) {
+        if (trip.sourceId >= 0 && trip.sourceId < stations && trip.destId >= 0 && trip.destId < stations) {
+            counts[(size_t)trip.sourceId * stations + trip.destId]++;
+        }
+    }
+
+    std::vector<std::pair<long long, int> > pairs;
+    for (int i = 0; i < (int)counts.size(); i++) {
+        if (counts[i] > 0) pairs.push_back(std::make_pair(counts[i], i));
+    }
+    size_t top = std::min<size_t>(5, pairs.size());
+    std::partial_sort(pairs.begin(), pairs.begin() + top, pairs.end(),
+                      [](const std::pair<long long, int>& a, const std::pair<long long, int>& b) {
+                          return a.first > b.first || (a.first == b.first && a.second < b.second);
+                      });
+
+    std::cout << "🚉 TOP ORIGIN-DESTINATION PAIRS:\n";
+    std::cout << "━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n";
+    for (size_t i = 0; i < top; i++) {
+        int src = pairs[i].second / stations;
+        int dest = pairs[i].second % stations;
+        std::cout << std::setw(2) << (i + 1) << ". " << std::left << std::setw(20) << stationDirectory.name(src)
+                  << " -> " << std::setw(20) << stationDirectory.name(dest) << std::right
+                  << std::setw(8) << pairs[i].first << " trips\n";
+    }
+    std::cout << "  (source + dest columns only, " << trips.getBlocksScanned() << " blocks decoded)\n";
+    std::cout << "══════════════════════════════════════════════════════════\n\n";
+}
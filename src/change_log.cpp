@@ -0,0 +1,464 @@
+/**
+ * ======================================================================================
+ * IMPLEMENTATION: change_log.cpp
+ * DESCRIPTION: Write-ahead change log + compacted snapshots for stations and tracks
+ *
+ * DATA STRUCTURES:
+ * - Snapshot: text rows (S = station, E = track) closed by a checksummed END line
+ * - Log: one checksummed line per change, sequence-numbered
+ *
+ * KEY FEATURES:
+ * - Snapshot replaced atomically (temp file + fsync + rename)
+ * - Recovery = snapshot + replay of the records after it; a torn last
+ *   record (crash mid-append) is detected by its checksum and dropped
+ * - Automatic compaction keeps the log, and so restart time, bounded
+ * ======================================================================================
+ */
+
+#include "../include/change_log.h"
+#include "../include/globals.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <sys/stat.h>
+#include <fcntl.h>
+
+#ifdef _WIN32
+    #include <io.h>
+    #define LOG_OPEN(path) _open(path, _O_WRONLY | _O_CREAT | _O_APPEND | _O_BINARY, _S_IREAD | _S_IWRITE)
+    #define LOG_WRITE _write
+    #define LOG_FSYNC _commit
+    #define LOG_CLOSE _close
+    #define LOG_TRUNCATE _chsize
+    #define LOG_FILENO _fileno
+#else
+    #include <unistd.h>
+    #define LOG_OPEN(path) ::open(path, O_WRONLY | O_CREAT | O_APPEND, 0644)
+    #define LOG_WRITE ::write
+    #define LOG_FSYNC ::fsync
+    #define LOG_CLOSE ::close
+    #define LOG_TRUNCATE ::ftruncate
+    #define LOG_FILENO fileno
+#endif
+
+namespace {
+
+const char* SNAPSHOT_MAGIC = "SNAPSHOT,1";
+
+// FNV-1a, 32-bit: detects torn and corrupted records
+uint32_t checksum(const char* data, size_t length) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= (unsigned char)data[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+bool readWholeFile(const std::string& path, std::string& out) {
+    std::ifstream file(path.c_str(), std::ios::binary);
+    if (!file.is_open()) return false;
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    out = contents.str();
+    return true;
+}
+
+// Splits "a,b,c" into at most maxFields integers; returns the count parsed
+int parseFields(const char* text, const char* end, long long* fields, int maxFields) {
+    int count = 0;
+    while (text < end && count < maxFields) {
+        char* stop;
+        fields[count++] = strtoll(text, &stop, 10);
+        if (stop == text) return -1;
+        text = stop;
+        if (text < end && *text == ',') text++;
+    }
+    return (text == end) ? count : -1;
+}
+
+bool validStation(long long id) {
+    return id >= 0 && id < (long long)adj.size() && id < (long long)allStations.size();
+}
+
+// Makes a rename in the directory of 'path' durable (Windows: NTFS journals it)
+bool syncParentDirectory(const std::string& path) {
+#ifdef _WIN32
+    (void)path;
+    return true;
+#else
+    size_t slash = path.find_last_of('/');
+    std::string dir = (slash == std::string::npos) ? "." : path.substr(0, slash);
+    int dirFd = ::open(dir.c_str(), O_RDONLY);
+    if (dirFd < 0) return false;
+    bool ok = ::fsync(dirFd) == 0;
+    ::close(dirFd);
+    return ok;
+#endif
+}
+
+} // namespace
+
+// ======================================================================================
+//                                   LIFECYCLE
+// ======================================================================================
+
+ChangeLog::ChangeLog(const std::string& logPath, const std::string& snapshotPath, int compactEvery)
+    : logPath(logPath), snapshotPath(snapshotPath), compactEvery(compactEvery), fd(-1),
+      network(NULL), nextSeq(1), snapshotSeq(0), recordsSinceSnapshot(0), validLogBytes(-1),
+      pendingSeq(1) {
+    pendingFlow.reserve(CHANGE_LOG_FLOW_BATCH + 160);  // A batch plus one record line
+}
+
+ChangeLog::~ChangeLog() {
+    close();
+}
+
+/**
+ * Function: open
+ * Opens the log for appending. If recovery stopped at a torn record, the
+ * file is cut back to the last good record first.
+ */
+bool ChangeLog::open(RailwayNetwork* net) {
+    network = net;
+    if (fd >= 0) return true;
+    fd = LOG_OPEN(logPath.c_str());
+    if (fd < 0) return false;
+    if (validLogBytes >= 0) {
+        struct stat st;
+        if (stat(logPath.c_str(), &st) == 0 && st.st_size > validLogBytes &&
+            (LOG_TRUNCATE(fd, validLogBytes) != 0 || LOG_FSYNC(fd) != 0)) {
+            // Appending after a torn record would hide every later record
+            std::cerr << "Change log: cannot cut the torn tail of " << logPath << "\n";
+            LOG_CLOSE(fd);
+            fd = -1;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ChangeLog::close() {
+    if (fd < 0) return true;
+    bool ok = writePending() && LOG_FSYNC(fd) == 0;
+    LOG_CLOSE(fd);
+    fd = -1;
+    return ok;
+}
+
+// ======================================================================================
+//                                   RECOVERY
+// ======================================================================================
+
+/**
+ * Function: recover
+ * Rebuilds allStations and the track graph from the snapshot, then replays
+ * the log tail
+ *
+ * Parameters:
+ *   net - Network to add tracks to (adjacency already sized)
+ *   replayed - Receives the number of log records applied
+ *
+ * Returns: false if the snapshot is missing or fails its checksum (nothing
+ *          is modified in that case)
+ *
+ * Time Complexity: O(snapshot + log tail)
+ */
+bool ChangeLog::recover(RailwayNetwork* net, int& replayed) {
+    replayed = 0;
+    network = net;
+
+    std::string data;
+    if (!readWholeFile(snapshotPath, data)) return false;
+
+    // Header: SNAPSHOT,1,<seq>
+    size_t lineEnd = data.find('\n');
+    if (lineEnd == std::string::npos || data.compare(0, strlen(SNAPSHOT_MAGIC), SNAPSHOT_MAGIC) != 0) {
+        return false;
+    }
+    uint64_t seq = strtoull(data.c_str() + strlen(SNAPSHOT_MAGIC) + 1, NULL, 10);
+
+    // Trailer: END,<rows>,<checksum of the rows>
+    size_t bodyStart = lineEnd + 1;
+    size_t endPos = data.rfind("END,");
+    if (endPos == std::string::npos || endPos < bodyStart) return false;
+    long long trailer[2];
+    char* stop;
+    trailer[0] = strtoll(data.c_str() + endPos + 4, &stop, 10);
+    if (*stop != ',') return false;
+    trailer[1] = strtoll(stop + 1, NULL, 16);
+    if ((uint32_t)trailer[1] != checksum(data.data() + bodyStart, endPos - bodyStart)) return false;
+
+    std::vector<Station> stations;
+    std::vector<long long> tracks;      // u, v, weight, distance, line
+    long long rows = 0;
+    size_t pos = bodyStart;
+    while (pos < endPos) {
+        size_t eol = data.find('\n', pos);
+        if (eol == std::string::npos || eol > endPos) return false;
+        const char* line = data.c_str() + pos;
+        rows++;
+
+        if (line[0] == 'S' && line[1] == ',') {
+            // S,id,line,platforms,passengerCount,interchange,name
+            const char* nameStart = line + 2;
+            for (int commas = 0; commas < 5 && nameStart < data.c_str() + eol; nameStart++) {
+                if (*nameStart == ',') commas++;
+            }
+            long long f[5];
+            if (parseFields(line + 2, nameStart - 1, f, 5) != 5) return false;
+            Station s((int)f[0], std::string(nameStart, data.c_str() + eol), (LineType)f[1], (int)f[2]);
+            s.passengerCount = (int)f[3];
+            s.isInterchange = (f[4] == 1);
+            stations.push_back(s);
+        } else if (line[0] == 'E' && line[1] == ',') {
+            long long f[5];
+            if (parseFields(line + 2, data.c_str() + eol, f, 5) != 5) return false;
+            tracks.insert(tracks.end(), f, f + 5);
+        } else {
+            return false;
+        }
+        pos = eol + 1;
+    }
+    if (rows != trailer[0]) return false;
+
+    // Snapshot is valid - install it
+    allStations.swap(stations);
+    for (size_t i = 0; i + 4 < tracks.size(); i += 5) {
+        if (!validStation(tracks[i]) || !validStation(tracks[i + 1])) continue;
+        network->addTrack((int)tracks[i], (int)tracks[i + 1], (int)tracks[i + 2],
+                          (int)tracks[i + 3], (LineType)tracks[i + 4]);
+    }
+    snapshotSeq = seq;
+    nextSeq = seq + 1;
+
+    replayLog(replayed);
+    return true;
+}
+
+/**
+ * Function: canResume
+ * Reads only the snapshot's first line (SNAPSHOT,1,<seq>)
+ */
+bool ChangeLog::canResume(uint64_t baseSeq) const {
+    FILE* file = fopen(snapshotPath.c_str(), "rb");
+    if (!file) return false;
+    char line[64];
+    bool ok = fgets(line, sizeof(line), file) != NULL;
+    fclose(file);
+    size_t magicLength = strlen(SNAPSHOT_MAGIC);
+    if (!ok || strncmp(line, SNAPSHOT_MAGIC, magicLength) != 0 || line[magicLength] != ',') return false;
+    return strtoull(line + magicLength + 1, NULL, 10) <= baseSeq;
+}
+
+void ChangeLog::resume(RailwayNetwork* net, uint64_t baseSeq, int& replayed) {
+    replayed = 0;
+    network = net;
+    snapshotSeq = baseSeq;
+    nextSeq = baseSeq + 1;
+    replayLog(replayed);
+}
+
+/**
+ * Function: replayLog
+ * Applies log records newer than the snapshot, in order, stopping at the
+ * first incomplete, corrupt or out-of-sequence line
+ */
+bool ChangeLog::replayLog(int& replayed) {
+    std::string data;
+    validLogBytes = 0;
+    recordsSinceSnapshot = 0;
+    if (!readWholeFile(logPath, data)) return true;     // No log yet
+
+    size_t pos = 0;
+    while (pos < data.size()) {
+        size_t eol = data.find('\n', pos);
+        if (eol == std::string::npos) break;             // Torn final record
+        size_t star = data.rfind('*', eol);
+        if (star == std::string::npos || star < pos) break;
+        uint32_t stored = (uint32_t)strtoul(data.c_str() + star + 1, NULL, 16);
+        if (stored != checksum(data.data() + pos, star - pos)) break;
+
+        // seq,type,fields...
+        const char* line = data.c_str() + pos;
+        char* stop;
+        uint64_t seq = strtoull(line, &stop, 10);
+        if (*stop != ',' || stop[1] == '\0' || stop[2] != ',') break;
+        char type = stop[1];
+        long long f[5];
+        int count = parseFields(stop + 3, data.c_str() + star, f, 5);
+        if (count < 0) break;
+
+        if (seq > snapshotSeq) {
+            if (seq != nextSeq) break;                   // Gap: stop here
+            if (type == 'E' && count == 5 && validStation(f[0]) && validStation(f[1])) {
+                network->addTrack((int)f[0], (int)f[1], (int)f[2], (int)f[3], (LineType)f[4]);
+            } else if (type == 'B' && count == 2 && validStation(f[0]) && validStation(f[1])) {
+                network->blockTrack((int)f[0], (int)f[1], false);
+            } else if (type == 'P' && count == 2 && validStation(f[0])) {
+                allStations[f[0]].passengerCount += (int)f[1];
+            }
+            nextSeq = seq + 1;
+            recordsSinceSnapshot++;
+            replayed++;
+        }
+        pos = eol + 1;
+        validLogBytes = pos;
+    }
+    return true;
+}
+
+// ======================================================================================
+//                                   APPEND / CHECKPOINT
+// ======================================================================================
+
+/**
+ * Function: writePending
+ * Appends the buffered records with one write() (retried on EINTR / short
+ * writes). If that fails they are dropped and their seqs handed out again,
+ * so replay never meets a gap.
+ */
+bool ChangeLog::writePending() {
+    const char* data = pendingFlow.data();
+    size_t length = pendingFlow.size();
+    while (length > 0) {
+        long written = LOG_WRITE(fd, data, length);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            std::cerr << "Change log: write to " << logPath << " failed\n";
+            pendingFlow.clear();
+            nextSeq = pendingSeq;
+            return false;
+        }
+        data += written;
+        length -= written;
+    }
+    pendingFlow.clear();
+    return true;
+}
+
+/**
+ * Function: appendRecord
+ * Formats "seq,type,f1,...*checksum\n". A synced record goes out with the
+ * buffered flow records in one write() + fsync; an unsynced one is only
+ * buffered until CHANGE_LOG_FLOW_BATCH bytes are pending.
+ * Triggers a checkpoint once compactEvery records have accumulated
+ */
+bool ChangeLog::appendRecord(char type, const long long* fields, int count, bool sync) {
+    if (fd < 0) return false;
+
+    char line[160];
+    int length = snprintf(line, sizeof(line), "%llu,%c", (unsigned long long)nextSeq, type);
+    for (int i = 0; i < count; i++) {
+        length += snprintf(line + length, sizeof(line) - length, ",%lld", fields[i]);
+    }
+    uint32_t sum = checksum(line, length);
+    length += snprintf(line + length, sizeof(line) - length, "*%08x\n", sum);
+
+    if (pendingFlow.empty()) pendingSeq = nextSeq;
+    pendingFlow.append(line, length);
+    nextSeq++;
+    if ((sync || pendingFlow.size() >= CHANGE_LOG_FLOW_BATCH) && !writePending()) return false;
+
+    // Not durable, but written: the seq stays used so later records replay
+    bool durable = !sync || LOG_FSYNC(fd) == 0;
+    if (!durable) std::cerr << "Change log: fsync of " << logPath << " failed\n";
+
+    if (++recordsSinceSnapshot >= compactEvery) checkpoint();
+    return durable;
+}
+
+/**
+ * Function: checkpoint
+ * Writes the current stations and tracks as a new snapshot, then empties
+ * the log
+ *
+ * Crash safety:
+ *   - Snapshot goes to <path>.tmp, is fsynced, then renamed over the old
+ *     one and the directory is fsynced
+ *   - A crash after the rename but before the log is emptied is harmless:
+ *     replay skips records with seq <= the snapshot's seq
+ *   - Buffered flow records are dropped: the snapshot already counts them
+ *
+ * Time Complexity: O(stations + tracks)
+ */
+bool ChangeLog::checkpoint() {
+    uint64_t seq = nextSeq - 1;
+
+    std::string body;
+    long long rows = 0;
+    char row[64];
+    for (const auto& s : allStations) {
+        snprintf(row, sizeof(row), "S,%d,%d,%d,%d,%d,", s.id, (int)s.line, s.platforms,
+                 s.passengerCount, s.isInterchange ? 1 : 0);
+        body += row;
+        body += s.name;
+        body += '\n';
+        rows++;
+    }
+    for (int u = 0; u < (int)adj.size(); ++u) {
+        for (const auto& edge : adj[u]) {
+            if (u < edge.to) {  // Each bidirectional track once
+                snprintf(row, sizeof(row), "E,%d,%d,%d,%d,%d\n", u, edge.to, edge.weight,
+                         edge.distance, (int)edge.line);
+                body += row;
+                rows++;
+            }
+        }
+    }
+
+    std::string tmpPath = snapshotPath + ".tmp";
+    FILE* file = fopen(tmpPath.c_str(), "wb");
+    if (!file) return false;
+    fprintf(file, "%s,%llu\n", SNAPSHOT_MAGIC, (unsigned long long)seq);
+    fwrite(body.data(), 1, body.size(), file);
+    fprintf(file, "END,%lld,%08x\n", rows, checksum(body.data(), body.size()));
+    bool ok = (fflush(file) == 0) && (LOG_FSYNC(LOG_FILENO(file)) == 0);
+    ok = (fclose(file) == 0) && ok;
+    if (!ok) {
+        remove(tmpPath.c_str());
+        return false;
+    }
+#ifdef _WIN32
+    remove(snapshotPath.c_str());   // rename() does not replace on Windows
+#endif
+    if (rename(tmpPath.c_str(), snapshotPath.c_str()) != 0) return false;
+    if (!syncParentDirectory(snapshotPath)) {
+        std::cerr << "Change log: cannot sync the directory of " << snapshotPath << "\n";
+        return false;
+    }
+
+    snapshotSeq = seq;
+    recordsSinceSnapshot = 0;
+    pendingFlow.clear();
+    if (fd >= 0 && (LOG_TRUNCATE(fd, 0) != 0 || LOG_FSYNC(fd) != 0)) {
+        // The old records are still there; replay skips them (seq <= snapshot)
+        std::cerr << "Change log: cannot empty " << logPath << "\n";
+        return false;
+    }
+    validLogBytes = 0;
+    return true;
+}
+
+// ======================================================================================
+//                                   CHANGE EVENTS
+// ======================================================================================
+
+bool ChangeLog::logTrackAdded(int u, int v, int weight, int distance, LineType line) {
+    long long fields[5] = { u, v, weight, distance, (long long)line };
+    return appendRecord('E', fields, 5, true);
+}
+
+bool ChangeLog::logTrackBlocked(int u, int v) {
+    long long fields[2] = { u, v };
+    return appendRecord('B', fields, 2, true);
+}
+
+bool ChangeLog::logPassengerFlow(int stationId, int delta) {
+    long long fields[2] = { stationId, delta };
+    return appendRecord('P', fields, 2, false);
+}
@@ -7,11 +7,16 @@
 
 #include "../include/csv_manager.h"
 #include "../include/globals.h"
+#include "../include/mapped_csv.h"
 #include <iostream>
 #include <fstream>
-#include <sstream>
 #include <iomanip>
+#include <cstdio>
+#include <cstring>
 #include <sys/stat.h>
+#include <thread>
+#include <algorithm>
+#include <unordered_set>
 
 #ifdef _WIN32
     #include <direct.h>
@@ -25,6 +30,88 @@ const std::string CSVManager::STATION_FILE = "data/stations.csv";
 const std::string CSVManager::TICKET_FILE = "data/tickets.csv";
 const std::string CSVManager::ROUTE_FILE = "data/routes.csv";
 const std::string CSVManager::USER_FILE = "data/users.csv";
+const std::string CSVManager::TIMETABLE_FILE = "data/timetable.csv";
+
+namespace {
+
+// Moves a fully written temp file over 'path', so readers never see a half export
+bool replaceWith(const std::string& tmpPath, const std::string& path) {
+#ifdef _WIN32
+    remove(path.c_str());   // rename() does not replace on Windows
+#endif
+    return rename(tmpPath.c_str(), path.c_str()) == 0;
+}
+
+// Parses a non-negative integer in [p, end); advances p past the digits
+bool parseInt(const char*& p, const char* end, int& out) {
+    if (p == end || *p < '0' || *p > '9') return false;
+    int v = 0;
+    while (p < end && *p >= '0' && *p <= '9') v = v * 10 + (*p++ - '0');
+    out = v;
+    return true;
+}
+
+/**
+ * Parses one timetable row: trainId,name,departure,startStationId
+ * departure is either "HH:MM" or minutes from midnight.
+ * Works directly on the read buffer - no std::string or stringstream per field;
+ * the name is interned, so repeated service names are stored once.
+ * A trainId already in 'seen' is rejected and counted in 'duplicates'
+ * (the first row for an id wins).
+ */
+bool parseTimetableRow(const char* p, const char* end, TrainBatch& batch,
+                       std::unordered_set<int>& seen, int& duplicates) {
+    int trainId, time, stationId;
+    if (!parseInt(p, end, trainId) || p == end || *p++ != ',') return false;
+
+    const char* nameEnd = (const char*)memchr(p, ',', end - p);
+    if (nameEnd == NULL) return false;
+    const char* name = p;
+    size_t nameLength = nameEnd - p;
+    p = nameEnd + 1;
+
+    if (!parseInt(p, end, time)) return false;
+    if (p < end && *p == ':') {
+        int mins;
+        ++p;
+        if (!parseInt(p, end, mins)) return false;
+        time = time * 60 + mins;
+    }
+    if (p == end || *p++ != ',') return false;
+    if (!parseInt(p, end, stationId) || stationId >= MAX_STATIONS) return false;
+    if (!seen.insert(trainId).second) {
+        duplicates++;
+        return false;
+    }
+
+    batch.add(trainId, trainNames.intern(name, nameLength), time, stationId);
+    return true;
+}
+
+/**
+ * Parses ticket rows from 'in' until it is exhausted, appending to 'out'
+ * Each row is built in the vector's own slot; malformed rows are dropped.
+ */
+void parseTicketRows(CsvCursor& in, std::vector<Passenger>& out) {
+    out.reserve(out.size() + in.countLines());
+    while (!in.atEnd()) {
+        out.emplace_back();
+        Passenger& t = out.back();
+        int type;
+        long long entryTime;
+        bool ok = in.readInt(t.id) && in.readString(t.name) && in.readInt(t.age) &&
+                  in.readInt(type) && in.readInt(t.sourceId) && in.readInt(t.destId) &&
+                  in.readInt(t.ticketPrice) && in.readLong(entryTime);
+        if (!in.endRow() || !ok) {
+            out.pop_back();
+            continue;
+        }
+        t.type = (PassengerType)type;
+        t.entryTime = (time_t)entryTime;
+    }
+}
+
+} // namespace
 
 void CSVManager::initializeDataDirectory() {
     struct stat info;
@@ -33,110 +120,156 @@ void CSVManager::initializeDataDirectory() {
     }
 }
 
-void CSVManager::saveStations(const std::vector<Station>& stations) {
-    std::ofstream file(STATION_FILE);
-    if (!file.is_open()) return;
+/**
+ * Function: saveStations
+ * Exports the station table as stations.csv (temp file + rename)
+ * Returns: false if the file could not be written
+ */
+bool CSVManager::saveStations(const std::vector<Station>& stations) {
+    std::string tmpPath = STATION_FILE + ".tmp";
+    std::ofstream file(tmpPath);
+    if (!file.is_open()) return false;
 
     file << "id,name,line,platforms,passengerCount,isInterchange\n";
+    std::string name;
     for (const auto& s : stations) {
-        file << s.id << "," << s.name << "," << (int)s.line << "," << s.platforms << "," 
+        name.clear();
+        appendCsvText(name, s.name);
+        file << s.id << "," << name << "," << (int)s.line << "," << s.platforms << "," 
              << s.passengerCount << "," << (s.isInterchange ? 1 : 0) << "\n";
     }
     file.close();
+    if (file.fail()) {
+        remove(tmpPath.c_str());
+        return false;
+    }
+    return replaceWith(tmpPath, STATION_FILE);
 }
 
+/**
+ * Function: loadStations
+ * Parses stations.csv in place from a memory-mapped view (mapped_csv.h)
+ * Malformed rows are skipped instead of aborting the load.
+ */
 bool CSVManager::loadStations(std::vector<Station>& stations) {
-    std::ifstream file(STATION_FILE);
-    if (!file.is_open()) return false;
+    MappedFile file;
+    if (!file.open(STATION_FILE)) return false;
 
     stations.clear();
-    std::string line, word;
-    std::getline(file, line); // Skip header
+    CsvCursor in(file.begin(), file.end());
+    in.skipLine(); // Skip header
+    stations.reserve(in.countLines());
 
-    while (std::getline(file, line)) {
-        std::stringstream ss(line);
+    std::string name;
+    while (!in.atEnd()) {
         int id, lineType, platforms, passengerCount, interchange;
-        std::string name;
-
-        std::getline(ss, word, ','); id = std::stoi(word);
-        std::getline(ss, name, ',');
-        std::getline(ss, word, ','); lineType = std::stoi(word);
-        std::getline(ss, word, ','); platforms = std::stoi(word);
-        std::getline(ss, word, ','); passengerCount = std::stoi(word);
-        std::getline(ss, word, ','); interchange = std::stoi(word);
+        bool ok = in.readInt(id) && in.readString(name) && in.readInt(lineType) &&
+                  in.readInt(platforms) && in.readInt(passengerCount) && in.readInt(interchange);
+        if (!in.endRow() || !ok) continue;
 
         Station s(id, name, (LineType)lineType, platforms);
         s.passengerCount = passengerCount;
         s.isInterchange = (interchange == 1);
-        stations.push_back(s);
+        stations.push_back(std::move(s));
     }
-    file.close();
     return true;
 }
 
-void CSVManager::saveTickets(const std::vector<Passenger>& tickets) {
-    std::ofstream file(TICKET_FILE);
-    if (!file.is_open()) return;
+bool CSVManager::saveTickets(const std::vector<Passenger>& tickets, const std::string& path) {
+    std::ofstream file(path);
+    if (!file.is_open()) return false;
 
     file << "id,name,age,type,sourceId,destId,ticketPrice,entryTime\n";
+    std::string name;
     for (const auto& t : tickets) {
-        file << t.id << "," << t.name << "," << t.age << "," << (int)t.type << "," 
+        name.clear();
+        appendCsvText(name, t.name);
+        file << t.id << "," << name << "," << t.age << "," << (int)t.type << "," 
              << t.sourceId << "," << t.destId << "," << t.ticketPrice << "," << t.entryTime << "\n";
     }
     file.close();
+    return !file.fail();
 }
 
-void CSVManager::appendTicket(const Passenger& t) {
-    std::ifstream checkFile(TICKET_FILE);
-    bool fileExists = checkFile.good();
-    checkFile.close();
+/**
+ * Function: loadTickets
+ * Parses tickets.csv in place from a memory-mapped view, in parallel
+ * 
+ * Parameters:
+ *   threads - worker count (0 = hardware_concurrency); files smaller than
+ *             TICKET_CHUNK_MIN_BYTES per worker use fewer workers
+ * 
+ * Algorithm:
+ *   1. Skip the header, split the rest at row boundaries (splitCsvRows -
+ *      quote-aware, so a quoted name with a line break is never cut)
+ *   2. Each worker parses its chunk into its own vector (no shared state,
+ *      no locks); BOM, CRLF and quoted names handled, bad rows dropped
+ *   3. Merge: prefix sums give each chunk its offset in 'tickets', then the
+ *      workers move their rows into place - file order is kept
+ *   With one worker the rows are parsed straight into 'tickets'.
+ * 
+ * Time Complexity: O(file size / threads) + O(rows / threads) for the merge
+ */
+bool CSVManager::loadTickets(std::vector<Passenger>& tickets, int threads) {
+    MappedFile file;
+    if (!file.open(TICKET_FILE)) return false;
+
+    tickets.clear();
+    CsvCursor header(file.begin(), file.end());
+    header.skipLine();
+    const char* body = header.position();
 
-    std::ofstream file(TICKET_FILE, std::ios::app);
-    if (!file.is_open()) return;
+    if (threads <= 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    size_t bySize = (file.end() - body) / TICKET_CHUNK_MIN_BYTES;
+    threads = (int)std::max((size_t)1, std::min((size_t)threads, bySize));
 
-    if (!fileExists) {
-        file << "id,name,age,type,sourceId,destId,ticketPrice,entryTime\n";
+    if (threads == 1) {
+        CsvCursor in(body, file.end());
+        parseTicketRows(in, tickets);
+        return true;
     }
-    file << t.id << "," << t.name << "," << t.age << "," << (int)t.type << "," 
-         << t.sourceId << "," << t.destId << "," << t.ticketPrice << "," << t.entryTime << "\n";
-    file.close();
-}
 
-bool CSVManager::loadTickets(std::vector<Passenger>& tickets) {
-    std::ifstream file(TICKET_FILE);
-    if (!file.is_open()) return false;
+    std::vector<const char*> edges = splitCsvRows(body, file.end(), threads);
+    int chunks = (int)edges.size() - 1;
+    std::vector<std::vector<Passenger> > parts(chunks);
+    std::vector<std::thread> workers;
 
-    tickets.clear();
-    std::string line, word;
-    std::getline(file, line); // Skip header
-
-    while (std::getline(file, line)) {
-        std::stringstream ss(line);
-        Passenger t;
-        int type;
+    for (int c = 0; c < chunks; c++) {
+        workers.push_back(std::thread([&parts, &edges, c]() {
+            CsvCursor in(edges[c], edges[c + 1]);
+            parseTicketRows(in, parts[c]);
+        }));
+    }
+    for (auto& w : workers) w.join();
+    workers.clear();
 
-        std::getline(ss, word, ','); t.id = std::stoi(word);
-        std::getline(ss, t.name, ',');
-        std::getline(ss, word, ','); t.age = std::stoi(word);
-        std::getline(ss, word, ','); type = std::stoi(word); t.type = (PassengerType)type;
-        std::getline(ss, word, ','); t.sourceId = std::stoi(word);
-        std::getline(ss, word, ','); t.destId = std::stoi(word);
-        std::getline(ss, word, ','); t.ticketPrice = std::stoi(word);
-        std::getline(ss, word, ','); t.entryTime = std::stol(word);
+    std::vector<size_t> offset(chunks + 1, 0);
+    for (int c = 0; c < chunks; c++) offset[c + 1] = offset[c] + parts[c].size();
+    tickets.resize(offset[chunks]);
 
-        tickets.push_back(t);
+    for (int c = 0; c < chunks; c++) {
+        workers.push_back(std::thread([&parts, &offset, &tickets, c]() {
+            std::move(parts[c].begin(), parts[c].end(), tickets.begin() + offset[c]);
+            std::vector<Passenger>().swap(parts[c]);
+        }));
     }
-    file.close();
+    for (auto& w : workers) w.join();
     return true;
 }
 
-void CSVManager::saveRoutes(RailwayNetwork* network) {
-    std::ofstream file(ROUTE_FILE);
-    if (!file.is_open()) return;
+/**
+ * Function: saveRoutes
+ * Exports every track once as routes.csv (temp file + rename)
+ * Returns: false if the file could not be written
+ */
+bool CSVManager::saveRoutes(const std::vector<std::vector<Edge>>& tracks) {
+    std::string tmpPath = ROUTE_FILE + ".tmp";
+    std::ofstream file(tmpPath);
+    if (!file.is_open()) return false;
 
     file << "u,v,weight,distance,line\n";
-    for (int u = 0; u < (int)adj.size(); ++u) {
-        for (const auto& edge : adj[u]) {
+    for (int u = 0; u < (int)tracks.size(); ++u) {
+        for (const auto& edge : tracks[u]) {
             if (u < edge.to) { // Avoid duplicates for bidirectional tracks
                 file << u << "," << edge.to << "," << edge.weight << "," 
                      << edge.distance << "," << (int)edge.line << "\n";
@@ -144,27 +277,96 @@ void CSVManager::saveRoutes(RailwayNetwork* network) {
         }
     }
     file.close();
+    if (file.fail()) {
+        remove(tmpPath.c_str());
+        return false;
+    }
+    return replaceWith(tmpPath, ROUTE_FILE);
 }
 
 bool CSVManager::loadRoutes(RailwayNetwork* network) {
-    std::ifstream file(ROUTE_FILE);
-    if (!file.is_open()) return false;
+    MappedFile file;
+    if (!file.open(ROUTE_FILE)) return false;
 
-    std::string line, word;
-    std::getline(file, line); // Skip header
+    CsvCursor in(file.begin(), file.end());
+    in.skipLine(); // Skip header
 
-    while (std::getline(file, line)) {
-        std::stringstream ss(line);
+    while (!in.atEnd()) {
         int u, v, w, dist, lineType;
-
-        std::getline(ss, word, ','); u = std::stoi(word);
-        std::getline(ss, word, ','); v = std::stoi(word);
-        std::getline(ss, word, ','); w = std::stoi(word);
-        std::getline(ss, word, ','); dist = std::stoi(word);
-        std::getline(ss, word, ','); lineType = std::stoi(word);
+        bool ok = in.readInt(u) && in.readInt(v) && in.readInt(w) &&
+                  in.readInt(dist) && in.readInt(lineType);
+        if (!in.endRow() || !ok) continue;
+        if (u < 0 || v < 0 || u >= (int)adj.size() || v >= (int)adj.size()) continue;
 
         network->addTrack(u, v, w, dist, (LineType)lineType);
     }
-    file.close();
     return true;
 }
+
+/**
+ * Function: loadTimetable
+ * Streams a timetable file into the Scheduler with a single bulk heap build
+ * 
+ * File Format (header optional, UTF-8 BOM tolerated):
+ *   trainId,name,departure,startStationId
+ *   101,Churchgate Fast,06:00,0
+ * 
+ * Algorithm:
+ *   1. fread() fixed 64 KB blocks; a partial last line is moved to the front
+ *      of the buffer and completed by the next block
+ *   2. Each row is parsed in place (memchr + digit loops) and appended to one
+ *      TrainBatch (16-byte hot record + interned name id); a repeated
+ *      trainId is skipped with a warning, the first row for it is kept
+ *   3. The batch is moved into Scheduler::scheduleTrains - one O(n) heapify
+ * 
+ * Time Complexity: O(file size + n)
+ */
+int CSVManager::loadTimetable(Scheduler& scheduler, const std::string& path) {
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file) return -1;
+
+    const size_t BLOCK = 1 << 16;
+    std::vector<char> buffer(BLOCK);
+    TrainBatch trains;
+    std::unordered_set<int> seen;
+    int duplicates = 0;
+    size_t carried = 0;
+    bool firstLine = true;
+
+    while (true) {
+        size_t got = fread(&buffer[carried], 1, buffer.size() - carried, file);
+        size_t filled = carried + got;
+        bool atEnd = (got == 0);
+        if (filled == 0) break;
+
+        const char* p = &buffer[0];
+        const char* end = p + filled;
+        while (p < end) {
+            const char* nl = (const char*)memchr(p, '\n', end - p);
+            if (nl == NULL && !atEnd) break;  // Incomplete line - wait for more data
+            const char* lineEnd = nl ? nl : end;
+            const char* rowEnd = (lineEnd > p && lineEnd[-1] == '\r') ? lineEnd - 1 : lineEnd;
+
+            if (firstLine) {
+                if (rowEnd - p >= 3 && memcmp(p, "\xEF\xBB\xBF", 3) == 0) p += 3;
+                firstLine = false;
+            }
+            if (rowEnd > p) parseTimetableRow(p, rowEnd, trains, seen, duplicates);
+            p = nl ? nl + 1 : end;
+        }
+
+        carried = end - p;
+        if (atEnd) break;
+        size_t from = p - &buffer[0];   // resize() may move the buffer
+        if (carried == buffer.size()) buffer.resize(buffer.size() * 2);  // Very long line
+        memmove(&buffer[0], &buffer[from], carried);
+    }
+    fclose(file);
+    if (duplicates > 0) {
+        std::cerr << "Timetable: skipped " << duplicates << " row(s) with a repeated trainId\n";
+    }
+
+    int loaded = trains.size();
+    scheduler.scheduleTrains(std::move(trains));
+    return loaded;
+}
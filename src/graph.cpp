@@ -16,6 +16,8 @@
 #include <iostream>
 #include <queue>
 #include <vector>
+#include <algorithm>
+#include <functional>
 
 // ======================================================================================
 //                                   RAILWAY NETWORK IMPLEMENTATION
@@ -106,8 +108,8 @@ void RailwayNetwork::findFastestRoute(int src, int dest) {
 
     // Check if destination is unreachable
     if (dist[dest] == INF) {
-        std::cout << "No route found between " << stationIdToName[src] << " and " 
-                  << stationIdToName[dest] << std::endl;
+        std::cout << "No route found between " << stationDirectory.name(src) << " and " 
+                  << stationDirectory.name(dest) << std::endl;
         return;
     }
 
@@ -138,7 +140,7 @@ void RailwayNetwork::findFastestRoute(int src, int dest) {
     while (!pathCopy.empty()) {
         int s = pathCopy.top();
         pathCopy.pop();
-        std::cout << stationIdToName[s];
+        std::cout << stationDirectory.name(s);
         if (!pathCopy.empty()) std::cout << " -> ";
     }
     
@@ -178,7 +180,7 @@ void RailwayNetwork::showConnectivity(int startNode) {
     q.push(startNode);
 
     std::cout << "\n========== Network Connectivity (BFS) ==========";
-    std::cout << "\nStarting from: " << stationIdToName[startNode];
+    std::cout << "\nStarting from: " << stationDirectory.name(startNode);
     std::cout << "\n\nReachable Stations:\n";
 
     int count = 0;
@@ -202,7 +204,7 @@ void RailwayNetwork::showConnectivity(int startNode) {
     // Display numbered list of reachable stations
     for (int i = 0; i < (int)reachableStations.size(); ++i) {
         int stationId = reachableStations[i];
-        std::cout << "  " << (i + 1) << ". " << stationIdToName[stationId] 
+        std::cout << "  " << (i + 1) << ". " << stationDirectory.name(stationId) 
                   << " (ID: " << stationId << ")\n";
     }
     
@@ -217,6 +219,7 @@ void RailwayNetwork::showConnectivity(int startNode) {
  * 
  * Parameters:
  *   u, v - Station IDs representing the track to be blocked
+ *   announce - Print the alert (false when replaying the change log)
  * 
  * Implementation:
  *   - Sets weight to INF in both directions (bidirectional edge)
@@ -227,7 +230,7 @@ void RailwayNetwork::showConnectivity(int startNode) {
  * 
  * Real-world use: Track failures, maintenance, accidents, signal problems
  */
-void RailwayNetwork::blockTrack(int u, int v) {
+void RailwayNetwork::blockTrack(int u, int v, bool announce) {
     // Block track from u to v
     for(auto& edge : adj[u]) {
         if(edge.to == v) edge.weight = INF;
@@ -238,8 +241,9 @@ void RailwayNetwork::blockTrack(int u, int v) {
         if(edge.to == u) edge.weight = INF;
     }
     
-    std::cout << "[ALERT] Track between " << stationIdToName[u] << " and " 
-              << stationIdToName[v] << " BLOCKED due to emergency.\n";
+    if (!announce) return;
+    std::cout << "[ALERT] Track between " << stationDirectory.name(u) << " and " 
+              << stationDirectory.name(v) << " BLOCKED due to emergency.\n";
 }
 
 /**
@@ -281,7 +285,7 @@ void RailwayNetwork::displayNetworkStats() {
     std::cout << "Average Connections per Station: " 
               << (V > 0 ? (double)totalEdges * 2 / V : 0) << std::endl;
     std::cout << "Most Connected Station (Hub): " 
-              << stationIdToName[maxConnectedStation] 
+              << stationDirectory.name(maxConnectedStation) 
               << " (" << maxConnections << " connections)" << std::endl;
     std::cout << "================================================\n";
 }
@@ -298,7 +302,9 @@ void RailwayNetwork::displayNetworkStats() {
  *   Total distance in kilometers, or INF if no path exists
  * 
  * Algorithm:
- *   Same as findFastestRoute but returns distance instead of displaying route
+ *   Same as findFastestRoute but returns distance instead of displaying route.
+ *   The distance array and the heap are member buffers reused by every call
+ *   (one fare lookup per booking, no allocation once they have grown).
  * 
  * Time Complexity: O((V + E) log V)
  * Use Case: Computing fare based on actual route distance
@@ -309,18 +315,21 @@ int RailwayNetwork::getDistance(int src, int dest) {
         return INF;
     }
     
-    // Use Dijkstra's algorithm to find minimum distance
-    std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>, 
-                        std::greater<std::pair<int, int>>> pq;
-    std::vector<int> distKm(V, INF);
+    // Use Dijkstra's algorithm to find minimum distance (min-heap on the scratch vector)
+    std::greater<std::pair<int, int>> later;
+    std::vector<std::pair<int, int>>& pq = frontierScratch;
+    std::vector<int>& distKm = distanceScratch;
+    pq.clear();
+    distKm.assign(V, INF);
     
     distKm[src] = 0;
-    pq.push({0, src});
+    pq.push_back({0, src});
     
     while (!pq.empty()) {
-        int d = pq.top().first;
-        int u = pq.top().second;
-        pq.pop();
+        std::pop_heap(pq.begin(), pq.end(), later);
+        int d = pq.back().first;
+        int u = pq.back().second;
+        pq.pop_back();
         
         if (d > distKm[u]) continue;  // Skip if already processed
         if (u == dest) break;          // Early termination if destination reached
@@ -332,10 +341,76 @@ int RailwayNetwork::getDistance(int src, int dest) {
             
             if (distKm[u] + edgeDistance < distKm[v]) {
                 distKm[v] = distKm[u] + edgeDistance;
-                pq.push({distKm[v], v});
+                pq.push_back({distKm[v], v});
+                std::push_heap(pq.begin(), pq.end(), later);
             }
         }
     }
     
     return distKm[dest];
 }
+
+/**
+ * Function: traceLineRoute
+ * Walks a single railway line outward from a starting station
+ * 
+ * Parameters:
+ *   startNode - Station ID to start the walk from (usually a line terminus)
+ *   line - LineType whose tracks should be followed
+ * 
+ * Returns:
+ *   The hops taken in order; hop.to is the next stop and hop.weight the travel
+ *   time to reach it. Empty if the station has no open track on that line.
+ * 
+ * Algorithm:
+ *   - At every station follow the first unvisited, unblocked edge of the same line
+ *   - Stops when the line runs out (terminus) or only visited stations remain
+ * 
+ * Time Complexity: O(V + E)
+ * 
+ * Use Case: Building train itineraries for simulation and delay propagation
+ */
+std::vector<Edge> RailwayNetwork::traceLineRoute(int startNode, LineType line) {
+    std::vector<Edge> route;
+    if (startNode < 0 || startNode >= V) return route;
+    
+    std::vector<bool> visited(V, false);
+    visited[startNode] = true;
+    int u = startNode;
+    
+    while (true) {
+        int next = -1;
+        for (const auto& edge : adj[u]) {
+            if (edge.line == line && edge.weight < INF && !visited[edge.to]) {
+                route.push_back(edge);
+                next = edge.to;
+                break;
+            }
+        }
+        if (next == -1) break;
+        visited[next] = true;
+        u = next;
+    }
+    return route;
+}
+
+/**
+ * Function: getMinTravelTime
+ * Returns the smallest travel time over all open tracks
+ * 
+ * Returns: Minimum edge weight in minutes, or INF if the network has no tracks
+ * 
+ * Time Complexity: O(V + E)
+ * 
+ * Use Case: Lookahead window for the parallel line-partitioned simulation -
+ *           no train can reach another station sooner than this
+ */
+int RailwayNetwork::getMinTravelTime() {
+    int best = INF;
+    for (int u = 0; u < V; u++) {
+        for (const auto& edge : adj[u]) {
+            if (edge.weight < best) best = edge.weight;
+        }
+    }
+    return best;
+}
@@ -6,7 +6,7 @@
  * ======================================================================================
  * 
  * SYSTEM ARCHITECTURE:
- * - Station Management: BST-based directory, global station network
+ * - Station Management: sorted name index, global station network
  * - Graph Network: Dijkstra's shortest path, BFS connectivity
  * - Ticketing System: Multi-queue priority processing
  * - Train Scheduling: MinHeap-based time management
@@ -14,7 +14,7 @@
  * - Analytics: Comprehensive reporting and statistics
  * 
  * DATA STRUCTURES USED:
- * 1. Binary Search Tree (BST): Station directory
+ * 1. Sorted Flat Array: Station directory (case-insensitive prefix index)
  * 2. Custom Stack: Path reconstruction in routing
  * 3. Custom Queue: Ticketing, BFS traversal
  * 4. Circular Queue: Platform management
@@ -25,7 +25,7 @@
  * ALGORITHMS USED:
  * 1. Dijkstra's Algorithm: Fastest route finding
  * 2. BFS: Network connectivity checks
- * 3. BST Operations: Station search and traversal
+ * 3. Binary Search: Station lookup and prefix autocomplete
  * 4. Heap Operations: Priority-based scheduling
  * 5. Queue Processing: Multi-priority ticket handling
  * ======================================================================================
@@ -37,6 +37,9 @@
 #include <cstdlib>
 #include <iomanip>
 #include <algorithm>
+#include <cstring>
+#include <atomic>
+#include <new>
 
 // Include all module headers
 #include "../include/globals.h"
@@ -47,10 +50,36 @@
 #include "../include/queue_manager.h"
 #include "../include/analytics.h"
 #include "../include/csv_manager.h"
+#include "../include/simulation.h"
+#include "../include/platform_allocator.h"
+#include "../include/headway_optimizer.h"
+#include "../include/service_loader.h"
+#include "../include/ticket_journal.h"
+#include "../include/passenger_flow.h"
+#include "../include/change_log.h"
+#include "../include/ticket_archive.h"
+#include "../include/system_image.h"
 #include "../include/colors.h"
 
 using namespace std;
 
+#ifdef DEBUG
+// Debug builds (make debug) count every heap allocation, so a booking can
+// report what it cost once its buffers are warm
+static std::atomic<unsigned long long> heapAllocations(0);
+
+void* operator new(size_t size) {
+    heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+#if defined(__GNUC__) && __GNUC__ >= 11
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"   // free() pairs with the malloc() above
+#endif
+void operator delete(void* p) noexcept { free(p); }
+#endif
+
 enum NavigatorState { MAIN_MENU, STATIONS_MENU, TICKETING_MENU, ANALYTICS_MENU, ADMIN_MENU };
 
 // Dashboard and Navigation Functions
@@ -63,6 +92,9 @@ void displayAdminDashboard();
 // Administrative Functions
 void handleNewRoute();
 void handleFareUpdate();
+void handleTrainDelay();
+void handlePlatformAllocation();
+void handleFrequencyOptimization();
 
 // ======================================================================================
 //                                   GLOBAL SYSTEM OBJECTS
@@ -71,16 +103,49 @@ void handleFareUpdate();
 double BASE_FARE = 10.0;
 double FARE_PER_KM = 2.0;
 
-StationBST stationDirectory;        // BST for station search
 TicketSystem ticketMachine;         // Multi-queue ticketing system
 Scheduler trainScheduler;           // MinHeap-based train scheduler
 RailwayNetwork* mumbaiLocal;        // Graph-based railway network
 PlatformQueue platformManager(10);  // Circular queue for platform allocation
+PlatformAllocator platformPlanner;  // Per-station interval-scheduling platform plan
+TicketJournal ticketJournal;        // Group-commit writer for tickets.csv
+ChangeLog networkLog;               // Snapshot + write-ahead log for stations and tracks
+ScheduleImage startupSchedule;      // Schedule as built at startup (saved in system.img)
 
 // ======================================================================================
 //                                   SYSTEM INITIALIZATION
 // ======================================================================================
 
+/**
+ * Function: exportNetworkCSV
+ * Writes stations.csv and routes.csv from the live network. Recovery reads
+ * the snapshot + log; the CSVs are the interchange copy for other tools.
+ */
+void exportNetworkCSV() {
+    if (!CSVManager::saveStations(allStations) || !CSVManager::saveRoutes(adj)) {
+        cout << YELLOW << "⚠ Could not export stations.csv / routes.csv\n" << RESET;
+    }
+}
+
+/**
+ * Function: attachSharedItineraries
+ * Gives each train the itinerary of its start station's line. One route is
+ * built per start station (times from 0) and shared; each train only stores
+ * its departure as the offset.
+ */
+void attachSharedItineraries(const std::vector<Train>& trains) {
+    std::unordered_map<int, SharedRoute> routeCache;
+    for (const auto& t : trains) {
+        if (t.nextStationId < 0 || t.nextStationId >= (int)allStations.size()) continue;
+        SharedRoute& route = routeCache[t.nextStationId];
+        if (!route) {
+            route = std::make_shared<const std::vector<TrainStop>>(
+                buildItinerary(mumbaiLocal, t.nextStationId, allStations[t.nextStationId].line, 0));
+        }
+        trainScheduler.setItinerary(t.trainId, route, t.arrivalTime);
+    }
+}
+
 /**
  * Function: initializeSystem
  * Initializes the Mumbai Local Railway system with persistence support
@@ -88,39 +153,82 @@ PlatformQueue platformManager(10);  // Circular queue for platform allocation
 void initializeSystem() {
     // Step 1: Create railway network graph
     mumbaiLocal = new RailwayNetwork(MAX_STATIONS);
-    
-    // Attempt to load from CSV first
-    if (CSVManager::loadStations(allStations) && !allStations.empty()) {
-        // Re-populate BST and lookup maps from loaded vector
-        for (const auto& s : allStations) {
-            stationDirectory.addStation(s.name, s.id);
-            string nameL = s.name;
-            std::transform(nameL.begin(), nameL.end(), nameL.begin(), ::tolower);
-            stationNameToId[nameL] = s.id;
-            stationIdToName[s.id] = s.name;
-        }
+    CSVManager::initializeDataDirectory();
+    
+    // Step 2: Binary system image + change-log tail, else the text snapshot +
+    //         tail, else stations.csv / routes.csv, else the built-in network
+    int replayed = 0;
+    bool builtIn = false;
+    SystemImage image;
+    bool fromImage = image.open() && networkLog.canResume(image.getNetworkSeq()) &&
+                     image.installNetwork(stationDirectory);
+    if (fromImage) networkLog.resume(mumbaiLocal, image.getNetworkSeq(), replayed);
+    bool recovered = fromImage || networkLog.recover(mumbaiLocal, replayed);
+    if (fromImage) {
+        // Stations, tracks and the station directory were installed from the image
+    } else if (recovered || (CSVManager::loadStations(allStations) && !allStations.empty())) {
+        // Re-populate the station directory from loaded vector
+        stationDirectory.build(allStations);
         
-        // Load routes into the graph
-        CSVManager::loadRoutes(mumbaiLocal);
+        // Load routes into the graph (the snapshot already carried them)
+        if (!recovered) CSVManager::loadRoutes(mumbaiLocal);
     } else {
         initializeStations(stationDirectory, mumbaiLocal);
-        
-        // Save for next time
-        CSVManager::saveStations(allStations);
-        CSVManager::saveRoutes(mumbaiLocal);
-    }
-    
-    // Step 4: Schedule initial trains (Static for demo)
-    if (stationNameToId.count("churchgate")) 
-        trainScheduler.scheduleTrain(101, "Churchgate Fast", 360, stationNameToId["churchgate"]);
-    if (stationNameToId.count("virar"))
-        trainScheduler.scheduleTrain(102, "Virar Slow", 375, stationNameToId["virar"]);
-    if (stationNameToId.count("dadar"))
-        trainScheduler.scheduleTrain(201, "Dadar Special", 480, stationNameToId["dadar"]);
-    
-    // Step 5: Assign some trains to platform queue
-    platformManager.enqueue(101);
-    platformManager.enqueue(102);
+        builtIn = true;
+    }
+    
+    // Step 3: Log every later change; seed the first snapshot if there was none
+    //         (and export the CSVs when the network was built in)
+    if (networkLog.open(mumbaiLocal) && !recovered) {
+        networkLog.checkpoint();
+    }
+    if (builtIn) exportNetworkCSV();
+    
+    // Step 4: Startup schedule from the image while timetable.csv, routes.json
+    //         and the graph are unchanged; otherwise bulk-load timetable.csv and
+    //         the routes.json services, falling back to the demo trains
+    if (!(fromImage && image.installSchedule(trainScheduler, startupSchedule))) {
+        if (CSVManager::loadTimetable(trainScheduler) > 0) {
+            // One shared itinerary per starting station, offset by each train's departure
+            attachSharedItineraries(trainScheduler.getScheduledTrains());
+        }
+        ServiceLoader::loadServices(trainScheduler);
+    
+        if (!trainScheduler.hasScheduledTrains()) {
+            struct DemoRun { int trainId; const char* name; int departure; const char* start; };
+            const DemoRun demoRuns[] = { {101, "Churchgate Fast", 360, "Churchgate"},
+                                         {102, "Virar Slow", 375, "Virar"},
+                                         {201, "Dadar Special", 480, "Dadar"} };
+            for (const auto& run : demoRuns) {
+                int startId = stationDirectory.getStationId(run.start, strlen(run.start));
+                if (startId != -1) trainScheduler.scheduleTrain(run.trainId, run.name, run.departure, startId);
+            }
+    
+            // Attach itineraries so delays can propagate downstream
+            for (const auto& run : demoRuns) {
+                int startId = stationDirectory.getStationId(run.start, strlen(run.start));
+                if (startId == -1) continue;
+                trainScheduler.setItinerary(run.trainId,
+                    buildItinerary(mumbaiLocal, startId, allStations[startId].line, run.departure));
+            }
+        }
+        startupSchedule = captureSchedule(trainScheduler);
+    }
+    image.close();
+    
+    // Plan platforms at every station the itineraries call at
+    platformPlanner.allocateAll(trainScheduler);
+    
+    // Step 5: Assign the first departures of the day to the platform queue
+    std::vector<Train> firstTrains = trainScheduler.getScheduledTrains();
+    size_t queued = std::min<size_t>(2, firstTrains.size());
+    std::partial_sort(firstTrains.begin(), firstTrains.begin() + queued, firstTrains.end());
+    for (size_t i = 0; i < queued; i++) platformManager.enqueue(firstTrains[i].trainId);
+    
+    // Step 6: Start the ticket journal (batched appends to tickets.csv)
+    if (!ticketJournal.open()) {
+        cout << YELLOW << "⚠ Could not open ticket journal - tickets will not be saved\n" << RESET;
+    }
 }
 
 // ======================================================================================
@@ -202,11 +310,12 @@ void displayStationsRoutesDashboard() {
     cout << BOLDCYAN << "\n" << "╔════════════════════════════════════════════════════════╗" << "\n";
     cout << "║             " << BOLDWHITE << "STATIONS & NETWORK MANAGEMENT" << BOLDCYAN << "             ║" << "\n";
     cout << "╚════════════════════════════════════════════════════════╝" << RESET << "\n";
-    cout << "  1. View All Stations (BST Traversal)\n";
-    cout << "  2. Search Station (BST Search)\n";
+    cout << "  1. View All Stations (Lexical Order)\n";
+    cout << "  2. Search Station (Index Search)\n";
     cout << "  3. Find Fastest Route (Dijkstra's)\n";
     cout << "  4. Check Network Connectivity (BFS)\n";
     cout << "  5. View Network Statistics\n";
+    cout << "  6. Custom Structure Timing (Array vs Linked Nodes)\n";
     cout << "  9. Back to Main Menu\n";
     cout << "  0. Exit\n";
     cout << "--------------------------------------------------------\n";
@@ -222,6 +331,8 @@ void displayTicketingDashboard() {
     cout << "  3. View Train Schedules (Min-Heap)\n";
     cout << "  4. Process Platform Arrivals (Circular Queue)\n";
     cout << "  5. Simulate Passenger Load\n";
+    cout << "  6. Platform Allocation Plan (Interval Scheduling)\n";
+    cout << "  7. Rush Hour: Concurrent Ticket Counters (Lock-free Lanes)\n";
     cout << "  9. Back to Main Menu\n";
     cout << "  0. Exit\n";
     cout << "--------------------------------------------------------\n";
@@ -236,6 +347,8 @@ void displayAnalyticsDashboard() {
     cout << "  2. Station Congestion Heatmap\n";
     cout << "  3. Peak Hour Performance Stats\n";
     cout << "  4. Comprehensive System Dashboard\n";
+    cout << "  5. Simulate Full Day (Parallel by Line)\n";
+    cout << "  6. Ticket History (Columnar Store)\n";
     cout << "  9. Back to Main Menu\n";
     cout << "  0. Exit\n";
     cout << "--------------------------------------------------------\n";
@@ -249,6 +362,8 @@ void displayAdminDashboard() {
     cout << "  1. Create New Route (Add Track)\n";
     cout << "  2. Update System Fare Rates\n";
     cout << "  3. Report Emergency Track Failure\n";
+    cout << "  4. Report Train Delay (Propagate)\n";
+    cout << "  5. Optimize Train Frequency (Ticket Demand)\n";
     cout << "  9. Back to Main Menu\n";
     cout << "  0. Exit\n";
     cout << "--------------------------------------------------------\n";
@@ -290,9 +405,7 @@ void handleNewRoute() {
     cin.ignore();
     getline(cin, src);
     
-    string srcL = src;
-    std::transform(srcL.begin(), srcL.end(), srcL.begin(), ::tolower);
-    int u = stationDirectory.getStationId(srcL);
+    int u = stationDirectory.getStationId(src);
     if (u == -1) {
         cout << RED << "❌ Station not found: " << src << RESET << endl;
         return;
@@ -300,9 +413,7 @@ void handleNewRoute() {
     
     cout << "Enter destination station: ";
     getline(cin, dest);
-    string destL = dest;
-    std::transform(destL.begin(), destL.end(), destL.begin(), ::tolower);
-    int v = stationDirectory.getStationId(destL);
+    int v = stationDirectory.getStationId(dest);
     if (v == -1) {
         cout << RED << "❌ Station not found: " << dest << RESET << endl;
         return;
@@ -331,17 +442,23 @@ void handleNewRoute() {
     cout << GREEN << "✓ Track added between " << src << " and " << dest 
          << " (" << distance << " km, " << time << " mins)\n" << RESET;
     
-    // Save the new network state
-    CSVManager::saveRoutes(mumbaiLocal);
+    // Log the change (one appended record, not a rewrite of every track)
+    if (!networkLog.logTrackAdded(u, v, time, distance, line)) {
+        cout << YELLOW << "⚠ Track not saved to the change log - it is lost on a crash\n" << RESET;
+    }
 }
 
 /**
  * Function: showStationSuggestions
  * Displays matching station suggestions and allows user to select one
+ * Prefix matches first; if there are none, names within a few typos
  * Returns station ID on successful selection, -1 if user cancels
  */
 int showStationSuggestions(const std::string& prefix) {
     std::vector<std::pair<std::string, int>> suggestions = stationDirectory.listMatchingStations(prefix);
+    if (suggestions.empty()) {
+        suggestions = stationDirectory.listSimilarStations(prefix, allStations);
+    }
     
     if (suggestions.empty()) {
         cout << RED << "\n❌ No stations found matching: " << prefix << "\n" << RESET;
@@ -368,7 +485,7 @@ int showStationSuggestions(const std::string& prefix) {
 
 /**
  * Function: handleStationSearch
- * Searches for a station by name using BST
+ * Searches for a station by name (hash map, then prefix suggestions from the index)
  */
 void handleStationSearch() {
     string stationName;
@@ -379,14 +496,7 @@ void handleStationSearch() {
     cin.ignore();
     getline(cin, stationName);
     
-    // Convert to lowercase for lookup
-    string stationNameLower = stationName;
-    std::transform(stationNameLower.begin(), stationNameLower.end(), stationNameLower.begin(), ::tolower);
-    
-    int stationId = -1;
-    if (stationNameToId.find(stationNameLower) != stationNameToId.end()) {
-        stationId = stationNameToId[stationNameLower];
-    }
+    int stationId = stationDirectory.getStationId(stationName);
     
     if (stationId == -1) {
         cout << RED << "\n❌ Station not found: " << stationName << "\n" << RESET;
@@ -421,19 +531,8 @@ void handleRouteSearch() {
     cout << "Enter destination station: ";
     getline(cin, destName);
     
-    // Convert to lowercase for lookup
-    string srcNameLower = srcName;
-    string destNameLower = destName;
-    std::transform(srcNameLower.begin(), srcNameLower.end(), srcNameLower.begin(), ::tolower);
-    std::transform(destNameLower.begin(), destNameLower.end(), destNameLower.begin(), ::tolower);
-    
-    int srcId = -1, destId = -1;
-    if (stationNameToId.find(srcNameLower) != stationNameToId.end()) {
-        srcId = stationNameToId[srcNameLower];
-    }
-    if (stationNameToId.find(destNameLower) != stationNameToId.end()) {
-        destId = stationNameToId[destNameLower];
-    }
+    int srcId = stationDirectory.getStationId(srcName);
+    int destId = stationDirectory.getStationId(destName);
     
     if (srcId == -1) {
         cout << "\n❌ Source station not found: " << srcName << "\n";
@@ -463,14 +562,7 @@ void handleConnectivityCheck() {
     cin.ignore();
     getline(cin, stationName);
     
-    // Convert to lowercase for lookup
-    string stationNameLower = stationName;
-    std::transform(stationNameLower.begin(), stationNameLower.end(), stationNameLower.begin(), ::tolower);
-    
-    int stationId = -1;
-    if (stationNameToId.find(stationNameLower) != stationNameToId.end()) {
-        stationId = stationNameToId[stationNameLower];
-    }
+    int stationId = stationDirectory.getStationId(stationName);
     
     if (stationId == -1) {
         cout << "\n❌ Station not found: " << stationName << "\n";
@@ -485,10 +577,20 @@ void handleConnectivityCheck() {
  * Function: handleTicketing
  * Processes ticket purchase with multi-queue priority system
  * Now computes fare based on real distance between source and destination
+ *
+ * The input lines and the Passenger record are reused across bookings: the
+ * name is read straight into the record, and the ledger hands a recycled
+ * record back on issue, so a warm booking makes no heap allocation (debug
+ * builds print the count).
  */
 void handleTicketing() {
-    string name, srcName, destName;
+    static Passenger p;
+    static string srcName, destName;
+    static int ticketIdCounter = 1;
     int age;
+#ifdef DEBUG
+    unsigned long long allocationsBefore = heapAllocations.load();
+#endif
     
     cout << "\n┌────────────────────────────────────────────────────────┐\n";
     cout << "│                  TICKET BOOKING                        │\n";
@@ -496,7 +598,7 @@ void handleTicketing() {
     
     cout << "Enter passenger name: ";
     cin.ignore();
-    getline(cin, name);
+    getline(cin, p.name);
     cout << "Enter age: ";
     cin >> age;
     
@@ -517,14 +619,7 @@ void handleTicketing() {
     cin.ignore();
     getline(cin, srcName);
     
-    // Convert to lowercase for lookup
-    string srcNameLower = srcName;
-    std::transform(srcNameLower.begin(), srcNameLower.end(), srcNameLower.begin(), ::tolower);
-    
-    int srcId = -1;
-    if (stationNameToId.find(srcNameLower) != stationNameToId.end()) {
-        srcId = stationNameToId[srcNameLower];
-    }
+    int srcId = stationDirectory.getStationId(srcName);
     
     if (srcId == -1) {
         cout << "\n❌ Invalid source station: " << srcName << "\n";
@@ -536,14 +631,7 @@ void handleTicketing() {
     cout << "Enter destination station: ";
     getline(cin, destName);
     
-    // Convert to lowercase for lookup
-    string destNameLower = destName;
-    std::transform(destNameLower.begin(), destNameLower.end(), destNameLower.begin(), ::tolower);
-    
-    int destId = -1;
-    if (stationNameToId.find(destNameLower) != stationNameToId.end()) {
-        destId = stationNameToId[destNameLower];
-    }
+    int destId = stationDirectory.getStationId(destName);
     
     if (destId == -1) {
         cout << "\n❌ Invalid destination station: " << destName << "\n";
@@ -559,8 +647,7 @@ void handleTicketing() {
         return;
     }
     
-    // Create passenger object (simplified - no full Passenger struct needed)
-    cout << "\n✓ Passenger " << name << " added to ";
+    cout << "\n✓ Passenger " << p.name << " added to ";
     if (type == LADIES) cout << "LADIES";
     else if (type == SENIOR) cout << "SENIOR CITIZEN";
     else cout << "GENERAL";
@@ -578,31 +665,36 @@ void handleTicketing() {
     cout << BOLDBLUE << "\n━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n";
     cout << "                   TICKET DETAILS\n";
     cout << "━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n";
-    cout << "  Passenger:   " << name << " (Age: " << age << ")\n";
+    cout << "  Passenger:   " << p.name << " (Age: " << age << ")\n";
     cout << "  Source:      " << srcName << "\n";
     cout << "  Destination: " << destName << "\n";
     cout << "  Distance:    " << distance << " km\n";
     cout << "  Fare:        Rs. " << fare << "\n";
     cout << "━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━" << RESET << "\n";
     
-    // Create Passenger object for persistence
-    static int ticketIdCounter = 1;
-    Passenger p;
+    // Fill the rest of the record for persistence
     p.id = ticketIdCounter++;
-    p.name = name;
     p.age = age;
     p.type = type;
     p.sourceId = srcId;
     p.destId = destId;
     p.ticketPrice = fare;
     p.entryTime = time(0);
+    time_t issuedAt = p.entryTime;
 
-    // Persist to CSV
-    CSVManager::appendTicket(p);
+    // Issue through the TicketSystem (counts the sale; p moves into the ledger)
+    TicketHandle ticket = ticketMachine.issueTicket(p);
 
-    // Update ticketing stats - record in TicketSystem for analytics
-    ticketMachine.recordTicket(fare);
-    allStations[destId].passengerCount++;
+    // Persist through the group-commit journal straight from the ledger record
+    ticketMachine.withTicket(ticket, [](const Passenger& t) { ticketJournal.append(t); });
+    ticketMachine.addStationLoad(destId, 1);
+    networkLog.logPassengerFlow(destId, 1);
+    passengerFlow.record(srcId, FLOW_BOARDING, issuedAt);
+    passengerFlow.record(destId, FLOW_ALIGHTING, issuedAt);
+#ifdef DEBUG
+    cout << "[debug] heap allocations for this booking: "
+         << heapAllocations.load() - allocationsBefore << "\n";
+#endif
 }
 
 /**
@@ -619,11 +711,7 @@ void handleTrackFailure() {
     cin.ignore();
     getline(cin, station1);
     
-    // Convert to lowercase for lookup
-    string station1Lower = station1;
-    std::transform(station1Lower.begin(), station1Lower.end(), station1Lower.begin(), ::tolower);
-    
-    int id1 = stationDirectory.getStationId(station1Lower);
+    int id1 = stationDirectory.getStationId(station1);
     
     // If first station not found, show suggestions
     if (id1 == -1) {
@@ -638,11 +726,7 @@ void handleTrackFailure() {
     cout << "Enter second station: ";
     getline(cin, station2);
     
-    // Convert to lowercase for lookup
-    string station2Lower = station2;
-    std::transform(station2Lower.begin(), station2Lower.end(), station2Lower.begin(), ::tolower);
-    
-    int id2 = stationDirectory.getStationId(station2Lower);
+    int id2 = stationDirectory.getStationId(station2);
     
     // If second station not found, show suggestions
     if (id2 == -1) {
@@ -656,6 +740,92 @@ void handleTrackFailure() {
     
     // Both stations resolved, proceed to block track
     mumbaiLocal->blockTrack(id1, id2);
+    if (!networkLog.logTrackBlocked(id1, id2)) {
+        cout << YELLOW << "⚠ Blockage not saved to the change log - it is lost on a crash\n" << RESET;
+    }
+}
+
+/**
+ * Function: handleTrainDelay
+ * Reports a train running late at a station and propagates the delay
+ * to its later stops and to connecting trains at interchanges
+ */
+void handleTrainDelay() {
+    cout << "\n┌────────────────────────────────────────────────────────┐\n";
+    cout << "│              REPORT TRAIN DELAY                        │\n";
+    cout << "└────────────────────────────────────────────────────────┘\n";
+    
+    int trainId, delay;
+    cout << "Enter train ID: ";
+    if (!(cin >> trainId)) { cin.clear(); cin.ignore(10000, '\n'); return; }
+    
+    cout << "Enter station where delay occurred: ";
+    cin.ignore();
+    string stationName;
+    getline(cin, stationName);
+    int stationId = stationDirectory.getStationId(stationName);
+    if (stationId == -1) {
+        cout << "\n❌ Station not found: " << stationName << "\n";
+        stationId = showStationSuggestions(stationName);
+        if (stationId == -1) return;
+    }
+    
+    cout << "Enter delay (minutes): ";
+    if (!(cin >> delay) || delay <= 0) { cin.clear(); cin.ignore(10000, '\n'); return; }
+    
+    DelayReport report = trainScheduler.applyDelay(trainId, stationId, delay);
+    if (report.trainsAffected == 0) {
+        cout << YELLOW << "\n⚠️  Train " << trainId << " is not scheduled to call at "
+             << stationName << ".\n" << RESET;
+        return;
+    }
+    
+    cout << GREEN << "\n✓ Delay propagated\n" << RESET;
+    cout << "  Trains affected:     " << report.trainsAffected << "\n";
+    cout << "  Stop times updated:  " << report.stopsUpdated << "\n";
+    cout << "  Connections held:    " << report.connectionsHeld << "\n";
+    cout << "  Connections missed:  " << report.connectionsBroken << "\n";
+    
+    // Only the stations whose call times moved need new platform plans
+    int conflictsBefore = platformPlanner.getTotalConflicts();
+    platformPlanner.reallocate(trainScheduler, report.stationsAffected);
+    cout << "  Stations re-planned: " << report.stationsAffected.size()
+         << " (platform conflicts " << conflictsBefore << " → "
+         << platformPlanner.getTotalConflicts() << ")\n";
+    trainScheduler.showUpcomingTrains();
+}
+
+/**
+ * Function: handleFrequencyOptimization
+ * Sizes headways from ticket history and batch-schedules the extra trains
+ */
+void handleFrequencyOptimization() {
+    if (!ticketJournal.flush()) {   // Include tickets still in the journal buffer
+        cout << YELLOW << "⚠ Ticket journal is not persisting; latest tickets are missing\n" << RESET;
+    }
+    refreshTicketStore();
+    
+    // Stream the three columns the planner reads from every day partition and
+    // the live store - history is never materialised
+    TicketArchive archive;
+    archive.open();
+    TicketHistoryCursor history;
+    history.open(archive, TICKET_STORE_FILE, TicketFilter(),
+                 ticketField(TCOL_SOURCE) | ticketField(TCOL_DEST) | ticketField(TCOL_ENTRY_TIME));
+    
+    HeadwayOptimizer optimizer;
+    HeadwayPlan plan = optimizer.plan(history, trainScheduler);
+    showHeadwayPlan(plan);
+    if (plan.extraTrains.empty()) return;
+    
+    // Itineraries first (stop 0 is each train's departure, as its heap record),
+    // then the batch moves into the heap with one build, then platforms
+    attachSharedItineraries(plan.extraTrains.trains);
+    trainScheduler.optimizeFrequency(std::move(plan.extraTrains));
+    platformPlanner.allocateAll(trainScheduler);
+    
+    cout << GREEN << "✓ Schedule now has " << trainScheduler.getTotalScheduledTrains()
+         << " trains (platform conflicts: " << platformPlanner.getTotalConflicts() << ")\n" << RESET;
 }
 
 /**
@@ -692,6 +862,28 @@ void handlePlatformQueue() {
     }
 }
 
+/**
+ * Function: handlePlatformAllocation
+ * Shows the network platform plan and optionally one station in detail
+ */
+void handlePlatformAllocation() {
+    platformPlanner.showReport();
+    
+    cout << "\nEnter station name for detailed plan (blank to skip): ";
+    cin.ignore();
+    string name;
+    getline(cin, name);
+    if (name.empty()) return;
+    
+    int stationId = stationDirectory.getStationId(name);
+    if (stationId == -1) {
+        cout << "\n❌ Station not found: " << name << "\n";
+        stationId = showStationSuggestions(name);
+        if (stationId == -1) return;
+    }
+    platformPlanner.showStationPlan(stationId);
+}
+
 /**
  * Function: simulatePassengerLoad
  * Simulates random passenger traffic at stations
@@ -701,9 +893,13 @@ void simulatePassengerLoad() {
     cout << "│            SIMULATING PASSENGER TRAFFIC...             │\n";
     cout << "└────────────────────────────────────────────────────────┘\n\n";
     
+    int bucket = flowBucketOf(time(0));
     for (size_t i = 0; i < allStations.size(); ++i) {
         int additionalLoad = rand() % 500;
-        allStations[i].passengerCount += additionalLoad;
+        if (additionalLoad == 0) continue;
+        ticketMachine.addStationLoad((int)i, additionalLoad);
+        networkLog.logPassengerFlow((int)i, additionalLoad);
+        passengerFlow.recordBucket((int)i, FLOW_BOARDING, bucket, additionalLoad);
     }
     
     cout << "✓ Passenger load simulation complete.\n";
@@ -770,6 +966,7 @@ int main() {
                 case 3: handleRouteSearch(); break;
                 case 4: handleConnectivityCheck(); break;
                 case 5: mumbaiLocal->displayNetworkStats(); break;
+                case 6: showStructureTiming(2000000); break;
                 case 9: currentState = MAIN_MENU; break;
                 case 0: running = false; break;
                 default: cout << RED << "❌ Invalid option.\n" << RESET;
@@ -784,21 +981,21 @@ int main() {
             
             switch (subChoice) {
                 case 1: handleTicketing(); break;
-                case 2: ticketMachine.showStats(); break;
+                case 2: ticketMachine.showStats(); ticketJournal.showStats(); break;
                 case 3: 
                     {
                         cout << "Enter station name: ";
                         cin.ignore();
                         string name; getline(cin, name);
-                        string nameL = name;
-                        std::transform(nameL.begin(), nameL.end(), nameL.begin(), ::tolower);
-                        int id = stationDirectory.getStationId(nameL);
+                        int id = stationDirectory.getStationId(name);
                         if (id != -1) trainScheduler.showTrainsAtStation(id);
                         else cout << RED << "Station not found.\n" << RESET;
                     }
                     break;
                 case 4: handlePlatformQueue(); break;
                 case 5: simulatePassengerLoad(); break;
+                case 6: handlePlatformAllocation(); break;
+                case 7: showCounterRushScaling(200000); break;
                 case 9: currentState = MAIN_MENU; break;
                 case 0: running = false; break;
                 default: cout << RED << "❌ Invalid option.\n" << RESET;
@@ -816,6 +1013,13 @@ int main() {
                 case 2: displayCongestionReport(); break;
                 case 3: displayPeakHourStatistics(); break;
                 case 4: displayComprehensiveAnalytics(ticketMachine); break;
+                case 5: runDaySimulation(mumbaiLocal, 10); break;
+                case 6:
+                    if (!ticketJournal.flush()) {   // History includes this session's tickets
+                        cout << YELLOW << "⚠ Ticket journal is not persisting; latest tickets are missing\n" << RESET;
+                    }
+                    displayTicketHistoryReport();
+                    break;
                 case 9: currentState = MAIN_MENU; break;
                 case 0: running = false; break;
                 default: cout << RED << "❌ Invalid option.\n" << RESET;
@@ -832,6 +1036,8 @@ int main() {
                 case 1: handleNewRoute(); break;
                 case 2: handleFareUpdate(); break;
                 case 3: handleTrackFailure(); break;
+                case 4: handleTrainDelay(); break;
+                case 5: handleFrequencyOptimization(); break;
                 case 9: currentState = MAIN_MENU; break;
                 case 0: running = false; break;
                 default: cout << RED << "❌ Invalid option.\n" << RESET;
@@ -849,8 +1055,18 @@ int main() {
     
     // Auto-save on exit
     cout << YELLOW << "\nSaving system state..." << RESET << "\n";
-    CSVManager::saveStations(allStations);
-    CSVManager::saveRoutes(mumbaiLocal);
+    if (networkLog.checkpoint()) {
+        writeSystemImage(networkLog.getSnapshotSeq(), startupSchedule);
+    }
+    if (!networkLog.close()) {
+        cout << RED << "❌ The network change log could not be flushed to disk\n" << RESET;
+    }
+    exportNetworkCSV();     // stations.csv / routes.csv stay the interchange format
+    if (!ticketJournal.close()) {
+        cout << RED << "❌ Some tickets could not be written to tickets.csv\n" << RESET;
+    }
+    sealTicketPartitions(); // Closed service days → data/archive, tickets.csv keeps today
+    refreshTicketStore();   // Columnar copy of tickets.csv for history scans
     
     cout << BOLDCYAN << "\n╔════════════════════════════════════════════════════════╗\n";
     cout << "║          " << BOLDWHITE << "Thank you for using the system!" << BOLDCYAN << "               ║\n";
@@ -0,0 +1,275 @@
+/**
+ * ======================================================================================
+ * IMPLEMENTATION: mapped_csv.cpp
+ * DESCRIPTION: Memory-mapped file view and in-place CSV field parsing
+ * ======================================================================================
+ */
+
+#include "../include/mapped_csv.h"
+#include <cstdio>
+#include <cstring>
+#include <climits>
+#include <thread>
+#include <algorithm>
+
+#ifndef _WIN32
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+// ======================================================================================
+//                                   MAPPED FILE
+// ======================================================================================
+
+/**
+ * Function: open
+ * Maps the whole file read-only (the mapping stays valid after the
+ * descriptor is closed)
+ *
+ * Returns: false if the file cannot be opened or mapped
+ */
+bool MappedFile::open(const std::string& path) {
+    return openRange(path, 0, (size_t)-1);
+}
+
+/**
+ * Function: openRange
+ * Maps bytes [offset, offset + length) of the file read-only; a length
+ * running past the end of the file is cut to the file size
+ *
+ * Returns: false if the file cannot be opened or mapped, or offset is
+ *          past the end of the file
+ */
+bool MappedFile::openRange(const std::string& path, size_t offset, size_t length) {
+    close();
+#ifdef _WIN32
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file) return false;
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    if (size < 0 || offset > (size_t)size) {
+        fclose(file);
+        return false;
+    }
+    length = std::min(length, (size_t)size - offset);
+    fseek(file, (long)offset, SEEK_SET);
+    buffer.resize(length);
+    size_t got = buffer.empty() ? 0 : fread(buffer.data(), 1, buffer.size(), file);
+    fclose(file);
+    buffer.resize(got);
+    data = buffer.empty() ? "" : buffer.data();
+    this->length = got;
+    return true;
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || offset > (size_t)st.st_size) {
+        ::close(fd);
+        return false;
+    }
+    length = std::min(length, (size_t)st.st_size - offset);
+    if (length == 0) {
+        ::close(fd);
+        data = "";
+        return true;
+    }
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    size_t start = offset - offset % page;
+    size_t span = length + (offset - start);
+    void* mapping = mmap(NULL, span, PROT_READ, MAP_PRIVATE, fd, (off_t)start);
+    ::close(fd);
+    if (mapping == MAP_FAILED) return false;
+    madvise(mapping, span, MADV_SEQUENTIAL);
+    mapBase = mapping;
+    mapLength = span;
+    data = (const char*)mapping + (offset - start);
+    this->length = length;
+    return true;
+#endif
+}
+
+void MappedFile::close() {
+#ifdef _WIN32
+    std::vector<char>().swap(buffer);
+#else
+    if (mapBase) munmap(mapBase, mapLength);
+#endif
+    data = NULL;
+    length = 0;
+    mapBase = NULL;
+    mapLength = 0;
+}
+
+// ======================================================================================
+//                                   CSV CURSOR
+// ======================================================================================
+
+CsvCursor::CsvCursor(const char* begin, const char* end) : pos(begin), stop(end) {
+    if (stop - pos >= 3 && memcmp(pos, "\xEF\xBB\xBF", 3) == 0) pos += 3;
+    findLineEnd();
+}
+
+void CsvCursor::findLineEnd() {
+    lineEnd = (pos < stop) ? (const char*)memchr(pos, '\n', stop - pos) : NULL;
+    if (lineEnd == NULL) lineEnd = stop;
+}
+
+size_t CsvCursor::countLines() const {
+    size_t lines = 0;
+    const char* p = pos;
+    while (p < stop) {
+        const char* nl = (const char*)memchr(p, '\n', stop - p);
+        lines++;
+        if (nl == NULL) break;
+        p = nl + 1;
+    }
+    return lines;
+}
+
+// Consumes the ',' after a field (a line end is left for endRow)
+void CsvCursor::finishField() {
+    if (pos < lineEnd && *pos == ',') pos++;
+}
+
+/**
+ * Parses an integer field in [minValue, maxValue]; the cursor only moves
+ * on success, so an out-of-range value fails like any malformed field
+ */
+bool CsvCursor::readInteger(long long minValue, long long maxValue, long long& out) {
+    const char* p = pos;
+    bool negative = (p < lineEnd && *p == '-');
+    if (negative) p++;
+    if (p == lineEnd || *p < '0' || *p > '9') return false;
+    unsigned long long limit = negative ? 0ULL - (unsigned long long)minValue : (unsigned long long)maxValue;
+    unsigned long long v = 0;
+    while (p < lineEnd && *p >= '0' && *p <= '9') {
+        unsigned digit = (unsigned)(*p++ - '0');
+        if (v > (limit - digit) / 10) return false;     // Out of range
+        v = v * 10 + digit;
+    }
+    if (!endOfField(p)) return false;   // e.g. "12abc"
+    out = negative ? (long long)(0ULL - v) : (long long)v;
+    pos = p;
+    finishField();
+    return true;
+}
+
+bool CsvCursor::readLong(long long& out) {
+    return readInteger(LLONG_MIN, LLONG_MAX, out);
+}
+
+bool CsvCursor::readInt(int& out) {
+    long long v;
+    if (!readInteger(INT_MIN, INT_MAX, v)) return false;
+    out = (int)v;
+    return true;
+}
+
+bool CsvCursor::readString(std::string& out) {
+    if (pos < lineEnd && *pos == '"') {
+        // Quoted: copy runs between quotes; "" is an escaped quote
+        out.clear();
+        const char* p = pos + 1;
+        while (true) {
+            const char* quote = (const char*)memchr(p, '"', stop - p);
+            if (quote == NULL) return false;    // Unterminated
+            out.append(p, quote - p);
+            if (quote + 1 < stop && quote[1] == '"') {
+                out += '"';
+                p = quote + 2;
+                continue;
+            }
+            p = quote + 1;
+            break;
+        }
+        pos = p;
+        if (lineEnd < pos) findLineEnd();       // Field spanned lines
+        if (!endOfField(pos)) return false;
+        finishField();
+        return true;
+    }
+
+    const char* comma = (pos < lineEnd) ? (const char*)memchr(pos, ',', lineEnd - pos) : NULL;
+    const char* fieldEnd = comma ? comma : lineEnd;
+    const char* textEnd = fieldEnd;
+    if (textEnd > pos && textEnd[-1] == '\r') textEnd--;
+    out.assign(pos, textEnd - pos);
+    pos = fieldEnd;
+    finishField();
+    return true;
+}
+
+/**
+ * Function: endRow
+ * Moves to the start of the next line
+ * Returns: true if only a line ending ('\r\n' / '\n' / end of file) was left
+ */
+bool CsvCursor::endRow() {
+    bool clean = (pos == lineEnd) || (pos + 1 == lineEnd && *pos == '\r');
+    pos = (lineEnd < stop) ? lineEnd + 1 : stop;
+    findLineEnd();
+    return clean;
+}
+
+// ======================================================================================
+//                                   ROW SPLITTING
+// ======================================================================================
+
+namespace {
+
+size_t countQuotes(const char* p, const char* end) {
+    size_t quotes = 0;
+    while (p < end) {
+        p = (const char*)memchr(p, '"', end - p);
+        if (p == NULL) break;
+        quotes++;
+        p++;
+    }
+    return quotes;
+}
+
+// First row start at or after p, given whether p lies inside a quoted field
+const char* nextRowStart(const char* p, const char* end, bool inQuotes) {
+    for (; p < end; p++) {
+        if (*p == '"') inQuotes = !inQuotes;
+        else if (*p == '\n' && !inQuotes) return p + 1;
+    }
+    return end;
+}
+
+} // namespace
+
+std::vector<const char*> splitCsvRows(const char* begin, const char* end, int parts) {
+    std::vector<const char*> edges(1, begin);
+    if (parts < 1) parts = 1;
+    size_t step = (end - begin) / parts;
+    if (parts == 1 || step == 0) {
+        if (end > begin) edges.push_back(end);
+        return edges;
+    }
+
+    // Pass 1 (parallel): quotes per fixed byte range
+    std::vector<size_t> quotes(parts, 0);
+    std::vector<std::thread> workers;
+    for (int i = 0; i < parts; i++) {
+        const char* from = begin + i * step;
+        const char* to = (i == parts - 1) ? end : from + step;
+        workers.push_back(std::thread([&quotes, i, from, to]() {
+            quotes[i] = countQuotes(from, to);
+        }));
+    }
+    for (auto& w : workers) w.join();
+
+    // Pass 2: move each split point forward to the next real row start
+    size_t before = quotes[0];
+    for (int i = 1; i < parts; i++) {
+        const char* edge = nextRowStart(begin + i * step, end, (before & 1) != 0);
+        if (edge > edges.back() && edge < end) edges.push_back(edge);
+        before += quotes[i];
+    }
+    edges.push_back(end);
+    return edges;
+}
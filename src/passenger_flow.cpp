@@ -0,0 +1,128 @@
+/**
+ * ======================================================================================
+ * IMPLEMENTATION: passenger_flow.cpp
+ * DESCRIPTION: Sharded, time-bucketed passenger flow counters
+ * ======================================================================================
+ */
+
+#include "../include/passenger_flow.h"
+#include <cstring>
+
+PassengerFlowCounters passengerFlow;
+
+namespace {
+
+/**
+ * Local day boundaries of the calling thread's last lookup, so a bucket is a
+ * subtraction except on the first record of a day (localtime is not
+ * thread-safe, hence the _r/_s variants here)
+ */
+struct FlowDayCache {
+    time_t dayStart;
+    bool valid;
+};
+
+thread_local FlowDayCache dayCache = { 0, false };
+
+} // namespace
+
+int flowBucketOf(time_t t) {
+    if (!dayCache.valid || t < dayCache.dayStart || t >= dayCache.dayStart + 86400) {
+        tm local;
+#ifdef _WIN32
+        localtime_s(&local, &t);
+#else
+        localtime_r(&t, &local);
+#endif
+        dayCache.dayStart = t - (local.tm_hour * 3600 + local.tm_min * 60 + local.tm_sec);
+        dayCache.valid = true;
+    }
+    int bucket = (int)((t - dayCache.dayStart) / 60) / FLOW_BUCKET_MINUTES;
+    return bucket < FLOW_BUCKETS ? bucket : FLOW_BUCKETS - 1;    // 25-hour DST day
+}
+
+// ======================================================================================
+//                                   RECORDING
+// ======================================================================================
+
+PassengerFlowCounters::PassengerFlowCounters() : nextShard(0) {
+    reset();
+}
+
+PassengerFlowCounters::Shard& PassengerFlowCounters::localShard() {
+    thread_local int shard = -1;
+    if (shard < 0) shard = (int)(nextShard.fetch_add(1, std::memory_order_relaxed) % FLOW_SHARDS);
+    return shards[shard];
+}
+
+/**
+ * Function: record
+ * One relaxed fetch_add on the calling thread's shard
+ * Time Complexity: O(1)
+ */
+void PassengerFlowCounters::record(int stationId, FlowDirection direction, time_t when,
+                                   uint32_t passengers) {
+    recordBucket(stationId, direction, flowBucketOf(when), passengers);
+}
+
+void PassengerFlowCounters::recordBucket(int stationId, FlowDirection direction, int bucket,
+                                         uint32_t passengers) {
+    if (stationId < 0 || stationId >= MAX_STATIONS || bucket < 0 || bucket >= FLOW_BUCKETS) return;
+    size_t index = ((size_t)stationId * FLOW_DIRECTIONS + direction) * FLOW_BUCKETS + bucket;
+    localShard().count[index].fetch_add(passengers, std::memory_order_relaxed);
+}
+
+// ======================================================================================
+//                                   READING
+// ======================================================================================
+
+/**
+ * Function: summarize
+ * Sums every shard into per-station and per-bucket totals
+ * Time Complexity: O(FLOW_SHARDS x stations x FLOW_BUCKETS)
+ */
+PassengerFlowSummary PassengerFlowCounters::summarize(size_t stationCount) const {
+    PassengerFlowSummary summary;
+    if (stationCount > (size_t)MAX_STATIONS) stationCount = MAX_STATIONS;
+    memset(summary.bucket, 0, sizeof(summary.bucket));
+    for (int d = 0; d < FLOW_DIRECTIONS; d++) {
+        summary.station[d].assign(stationCount, 0);
+        summary.total[d] = 0;
+    }
+
+    for (const Shard& shard : shards) {
+        const std::atomic<uint32_t>* count = shard.count;
+        for (size_t s = 0; s < stationCount; s++) {
+            for (int d = 0; d < FLOW_DIRECTIONS; d++) {
+                uint64_t stationSum = 0;
+                for (int b = 0; b < FLOW_BUCKETS; b++) {
+                    uint32_t n = count[b].load(std::memory_order_relaxed);
+                    stationSum += n;
+                    summary.bucket[d][b] += n;
+                }
+                summary.station[d][s] += stationSum;
+                summary.total[d] += stationSum;
+                count += FLOW_BUCKETS;
+            }
+        }
+    }
+    return summary;
+}
+
+void PassengerFlowCounters::reset() {
+    for (Shard& shard : shards) {
+        for (auto& counter : shard.count) counter.store(0, std::memory_order_relaxed);
+    }
+}
+
+int PassengerFlowSummary::busiestBucket() const {
+    int best = -1;
+    uint64_t bestCount = 0;
+    for (int b = 0; b < FLOW_BUCKETS; b++) {
+        if (bucketTotal(b) > bestCount) {
+            bestCount = bucketTotal(b);
+            best = b;
+        }
+    }
+    return best;
+}
@@ -2,6 +2,7 @@
  * ======================================================================================
  * IMPLEMENTATION: queue_manager.cpp
  * DESCRIPTION: Implementation of PlatformQueue (Circular Queue for Load Balancing)
+ *              and the timing of the custom structures against linked nodes
  * 
  * DATA STRUCTURE: Circular Queue
  * - Fixed-size array-based implementation
@@ -13,6 +14,8 @@
 
 #include "../include/queue_manager.h"
 #include <iostream>
+#include <iomanip>
+#include <chrono>
 
 // ======================================================================================
 //                                   PLATFORM QUEUE IMPLEMENTATION
@@ -121,3 +124,187 @@ int PlatformQueue::dequeue() {
     size--;
     return item;
 }
+
+// ======================================================================================
+//                                   STRUCTURE TIMING
+// ======================================================================================
+
+namespace {
+
+/**
+ * The linked-node structures MyStack / MyQueue / MyList were before they
+ * moved onto arrays and a node pool: a new/delete per element. Kept only
+ * as the baseline for showStructureTiming.
+ */
+template <typename T>
+class LinkedStack {
+    MyNode<T>* topNode;
+
+public:
+    LinkedStack() : topNode(NULL) {}
+    ~LinkedStack() { while (topNode) pop(); }
+
+    void push(T val) {
+        MyNode<T>* newNode = new MyNode<T>(val);
+        newNode->next = topNode;
+        topNode = newNode;
+    }
+    void pop() {
+        MyNode<T>* temp = topNode;
+        topNode = topNode->next;
+        delete temp;
+    }
+    T top() { return topNode->data; }
+    bool empty() { return topNode == NULL; }
+};
+
+template <typename T>
+class LinkedQueue {
+    MyNode<T>* frontNode;
+    MyNode<T>* rearNode;
+
+public:
+    LinkedQueue() : frontNode(NULL), rearNode(NULL) {}
+    ~LinkedQueue() { while (frontNode) pop(); }
+
+    void push(T val) {
+        MyNode<T>* newNode = new MyNode<T>(val);
+        if (rearNode == NULL) frontNode = rearNode = newNode;
+        else rearNode = rearNode->next = newNode;
+    }
+    void pop() {
+        MyNode<T>* temp = frontNode;
+        frontNode = frontNode->next;
+        if (frontNode == NULL) rearNode = NULL;
+        delete temp;
+    }
+    T front() { return frontNode->data; }
+    bool empty() { return frontNode == NULL; }
+};
+
+template <typename T>
+class LinkedList {
+public:
+    MyNode<T>* head;
+    MyNode<T>* tail;
+
+    LinkedList() : head(NULL), tail(NULL) {}
+    ~LinkedList() { clear(); }
+
+    void push_back(T val) {
+        MyNode<T>* newNode = new MyNode<T>(val);
+        if (!head) {
+            head = tail = newNode;
+        } else {
+            tail->next = newNode;
+            newNode->prev = tail;
+            tail = newNode;
+        }
+    }
+    void pop_front() {
+        MyNode<T>* temp = head;
+        head = head->next;
+        if (head) head->prev = NULL;
+        else tail = NULL;
+        delete temp;
+    }
+    void clear() { while (head) pop_front(); }
+};
+
+// Order-sensitive checksum of everything popped, so both sides must agree
+struct TimingRun {
+    double ms;
+    unsigned long long checksum;
+};
+
+inline void mix(unsigned long long& sum, int value) {
+    sum = sum * 1000003ULL + (unsigned)value;
+}
+
+// BFS pattern: waves of 'wave' pushes, each drained before the next
+template <typename Queue>
+TimingRun timeQueue(int operations, int wave) {
+    TimingRun run = {0, 0};
+    auto start = std::chrono::steady_clock::now();
+    Queue q;
+    for (int done = 0; done < operations; done += wave) {
+        for (int i = 0; i < wave; i++) q.push(done + i);
+        while (!q.empty()) {
+            mix(run.checksum, q.front());
+            q.pop();
+        }
+    }
+    run.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return run;
+}
+
+// DFS path pattern: grow to a depth, then unwind
+template <typename Stack>
+TimingRun timeStack(int operations, int depth) {
+    TimingRun run = {0, 0};
+    auto start = std::chrono::steady_clock::now();
+    Stack s;
+    for (int done = 0; done < operations; done += depth) {
+        for (int i = 0; i < depth; i++) s.push(done + i);
+        while (!s.empty()) {
+            mix(run.checksum, s.top());
+            s.pop();
+        }
+    }
+    run.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return run;
+}
+
+// Station train list pattern: append a day's trains, walk them, clear
+template <typename List>
+TimingRun timeList(int operations, int trains) {
+    TimingRun run = {0, 0};
+    auto start = std::chrono::steady_clock::now();
+    List list;
+    for (int done = 0; done < operations; done += trains) {
+        for (int i = 0; i < trains; i++) list.push_back(done + i);
+        for (MyNode<int>* node = list.head; node; node = node->next) mix(run.checksum, node->data);
+        list.clear();
+    }
+    run.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return run;
+}
+
+void printTimingRow(const char* name, const TimingRun& linked, const TimingRun& array) {
+    std::cout << std::left << std::setw(26) << name
+              << std::setw(14) << std::fixed << std::setprecision(1) << linked.ms
+              << std::setw(14) << array.ms
+              << std::setw(10) << std::setprecision(2) << (array.ms > 0 ? linked.ms / array.ms : 0)
+              << (linked.checksum == array.checksum ? "same order" : "MISMATCH") << "\n";
+}
+
+} // namespace
+
+/**
+ * Function: showStructureTiming
+ * Each structure runs the pattern it serves in the app, 'operations'
+ * elements through it, linked baseline first
+ */
+void showStructureTiming(int operations) {
+    std::streamsize oldPrecision = std::cout.precision();
+
+    std::cout << "\n========== Custom Structures: Array / Pool vs Linked Nodes ==========\n";
+    std::cout << "Elements per structure: " << operations << "\n\n";
+    std::cout << std::left << std::setw(26) << "Structure"
+              << std::setw(14) << "Linked (ms)"
+              << std::setw(14) << "Now (ms)"
+              << std::setw(10) << "Speedup"
+              << "Result\n";
+    std::cout << "----------------------------------------------------------------------\n";
+
+    TimingRun linked = timeQueue<LinkedQueue<int> >(operations, 4096);
+    printTimingRow("MyQueue (BFS waves)", linked, timeQueue<MyQueue<int> >(operations, 4096));
+    linked = timeStack<LinkedStack<int> >(operations, 64);
+    printTimingRow("MyStack (DFS paths)", linked, timeStack<MyStack<int> >(operations, 64));
+    linked = timeList<LinkedList<int> >(operations, 256);
+    printTimingRow("MyList (station trains)", linked, timeList<MyList<int> >(operations, 256));
+
+    std::cout << "----------------------------------------------------------------------\n";
+    std::cout.unsetf(std::ios::fixed);
+    std::cout.precision(oldPrecision);
+}
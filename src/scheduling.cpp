@@ -11,16 +11,24 @@
  * 
  * KEY FEATURES:
  * - Priority-based scheduling (earliest arrival time = highest priority)
- * - Peak hour frequency optimization
+ * - Demand-driven frequency optimization (batched insertion)
  * - Real-time schedule display with time formatting
  * - Train status tracking (ON_TIME, DELAYED, CANCELLED)
  * ======================================================================================
  */
 
 #include "../include/scheduling.h"
+#include "../include/globals.h"
 #include <iostream>
 #include <iomanip>
 #include <cstdio>
+#include <queue>
+#include <algorithm>
+
+const int Scheduler::MIN_TRANSFER_TIME;
+const int Scheduler::MAX_CONNECTION_HOLD;
+
+StringTable trainNames;
 
 // ======================================================================================
 //                                   SCHEDULER IMPLEMENTATION
@@ -38,8 +46,9 @@
  * 
  * Algorithm:
  *   1. Create Train object with provided details
- *   2. Set default values (capacity=2000, currentLoad=0, status=ON_TIME)
- *   3. Push to MinHeap (automatically maintains sorted order by arrivalTime)
+ *   2. Set default values (currentLoad=0, status=ON_TIME)
+ *   3. Intern the name and record capacity=2000 in the cold metadata table
+ *   4. Push to MinHeap (automatically maintains sorted order by arrivalTime)
  * 
  * Time Complexity: O(log n) due to MinHeap::push() and heapifyUp()
  * 
@@ -50,16 +59,46 @@
 void Scheduler::scheduleTrain(int id, std::string name, int time, int startStationId) {
     Train t;
     t.trainId = id;
-    t.name = name;
     t.arrivalTime = time;  // Minutes from midnight
     t.nextStationId = startStationId;
     t.status = ON_TIME;
-    t.capacity = 2000;     // Standard Mumbai Local capacity
     t.currentLoad = 0;
     
+    TrainInfo info = { trainNames.intern(name), DEFAULT_TRAIN_CAPACITY };
+    trainInfo[id] = info;
     trainSchedule.push(t);  // MinHeap automatically sorts by arrivalTime
 }
 
+/**
+ * Function: scheduleTrains
+ * Bulk-loads a batch of trains (timetable files, service expansion, optimizer)
+ * 
+ * Algorithm:
+ *   1. Record each train's cold metadata
+ *   2. Append the hot records and rebuild the heap once (Floyd, O(n))
+ * 
+ * Time Complexity: O(n + k) for k new trains
+ */
+void Scheduler::scheduleTrains(TrainBatch&& batch) {
+    trainInfo.reserve(trainInfo.size() + batch.size());
+    for (size_t i = 0; i < batch.trains.size(); i++) {
+        trainInfo[batch.trains[i].trainId] = batch.info[i];
+    }
+    trainSchedule.pushBatch(std::move(batch.trains));
+    batch.info.clear();
+}
+
+const TrainInfo* Scheduler::getTrainInfo(int trainId) const {
+    auto it = trainInfo.find(trainId);
+    return (it == trainInfo.end()) ? NULL : &it->second;
+}
+
+const std::string& Scheduler::getTrainName(int trainId) const {
+    static const std::string unknown = "Unknown";
+    const TrainInfo* info = getTrainInfo(trainId);
+    return info ? trainNames.get(info->nameId) : unknown;
+}
+
 /**
  * Function: showUpcomingTrains
  * Displays all scheduled trains in chronological order using Custom MinHeap
@@ -98,7 +137,7 @@ void Scheduler::showUpcomingTrains() {
     }
 
     // Create a copy to display without removing from original schedule
-    MinHeap<Train> temp = trainSchedule;
+    IndexedMinHeap<Train> temp = trainSchedule;
     
     // Table header
     std::cout << std::left 
@@ -132,7 +171,7 @@ void Scheduler::showUpcomingTrains() {
         // Display train information in tabular format
         std::cout << std::left 
                   << std::setw(10) << timeStr 
-                  << std::setw(22) << t.name 
+                  << std::setw(22) << getTrainName(t.trainId).substr(0, 21)
                   << std::setw(12) << statusStr
                   << std::setw(10) << t.trainId << std::endl;
         count++;
@@ -163,7 +202,7 @@ void Scheduler::showUpcomingTrains() {
  */
 void Scheduler::showTrainsAtStation(int stationId) {
     // Create a temporary copy to avoid destroying original schedule
-    MinHeap<Train> temp = trainSchedule;
+    IndexedMinHeap<Train> temp = trainSchedule;
     
     std::cout << "\n========== Trains Arriving at Station ==========\n";
     std::cout << std::left 
@@ -206,7 +245,7 @@ void Scheduler::showTrainsAtStation(int stationId) {
         // Display train information
         std::cout << std::left 
                   << std::setw(10) << timeStr 
-                  << std::setw(22) << t.name 
+                  << std::setw(22) << getTrainName(t.trainId).substr(0, 21)
                   << std::setw(12) << statusStr
                   << std::setw(10) << t.trainId << std::endl;
         count++;
@@ -219,63 +258,357 @@ void Scheduler::showTrainsAtStation(int stationId) {
 
 /**
  * Function: optimizeFrequency
- * Dynamically adjusts train frequency based on peak/off-peak hours
+ * Inserts the extra trains produced by the HeadwayOptimizer in one batch
  * 
  * Parameters:
- *   isPeakHour - Boolean indicating peak hour status
+ *   extraTrains - Demand-driven specials (see headway_optimizer.h); moved
+ *                 into the heap, left empty
  * 
- * Peak Hour Strategy:
- *   - Detects rush hours (morning: 8-11 AM, evening: 5-9 PM)
- *   - Schedules additional "Special" trains
- *   - Reduces headway (time between trains) from 15 min to 10 min
- *   - Increases overall capacity by 30-40%
+ * Algorithm:
+ *   1. Append every train to the heap array
+ *   2. Re-establish heap order bottom-up (Floyd's build-heap)
  * 
- * Off-Peak Strategy:
- *   - Maintains standard frequency (every 15-20 minutes)
- *   - Optimizes for energy efficiency
- *   - Balances service with operational costs
+ * Time Complexity: O(n + k) where k = trains added, n = current trains
+ *   (vs. O(k log n) for k individual scheduleTrain() calls)
+ */
+void Scheduler::optimizeFrequency(TrainBatch&& extraTrains) {
+    scheduleTrains(std::move(extraTrains));
+}
+
+// ======================================================================================
+//                                   DELAY PROPAGATION
+// ======================================================================================
+
+// Copies a shared route into the run (times resolved) so it can be changed
+void Scheduler::TrainRun::makeOwn() {
+    if (!route) return;
+    own = *route;
+    for (auto& stop : own) stop.arrivalTime += offset;
+    route.reset();
+    offset = 0;
+}
+
+/**
+ * Function: setItinerary
+ * Attaches an ordered list of stops to a train and indexes them by station
  * 
- * Algorithm:
- *   1. Check current hour classification
- *   2. If peak hour, add special fast trains at 10-minute intervals
- *   3. Use scheduleTrain() to add to MinHeap
- *   4. Display optimization message
+ * Parameters:
+ *   trainId - Train the itinerary belongs to
+ *   stops - Stops in travel order with planned arrival times
+ * 
+ * Time Complexity: O(k) where k = number of stops
+ */
+void Scheduler::setItinerary(int trainId, const std::vector<TrainStop>& stops) {
+    TrainRun run;
+    run.offset = 0;
+    run.own = stops;
+    attachRun(trainId, std::move(run));
+}
+
+/**
+ * Function: setItinerary (shared)
+ * Same, but the train only keeps a reference to 'route' and its offset:
+ * stop i arrives at route[i].arrivalTime + offset. Trains built from one
+ * stop pattern (same start station and line) share a single stop list.
+ */
+void Scheduler::setItinerary(int trainId, const SharedRoute& route, int offset) {
+    if (!route) return;
+    TrainRun run;
+    run.route = route;
+    run.offset = offset;
+    attachRun(trainId, std::move(run));
+}
+
+void Scheduler::attachRun(int trainId, TrainRun&& run) {
+    auto existing = runs.find(trainId);
+    if (existing != runs.end()) {
+        // Drop the old station index entries for this train
+        for (int i = 0; i < existing->second.size(); i++) {
+            std::vector<StopRef>& refs = stationStops[existing->second.station(i)];
+            refs.erase(std::remove_if(refs.begin(), refs.end(),
+                           [&](const StopRef& r) { return r.trainId == trainId; }),
+                       refs.end());
+        }
+    }
+    
+    TrainRun& stored = runs[trainId];
+    stored = std::move(run);
+    for (int i = 0; i < stored.size(); i++) {
+        StopRef ref = { trainId, i };
+        stationStops[stored.station(i)].push_back(ref);
+    }
+    refreshHeapEntry(trainId, false);
+}
+
+/**
+ * Function: appendItinerary
+ * Appends the train's stops, with arrival times resolved, to 'out'
+ * Returns: false if the train has no itinerary
+ */
+bool Scheduler::appendItinerary(int trainId, std::vector<TrainStop>& out) const {
+    auto it = runs.find(trainId);
+    if (it == runs.end()) return false;
+    const TrainRun& run = it->second;
+    for (int i = 0; i < run.size(); i++) {
+        TrainStop stop = { run.station(i), run.arrival(i) };
+        out.push_back(stop);
+    }
+    return true;
+}
+
+/**
+ * Function: getStationCalls
+ * Lists every itinerary call at a station as (arrivalTime, trainId)
+ * Time Complexity: O(c) where c = calls at that station
+ */
+std::vector<std::pair<int, int>> Scheduler::getStationCalls(int stationId) const {
+    std::vector<std::pair<int, int>> calls;
+    auto refs = stationStops.find(stationId);
+    if (refs == stationStops.end()) return calls;
+    
+    calls.reserve(refs->second.size());
+    for (const auto& ref : refs->second) {
+        const TrainRun& run = runs.at(ref.trainId);
+        calls.push_back({run.arrival(ref.stopIndex), ref.trainId});
+    }
+    return calls;
+}
+
+/**
+ * Function: getServedStations
+ * Returns IDs of all stations that at least one itinerary calls at
+ */
+std::vector<int> Scheduler::getServedStations() const {
+    std::vector<int> stations;
+    for (const auto& entry : stationStops) {
+        if (!entry.second.empty()) stations.push_back(entry.first);
+    }
+    std::sort(stations.begin(), stations.end());
+    return stations;
+}
+
+/**
+ * Function: refreshHeapEntry
+ * Re-keys a train's heap entry from its itinerary (first stop + arrival time).
+ * The scheduler has no running clock, so no stop is ever marked as passed.
  * 
- * Time Complexity: O(k log n) where k = number of trains added, n = current trains
+ * Parameters:
+ *   trainId - Train to refresh
+ *   markDelayed - Set status to DELAYED (a later stop may have moved even if
+ *                 the next one did not)
+ * 
+ * Time Complexity: O(log n)
+ */
+void Scheduler::refreshHeapEntry(int trainId, bool markDelayed) {
+    const Train* current = trainSchedule.find(trainId);
+    auto it = runs.find(trainId);
+    if (current == NULL || it == runs.end() || it->second.size() == 0) return;
+    
+    Train t = *current;
+    t.arrivalTime = it->second.arrival(0);
+    t.nextStationId = it->second.station(0);
+    if (markDelayed && t.status == ON_TIME) t.status = DELAYED;
+    
+    if (t.arrivalTime == current->arrivalTime && t.nextStationId == current->nextStationId &&
+        t.status == current->status) return;
+    trainSchedule.update(t);
+}
+
+/**
+ * Function: propagate
+ * Pushes one delay through the itinerary graph (train stops + interchange connections)
  * 
- * Real-world use:
- *   - Mumbai Local handles 7.5 million passengers daily
- *   - Peak hours see 4-5x normal passenger load
- *   - Dynamic scheduling reduces overcrowding
+ * Algorithm (earliest-first worklist, times only ever increase so it terminates):
+ *   1. Shift the delayed stop and every later stop of the same train
+ *   2. At each shifted interchange stop, find the first departure of every other
+ *      service the train used to connect with (old arrival + transfer <= time):
+ *      - If that connection no longer works, hold the train (enqueue its stop
+ *        with the new time); later departures of the service are the fallback
+ *      - Holds longer than MAX_CONNECTION_HOLD are reported as broken instead
+ *   3. Record every touched train; heap entries are fixed by the caller
  * 
- * Example Peak Hours:
- *   Morning: 0800 - 1100 (Office commute)
- *   Evening: 1700 - 2100 (Return commute)
+ * Time Complexity: O(S + C) where S = stops shifted, C = stops scanned at the
+ *   interchanges those stops visit - untouched trains are never visited
  */
-void Scheduler::optimizeFrequency(bool isPeakHour) {
-    if (isPeakHour) {
-        std::cout << "\n========================================\n";
-        std::cout << "   PEAK HOUR OPTIMIZATION ACTIVATED\n";
-        std::cout << "========================================\n";
-        std::cout << "Status: HIGH DEMAND DETECTED\n";
-        std::cout << "Action: Increasing train frequency...\n\n";
+void Scheduler::propagate(const DelayEvent& event, DelayReport& report, std::vector<int>& touched) {
+    struct Work {
+        int trainId;
+        int stopIndex;
+        int newTime;
+        bool held;      // Caused by holding a connection
+        // Ties broken by stop so the outcome never depends on push order
+        bool operator>(const Work& other) const {
+            if (newTime != other.newTime) return newTime > other.newTime;
+            if (trainId != other.trainId) return trainId > other.trainId;
+            return stopIndex > other.stopIndex;
+        }
+    };
+    // Earliest-first, so a train is usually shifted by its final delay the first time
+    std::priority_queue<Work, std::vector<Work>, std::greater<Work>> work;
+    
+    auto runIt = runs.find(event.trainId);
+    if (runIt == runs.end() || event.delayMinutes <= 0) {
+        // No itinerary: only the heap entry at its next station can move
+        const Train* t = trainSchedule.find(event.trainId);
+        if (t != NULL && t->nextStationId == event.stationId && event.delayMinutes > 0) {
+            Train delayed = *t;
+            delayed.arrivalTime += event.delayMinutes;
+            delayed.status = DELAYED;
+            trainSchedule.update(delayed);
+            report.stopsUpdated++;
+            report.stationsAffected.push_back(event.stationId);
+            touched.push_back(event.trainId);
+        }
+        return;
+    }
+    
+    const TrainRun& itinerary = runIt->second;
+    for (int i = 0; i < itinerary.size(); i++) {
+        if (itinerary.station(i) == event.stationId) {
+            Work w = { event.trainId, i, itinerary.arrival(i) + event.delayMinutes, false };
+            work.push(w);
+            break;
+        }
+    }
+    
+    // First connection of each service at the interchange being scanned, indexed
+    // by nameId; 'services' lists the filled slots so each stop clears only those
+    const StopRef none = { -1, -1 };
+    std::vector<StopRef> firstConnection(trainNames.size(), none);
+    std::vector<uint32_t> services;
+    
+    while (!work.empty()) {
+        Work w = work.top();
+        work.pop();
         
-        // Add special peak-hour trains with shorter intervals
-        scheduleTrain(901, "Peak Special 1", 540, 0);   // 09:00 AM
-        scheduleTrain(902, "Peak Special 2", 550, 0);   // 09:10 AM
-        scheduleTrain(903, "Peak Special 3", 560, 0);   // 09:20 AM
+        TrainRun& run = runs[w.trainId];
+        int delta = w.newTime - run.arrival(w.stopIndex);
+        if (delta <= 0) continue;  // Already at least this late
+        touched.push_back(w.trainId);
+        if (w.held) report.connectionsHeld++;
+        run.makeOwn();     // Other trains may share the route
         
-        std::cout << "✓ Added 3 peak-hour special trains\n";
-        std::cout << "✓ Reduced headway: 15 min → 10 min\n";
-        std::cout << "✓ Increased capacity by ~35%\n";
-        std::cout << "========================================\n";
-    } else {
-        std::cout << "\n========================================\n";
-        std::cout << "   STANDARD FREQUENCY MODE\n";
-        std::cout << "========================================\n";
-        std::cout << "Status: OFF-PEAK HOURS\n";
-        std::cout << "Action: Maintaining standard schedule\n";
-        std::cout << "Headway: 15-20 minutes\n";
-        std::cout << "========================================\n";
+        for (int j = w.stopIndex; j < (int)run.own.size(); j++) {
+            int oldTime = run.own[j].arrivalTime;
+            int newTime = oldTime + delta;
+            run.own[j].arrivalTime = newTime;
+            report.stopsUpdated++;
+            
+            int s = run.own[j].stationId;
+            report.stationsAffected.push_back(s);
+            if (s < 0 || s >= (int)allStations.size() || !allStations[s].isInterchange) continue;
+            
+            auto refs = stationStops.find(s);
+            if (refs == stationStops.end()) continue;
+            // Passengers only need the first departure of each service they could
+            // originally make - later departures of that service are their fallback
+            for (const auto& ref : refs->second) {
+                if (ref.trainId == w.trainId) continue;
+                const TrainRun& other = runs[ref.trainId];
+                
+                int departs = other.arrival(ref.stopIndex);
+                if (oldTime + MIN_TRANSFER_TIME > departs) continue;  // Never a connection
+                const TrainInfo* info = getTrainInfo(ref.trainId);
+                if (info == NULL || !trainSchedule.contains(ref.trainId)) continue;
+                
+                if (info->nameId >= firstConnection.size()) firstConnection.resize(info->nameId + 1, none);
+                StopRef& slot = firstConnection[info->nameId];
+                if (slot.stopIndex < 0) {
+                    slot = ref;
+                    services.push_back(info->nameId);
+                } else if (departs < runs[slot.trainId].arrival(slot.stopIndex)) {
+                    slot = ref;
+                }
+            }
+            
+            for (uint32_t nameId : services) {
+                StopRef ref = firstConnection[nameId];
+                firstConnection[nameId] = none;
+                int departs = runs[ref.trainId].arrival(ref.stopIndex);
+                if (newTime + MIN_TRANSFER_TIME <= departs) continue;  // Still makes it
+                
+                int hold = newTime + MIN_TRANSFER_TIME - departs;
+                if (hold <= MAX_CONNECTION_HOLD) {
+                    Work held = { ref.trainId, ref.stopIndex, departs + hold, true };
+                    work.push(held);
+                } else {
+                    report.connectionsBroken++;
+                }
+            }
+            services.clear();
+        }
+    }
+}
+
+/**
+ * Function: applyDelay
+ * Reports a single delay and propagates it (see applyDelays)
+ */
+DelayReport Scheduler::applyDelay(int trainId, int stationId, int delayMinutes) {
+    DelayEvent e = { trainId, stationId, delayMinutes };
+    return applyDelays(std::vector<DelayEvent>(1, e));
+}
+
+/**
+ * Function: applyDelays
+ * Propagates a batch of delay events and re-keys the heap once per affected train
+ * 
+ * Parameters:
+ *   events - Delay reports (e.g. one minute of monsoon disruption feed)
+ * 
+ * Returns: DelayReport with counts of trains, stops and connections affected
+ * 
+ * Time Complexity: O(sum of propagation work + A log n), A = affected trains
+ */
+DelayReport Scheduler::applyDelays(const std::vector<DelayEvent>& events) {
+    DelayReport report;
+    report.trainsAffected = 0;
+    report.stopsUpdated = 0;
+    report.connectionsHeld = 0;
+    report.connectionsBroken = 0;
+    std::vector<int> touched;
+    
+    for (const auto& e : events) {
+        propagate(e, report, touched);
+    }
+    
+    std::vector<int>& stations = report.stationsAffected;
+    std::sort(stations.begin(), stations.end());
+    stations.erase(std::unique(stations.begin(), stations.end()), stations.end());
+    
+    std::sort(touched.begin(), touched.end());
+    touched.erase(std::unique(touched.begin(), touched.end()), touched.end());
+    for (int id : touched) {
+        refreshHeapEntry(id, true);
+    }
+    report.trainsAffected = touched.size();
+    return report;
+}
+
+/**
+ * Function: buildItinerary
+ * Creates a stop list by walking one line from the starting station
+ * 
+ * Parameters:
+ *   network - Railway network to trace
+ *   startStationId - First stop
+ *   line - Line to follow
+ *   departureTime - Time at the first stop (minutes from midnight)
+ * 
+ * Each later stop = previous stop + 1 min dwell + track travel time
+ */
+std::vector<TrainStop> buildItinerary(RailwayNetwork* network, int startStationId,
+                                      LineType line, int departureTime) {
+    std::vector<TrainStop> stops;
+    TrainStop first = { startStationId, departureTime };
+    stops.push_back(first);
+    
+    int t = departureTime;
+    std::vector<Edge> route = network->traceLineRoute(startStationId, line);
+    for (const auto& hop : route) {
+        t += 1 + hop.weight;
+        TrainStop stop = { hop.to, t };
+        stops.push_back(stop);
     }
+    return stops;
 }
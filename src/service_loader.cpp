@@ -0,0 +1,380 @@
+/**
+ * ======================================================================================
+ * IMPLEMENTATION: service_loader.cpp
+ * DESCRIPTION: Streams routes.json service definitions into the Scheduler
+ *
+ * DATA STRUCTURES:
+ * - Fixed 64 KB read buffer refilled with fread() (pull parser, no DOM)
+ * - One TrainBatch handed to the Scheduler by move (one interned name per service)
+ *
+ * KEY FEATURES:
+ * - Unknown keys and nested values are skipped without allocation
+ * - Station names resolved through the station directory while parsing
+ * - Peak / off-peak headways expanded into a full day of departures
+ * ======================================================================================
+ */
+
+#include "../include/service_loader.h"
+#include "../include/globals.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cctype>
+#include <algorithm>
+
+const std::string ServiceLoader::SERVICE_FILE = "data/routes.json";
+
+namespace {
+
+/**
+ * Minimal pull-style JSON reader over a FILE*
+ * Only the current block is in memory; values the caller does not need are
+ * skipped token by token.
+ */
+class JsonStream {
+    FILE* file;
+    char buffer[1 << 16];
+    size_t pos, len;
+    bool failed;        // A separator or closing bracket was missing
+
+    bool refill() {
+        len = fread(buffer, 1, sizeof(buffer), file);
+        pos = 0;
+        return len > 0;
+    }
+
+public:
+    explicit JsonStream(FILE* f) : file(f), pos(0), len(0), failed(false) {
+        // Skip a UTF-8 BOM if present
+        if (refill() && len >= 3 && memcmp(buffer, "\xEF\xBB\xBF", 3) == 0) pos = 3;
+    }
+
+    int peek() {
+        if (pos == len && !refill()) return EOF;
+        return (unsigned char)buffer[pos];
+    }
+
+    int get() {
+        int c = peek();
+        if (c != EOF) pos++;
+        return c;
+    }
+
+    int peekToken() {
+        int c = peek();
+        while (c == ' ' || c == '\n' || c == '\r' || c == '\t') {
+            pos++;
+            c = peek();
+        }
+        return c;
+    }
+
+    bool expect(char c) {
+        if (peekToken() != c) return false;
+        pos++;
+        return true;
+    }
+
+    bool readString(std::string& out) {
+        out.clear();
+        if (!expect('"')) return false;
+        while (true) {
+            // Copy the unescaped run straight out of the block
+            size_t start = pos;
+            while (pos < len && buffer[pos] != '"' && buffer[pos] != '\\') pos++;
+            out.append(buffer + start, pos - start);
+            if (pos == len) {
+                if (!refill()) return false;
+                continue;   // String continues in the next block
+            }
+
+            int c = get();
+            if (c == EOF) return false;
+            if (c == '"') return true;
+
+            c = get();  // Escape sequence
+            switch (c) {
+                case 'n': out += '\n'; break;
+                case 't': out += '\t'; break;
+                case 'r': out += '\r'; break;
+                case 'b': out += '\b'; break;
+                case 'f': out += '\f'; break;
+                case 'u': {
+                    unsigned code = 0;
+                    for (int i = 0; i < 4; i++) {
+                        int h = get();
+                        if (!isxdigit(h)) return false;
+                        code = code * 16 + (isdigit(h) ? h - '0' : (tolower(h) - 'a' + 10));
+                    }
+                    if (code < 0x80) {
+                        out += (char)code;
+                    } else if (code < 0x800) {
+                        out += (char)(0xC0 | (code >> 6));
+                        out += (char)(0x80 | (code & 0x3F));
+                    } else {
+                        out += (char)(0xE0 | (code >> 12));
+                        out += (char)(0x80 | ((code >> 6) & 0x3F));
+                        out += (char)(0x80 | (code & 0x3F));
+                    }
+                    break;
+                }
+                case EOF: return false;
+                default: out += (char)c; break;   // \" \\ \/
+            }
+        }
+    }
+
+    bool readNumber(double& out) {
+        char digits[64];
+        int n = 0;
+        int c = peekToken();
+        while (c != EOF && (isdigit(c) || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E')) {
+            if (n < 63) digits[n++] = (char)c;
+            pos++;
+            c = peek();
+        }
+        if (n == 0) return false;
+        digits[n] = '\0';
+        out = strtod(digits, NULL);
+        return true;
+    }
+
+    bool readInt(int& out) {
+        double value;
+        if (!readNumber(value)) return false;
+        out = (int)value;
+        return true;
+    }
+
+    // Skips any value (string, number, literal, object, array)
+    bool skipValue() {
+        int c = peekToken();
+        if (c == '"') {
+            std::string ignored;
+            return readString(ignored);
+        }
+        if (c == '{' || c == '[') {
+            int depth = 0;
+            std::string ignored;
+            do {
+                c = peekToken();
+                if (c == EOF) return false;
+                if (c == '"') {
+                    if (!readString(ignored)) return false;
+                    continue;
+                }
+                if (c == '{' || c == '[') depth++;
+                else if (c == '}' || c == ']') depth--;
+                pos++;
+            } while (depth > 0);
+            return true;
+        }
+        // Number or true/false/null
+        int n = 0;
+        while (c != EOF && c != ',' && c != '}' && c != ']' && !isspace(c)) {
+            pos++;
+            n++;
+            c = peek();
+        }
+        return n > 0;
+    }
+
+    /**
+     * Iterates "key": value pairs of an object.
+     * Call with the opening brace not yet consumed; returns false at '}'.
+     */
+    bool nextKey(std::string& key, bool& first) {
+        if (first) {
+            first = false;
+            if (!expect('{')) return fail();
+            if (expect('}')) return false;
+        } else if (!expect(',')) {
+            return expect('}') ? false : fail();
+        }
+        return (readString(key) && expect(':')) || fail();
+    }
+
+    bool nextElement(bool& first) {
+        if (first) {
+            first = false;
+            if (!expect('[')) return fail();
+            return !expect(']');
+        }
+        if (expect(',')) return true;
+        return expect(']') ? false : fail();
+    }
+
+    bool fail() {
+        failed = true;
+        return false;
+    }
+
+    bool ok() const { return !failed; }
+    bool atEnd() { return peekToken() == EOF; }
+};
+
+int stationIdByName(const std::string& name) {
+    return stationDirectory.getStationId(name);
+}
+
+bool parseService(JsonStream& in, ServiceDefinition& service) {
+    service.id = 0;
+    service.name.clear();
+    service.type.clear();
+    service.stationIds.clear();
+    service.frequencyMinutes = 0;
+    service.peakFrequencyMinutes = 0;
+    service.runTimeMinutes = 0;
+
+    std::string key, value;
+    bool first = true;
+    while (in.nextKey(key, first)) {
+        bool ok;
+        if (key == "id") ok = in.readInt(service.id);
+        else if (key == "name") ok = in.readString(service.name);
+        else if (key == "type") ok = in.readString(service.type);
+        else if (key == "train_frequency_min") ok = in.readInt(service.frequencyMinutes);
+        else if (key == "peak_hour_frequency_min") ok = in.readInt(service.peakFrequencyMinutes);
+        else if (key == "estimated_time_min") ok = in.readInt(service.runTimeMinutes);
+        else if (key == "stations") {
+            ok = true;
+            bool firstStation = true;
+            while (ok && in.nextElement(firstStation)) {
+                ok = in.readString(value);
+                int id = stationIdByName(value);
+                if (id >= 0) service.stationIds.push_back(id);
+            }
+        }
+        else ok = in.skipValue();
+        if (!ok) return false;
+    }
+    return in.ok();
+}
+
+bool isPeakMinute(int minute) {
+    return (minute >= 8 * 60 && minute < 11 * 60) || (minute >= 17 * 60 && minute < 21 * 60);
+}
+
+} // namespace
+
+// ======================================================================================
+//                                   PARSING
+// ======================================================================================
+
+/**
+ * Function: parseServices
+ * Reads the "routes" array of routes.json; every other top-level key is skipped
+ *
+ * Time Complexity: O(file size)
+ */
+bool ServiceLoader::parseServices(const std::string& path, std::vector<ServiceDefinition>& services) {
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file) return false;
+
+    JsonStream in(file);
+    std::string key;
+    bool first = true;
+    bool ok = true;
+
+    while (ok && in.nextKey(key, first)) {
+        if (key != "routes") {
+            ok = in.skipValue();
+            continue;
+        }
+        bool firstService = true;
+        while (ok && in.nextElement(firstService)) {
+            ServiceDefinition service;
+            ok = parseService(in, service);
+            if (ok) services.push_back(std::move(service));
+        }
+    }
+    ok = ok && in.ok() && in.atEnd();
+    fclose(file);
+    return ok;
+}
+
+// ======================================================================================
+//                                   EXPANSION
+// ======================================================================================
+
+/**
+ * Function: expandService
+ * Generates one day of departures for a service
+ *
+ * Parameters:
+ *   service - Parsed definition (needs >= 2 known stations)
+ *   nextTrainId - First id to use; advanced past the ids consumed
+ *   trains / routes - Output, appended in parallel
+ *
+ * Algorithm:
+ *   Route stop k of n: runTime * k / (n - 1), built once
+ *   t = SERVICE_START_MINUTE
+ *   while t < midnight: emit train at t; t += (peak(t) ? peak headway : headway)
+ *   A train departing at t reaches stop k at t + route[k]
+ *
+ * Time Complexity: O(stops + departures)
+ */
+int ServiceLoader::expandService(const ServiceDefinition& service, int& nextTrainId,
+                                 TrainBatch& trains, std::vector<SharedRoute>& routes) {
+    int stops = service.stationIds.size();
+    if (stops < 2 || service.frequencyMinutes <= 0) return 0;
+
+    int peakHeadway = (service.peakFrequencyMinutes > 0) ? service.peakFrequencyMinutes
+                                                         : service.frequencyMinutes;
+    int runTime = std::max(service.runTimeMinutes, stops - 1);
+
+    // One stop list for every departure of the service
+    std::vector<TrainStop> pattern(stops);
+    for (int k = 0; k < stops; k++) {
+        pattern[k].stationId = service.stationIds[k];
+        pattern[k].arrivalTime = runTime * k / (stops - 1);
+    }
+    SharedRoute route = std::make_shared<const std::vector<TrainStop>>(std::move(pattern));
+
+    uint32_t nameId = trainNames.intern(service.name);
+    int added = 0;
+    for (int t = SERVICE_START_MINUTE; t < SERVICE_END_MINUTE;
+         t += isPeakMinute(t) ? peakHeadway : service.frequencyMinutes) {
+        trains.add(nextTrainId++, nameId, t, service.stationIds[0]);
+        routes.push_back(route);
+        added++;
+    }
+    return added;
+}
+
+// ======================================================================================
+//                                   LOADING
+// ======================================================================================
+
+/**
+ * Function: loadServices
+ * Parses routes.json, expands every service and bulk-loads the Scheduler
+ *
+ * New train ids start after the highest id already scheduled (minimum 1001)
+ * so they never collide with timetable.csv or demo trains.
+ */
+int ServiceLoader::loadServices(Scheduler& scheduler, const std::string& path) {
+    std::vector<ServiceDefinition> services;
+    if (!parseServices(path, services)) return -1;
+
+    int nextTrainId = 1001;
+    for (const auto& t : scheduler.getScheduledTrains()) {
+        nextTrainId = std::max(nextTrainId, t.trainId + 1);
+    }
+
+    TrainBatch trains;
+    std::vector<SharedRoute> routes;
+    for (const auto& service : services) {
+        expandService(service, nextTrainId, trains, routes);
+    }
+
+    std::vector<std::pair<int, int> > departures;     // (trainId, departure minute)
+    departures.reserve(trains.size());
+    for (const auto& t : trains.trains) departures.push_back(std::make_pair(t.trainId, t.arrivalTime));
+
+    scheduler.scheduleTrains(std::move(trains));
+    for (size_t i = 0; i < departures.size(); i++) {
+        scheduler.setItinerary(departures[i].first, routes[i], departures[i].second);
+    }
+    return departures.size();
+}
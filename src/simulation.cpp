@@ -0,0 +1,609 @@
+/**
+ * ======================================================================================
+ * IMPLEMENTATION: simulation.cpp
+ * DESCRIPTION: Line-partitioned discrete-event simulation of one operating day
+ *
+ * PARALLEL MODEL: Conservative Synchronization (window based)
+ * - Partition = one railway line (WESTERN, CENTRAL, HARBOUR, TRANS_HARBOUR)
+ * - Each partition owns a private event queue and state
+ * - Cross-line interaction happens only at interchange stations (transfers)
+ * - Lookahead per line pair = dwell plus the shortest hop one line takes into an
+ *   interchange the other serves; every partition runs ahead until the earliest
+ *   time any transfer could still reach it, and messages are delivered at the barrier
+ * - Partitions are spread over at most hardware_concurrency() worker threads
+ *
+ * DETERMINISM:
+ * - Events are ordered by (time, kind, source, sequence) - a strict total order
+ * - Random numbers are stateless hashes, never a shared rand() stream
+ * - Sequential and parallel runs are compared by checksum
+ * ======================================================================================
+ */
+
+#include "../include/simulation.h"
+#include "../include/globals.h"
+#include "../include/colors.h"
+#include <iostream>
+#include <iomanip>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+
+namespace {
+
+const int NUM_LINES = 4;
+const int DWELL_TIME = 1;           // Minutes a train stands at each stop
+const int SERVICE_START = 300;      // 05:00
+const int SERVICE_END = 1380;       // 23:00
+const int TIMING_RUNS = 5;          // Each run mode is timed this many times, best kept
+
+// ======================================================================================
+//                                   EVENTS & MESSAGES
+// ======================================================================================
+
+enum SimEventKind { TRANSFER_ARRIVAL = 0, TRAIN_ARRIVAL = 1 };
+
+struct SimEvent {
+    int time;
+    int kind;       // Transfers land before boarding at the same minute
+    int source;     // Train index (arrival) or sending line (transfer)
+    int seq;        // Stop index (arrival) or message sequence (transfer)
+    int stationId;  // Transfer target station
+    int count;      // Transfer passenger count
+
+    bool operator>(const SimEvent& other) const {
+        if (time != other.time) return time > other.time;
+        if (kind != other.kind) return kind > other.kind;
+        if (source != other.source) return source > other.source;
+        return seq > other.seq;
+    }
+};
+
+struct TransferMessage {
+    int targetLine;
+    SimEvent event;
+};
+
+// Stateless 32-bit mixer (deterministic regardless of thread interleaving)
+unsigned int mix(unsigned int a, unsigned int b, unsigned int c) {
+    unsigned int h = a * 0x9E3779B1u ^ (b + 0x7F4A7C15u);
+    h ^= h >> 15; h *= 0x85EBCA77u;
+    h ^= c + 0xC2B2AE3Du + (h << 6) + (h >> 2);
+    h ^= h >> 13; h *= 0xC2B2AE35u;
+    h ^= h >> 16;
+    return h;
+}
+
+// Minutes of [a, b) that fall inside the morning or evening peak
+int peakOverlap(int a, int b) {
+    static const int peaks[2][2] = { {480, 660}, {1020, 1260} };
+    int total = 0;
+    for (int i = 0; i < 2; i++) {
+        int lo = std::max(a, peaks[i][0]);
+        int hi = std::min(b, peaks[i][1]);
+        if (hi > lo) total += hi - lo;
+    }
+    return total;
+}
+
+// ======================================================================================
+//                                   BARRIER
+// ======================================================================================
+
+/**
+ * Reusable thread barrier (C++11 has no std::barrier)
+ * Generation counter lets the same barrier be reused every window.
+ */
+class WindowBarrier {
+    std::mutex mtx;
+    std::condition_variable cv;
+    int threshold;
+    int waiting;
+    int generation;
+
+public:
+    explicit WindowBarrier(int n) : threshold(n), waiting(0), generation(0) {}
+
+    void wait() {
+        std::unique_lock<std::mutex> lock(mtx);
+        int gen = generation;
+        if (++waiting == threshold) {
+            waiting = 0;
+            generation++;
+            cv.notify_all();
+        } else {
+            cv.wait(lock, [&] { return gen != generation; });
+        }
+    }
+};
+
+// ======================================================================================
+//                                   LINE PARTITION
+// ======================================================================================
+
+/**
+ * Logical process for one railway line.
+ * Owns: its trains' loads, per-station waiting pools for this line, counters.
+ * Never touches another partition's state - only appends to its own outbox.
+ */
+class LinePartition {
+public:
+    int line;
+    const std::vector<SimTrain>* trains;
+    const std::vector<unsigned char>* servedBy;   // Line bitmask per station
+    unsigned int seed;
+
+    std::priority_queue<SimEvent, std::vector<SimEvent>, std::greater<SimEvent>> events;
+    std::vector<int> load;          // Indexed by global train index
+    std::vector<int> waiting;
+    std::vector<int> lastVisit;
+    std::vector<long long> boarded, alighted, transfersIn;
+    std::vector<TransferMessage> outbox;
+    long long totalTransfers;
+    int peakLoad;
+    int eventsProcessed;
+    int messageSeq;
+
+    LinePartition(int l, const std::vector<SimTrain>* t, const std::vector<unsigned char>* served,
+                  int stations, unsigned int s)
+        : line(l), trains(t), servedBy(served), seed(s),
+          load(t->size(), 0), waiting(stations, 0), lastVisit(stations, SERVICE_START),
+          boarded(stations, 0), alighted(stations, 0), transfersIn(stations, 0),
+          totalTransfers(0), peakLoad(0), eventsProcessed(0), messageSeq(0) {
+        for (int i = 0; i < (int)t->size(); i++) {
+            const SimTrain& train = (*t)[i];
+            if (train.line != line) continue;
+            SimEvent e = { train.departureTime, TRAIN_ARRIVAL, i, 0, train.originId, 0 };
+            events.push(e);
+        }
+    }
+
+    int nextEventTime() const {
+        return events.empty() ? INF : events.top().time;
+    }
+
+    // Process every event strictly before 'limit'
+    void processUntil(int limit) {
+        while (!events.empty() && events.top().time < limit) {
+            SimEvent e = events.top();
+            events.pop();
+            handle(e);
+        }
+    }
+
+    void processOne() {
+        SimEvent e = events.top();
+        events.pop();
+        handle(e);
+    }
+
+private:
+    int stationAt(const SimTrain& t, int stop) const {
+        return stop == 0 ? t.originId : t.route[stop - 1].to;
+    }
+
+    int arrivalsBetween(int station, int from, int to) const {
+        if (to <= from) return 0;
+        int rate = 1 + (int)(mix(seed, station, line) % 4);   // Passengers per minute
+        return rate * ((to - from) + 2 * peakOverlap(from, to));
+    }
+
+    int alightingAt(const SimTrain& t, int stop, int currentLoad) const {
+        if (stop == 0) return 0;
+        if (stop == (int)t.route.size()) return currentLoad;  // Terminus: everyone out
+        int pct = 10 + (int)(mix(seed, t.trainId, stop) % 30);
+        return currentLoad * pct / 100;
+    }
+
+    void handle(const SimEvent& e) {
+        eventsProcessed++;
+        if (e.kind == TRANSFER_ARRIVAL) {
+            waiting[e.stationId] += e.count;
+            transfersIn[e.stationId] += e.count;
+            return;
+        }
+
+        const SimTrain& t = (*trains)[e.source];
+        int stop = e.seq;
+        int s = stationAt(t, stop);
+
+        // Alight
+        int out = alightingAt(t, stop, load[e.source]);
+        load[e.source] -= out;
+        alighted[s] += out;
+
+        // Platform accumulates passengers since the last train on this line
+        waiting[s] += arrivalsBetween(s, lastVisit[s], e.time);
+        lastVisit[s] = e.time;
+
+        if (stop == (int)t.route.size()) return;  // Terminus reached
+
+        // Board
+        int space = t.capacity - load[e.source];
+        int in = std::min(space, waiting[s]);
+        waiting[s] -= in;
+        load[e.source] += in;
+        boarded[s] += in;
+        if (load[e.source] > peakLoad) peakLoad = load[e.source];
+
+        // Depart towards the next stop
+        const Edge& hop = t.route[stop];
+        int arrival = e.time + DWELL_TIME + hop.weight;
+        SimEvent next = { arrival, TRAIN_ARRIVAL, e.source, stop + 1, hop.to, 0 };
+        events.push(next);
+
+        // Announce transfers now: timestamp is >= lookahead ahead of this event
+        unsigned char others = (*servedBy)[hop.to] & ~(1u << line);
+        if (others == 0 || (size_t)hop.to >= allStations.size() || !allStations[hop.to].isInterchange) return;
+
+        int leaving = alightingAt(t, stop + 1, load[e.source]);
+        int transferring = leaving * (30 + (int)(mix(seed ^ 0x5bd1e995u, t.trainId, stop + 1) % 30)) / 100;
+        if (transferring == 0) return;
+
+        int targets = 0;
+        for (int l = 0; l < NUM_LINES; l++) if (others & (1u << l)) targets++;
+        int share = transferring / targets;
+        int remainder = transferring % targets;
+        for (int l = 0; l < NUM_LINES; l++) {
+            if (!(others & (1u << l))) continue;
+            int count = share + remainder;
+            remainder = 0;
+            if (count == 0) continue;
+            TransferMessage msg;
+            msg.targetLine = l;
+            SimEvent te = { arrival, TRANSFER_ARRIVAL, line, messageSeq++, hop.to, count };
+            msg.event = te;
+            outbox.push_back(msg);
+            totalTransfers += count;
+        }
+    }
+};
+
+std::vector<unsigned char> computeServedBy(const std::vector<SimTrain>& trains, int stations) {
+    std::vector<unsigned char> served(stations, 0);
+    for (const auto& t : trains) {
+        served[t.originId] |= (1u << t.line);
+        for (const auto& hop : t.route) served[hop.to] |= (1u << t.line);
+    }
+    return served;
+}
+
+// Time t plus d minutes, saturating at INF
+int later(int t, int d) {
+    return (t >= INF || d >= INF) ? INF : std::min(INF, t + d);
+}
+
+/**
+ * reach[q][p] = soonest a transfer sent by line q can land on line p, counted
+ * from the event that sends it: dwell plus the hop into an interchange p also
+ * serves, never below the network-wide floor. INF when q never feeds p.
+ */
+std::vector<std::vector<int>> transferLookahead(const std::vector<SimTrain>& trains,
+                                                const std::vector<unsigned char>& served, int floor) {
+    // Lines a transfer can be handed to at each station (none off interchanges)
+    std::vector<unsigned char> handsTo(served.size(), 0);
+    for (size_t s = 0; s < served.size() && s < allStations.size(); s++) {
+        if (allStations[s].isInterchange) handsTo[s] = served[s];
+    }
+
+    std::vector<std::vector<int>> reach(NUM_LINES, std::vector<int>(NUM_LINES, INF));
+    for (const auto& t : trains) {
+        for (const auto& hop : t.route) {
+            unsigned char others = handsTo[hop.to] & ~(1u << t.line);
+            if (others == 0) continue;
+            int minutes = std::max(floor, DWELL_TIME + hop.weight);
+            for (int p = 0; p < NUM_LINES; p++) {
+                if (others & (1u << p)) reach[t.line][p] = std::min(reach[t.line][p], minutes);
+            }
+        }
+    }
+    return reach;
+}
+
+/**
+ * Window end for every partition, given each one's next event time.
+ * earliest[q] = first time line q could still process anything, including
+ * transfers relayed through other lines (shortest paths over 'reach').
+ * Partition p is safe below the earliest transfer any other line can send it.
+ */
+void windowEnds(const std::vector<int>& nextTimes, const std::vector<std::vector<int>>& reach,
+                std::vector<int>& ends) {
+    std::vector<int> earliest(nextTimes);
+    for (int round = 1; round < NUM_LINES; round++) {
+        for (int q = 0; q < NUM_LINES; q++) {
+            for (int p = 0; p < NUM_LINES; p++) {
+                if (p != q) earliest[p] = std::min(earliest[p], later(earliest[q], reach[q][p]));
+            }
+        }
+    }
+    for (int p = 0; p < NUM_LINES; p++) {
+        ends[p] = INF;
+        for (int q = 0; q < NUM_LINES; q++) {
+            if (q != p) ends[p] = std::min(ends[p], later(earliest[q], reach[q][p]));
+        }
+    }
+}
+
+void fnv(unsigned long long& h, long long v) {
+    for (int i = 0; i < 8; i++) {
+        h ^= (unsigned long long)((v >> (8 * i)) & 0xFF);
+        h *= 1099511628211ULL;
+    }
+}
+
+SimulationResult collect(std::vector<LinePartition>& parts, int stations) {
+    SimulationResult r;
+    r.boarded.assign(stations, 0);
+    r.alighted.assign(stations, 0);
+    r.transfersIn.assign(stations, 0);
+    r.totalBoarded = 0;
+    r.totalTransfers = 0;
+    r.peakLoad = 0;
+    r.eventsProcessed = 0;
+    r.windows = 0;
+    r.workers = 1;
+    r.elapsedMs = 0;
+
+    for (auto& p : parts) {
+        for (int s = 0; s < stations; s++) {
+            r.boarded[s] += p.boarded[s];
+            r.alighted[s] += p.alighted[s];
+            r.transfersIn[s] += p.transfersIn[s];
+            r.totalBoarded += p.boarded[s];
+        }
+        r.totalTransfers += p.totalTransfers;
+        r.peakLoad = std::max(r.peakLoad, p.peakLoad);
+        r.eventsProcessed += p.eventsProcessed;
+    }
+
+    unsigned long long h = 1469598103934665603ULL;
+    for (int s = 0; s < stations; s++) {
+        fnv(h, r.boarded[s]);
+        fnv(h, r.alighted[s]);
+        fnv(h, r.transfersIn[s]);
+    }
+    fnv(h, r.totalTransfers);
+    fnv(h, r.peakLoad);
+    fnv(h, r.eventsProcessed);
+    r.checksum = h;
+    return r;
+}
+
+double millisSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+// ======================================================================================
+//                                   TRAIN SIMULATOR IMPLEMENTATION
+// ======================================================================================
+
+TrainSimulator::TrainSimulator(int stations, int lookaheadMinutes, unsigned int randomSeed) {
+    numStations = stations;
+    lookahead = std::max(1, lookaheadMinutes);
+    seed = randomSeed;
+}
+
+void TrainSimulator::addTrain(const SimTrain& train) {
+    trains.push_back(train);
+}
+
+/**
+ * Function: runSequential
+ * Reference run: always executes the globally earliest event next
+ *
+ * Algorithm:
+ *   1. Pick the partition whose next event is earliest
+ *   2. Process that single event
+ *   3. Deliver any transfer messages straight into the target partition's queue
+ *
+ * Time Complexity: O(E log E) where E = total events
+ */
+SimulationResult TrainSimulator::runSequential() {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<unsigned char> served = computeServedBy(trains, numStations);
+
+    std::vector<LinePartition> parts;
+    for (int l = 0; l < NUM_LINES; l++) {
+        parts.push_back(LinePartition(l, &trains, &served, numStations, seed));
+    }
+
+    while (true) {
+        int best = -1;
+        int bestTime = INF;
+        for (int l = 0; l < NUM_LINES; l++) {
+            int t = parts[l].nextEventTime();
+            if (t < bestTime) { bestTime = t; best = l; }
+        }
+        if (best == -1) break;
+
+        parts[best].processOne();
+        for (const auto& msg : parts[best].outbox) {
+            parts[msg.targetLine].events.push(msg.event);
+        }
+        parts[best].outbox.clear();
+    }
+
+    SimulationResult r = collect(parts, numStations);
+    r.elapsedMs = millisSince(start);
+    return r;
+}
+
+/**
+ * Function: runParallel
+ * Conservative parallel run, line partitions spread over the worker threads
+ *
+ * Window Protocol (repeated until all queues are empty):
+ *   1. Every partition p processes its events with time < end[p]
+ *   2. Barrier - all outboxes are complete
+ *   3. Each partition pulls the messages addressed to it and publishes
+ *      its next event time
+ *   4. Barrier - every worker derives the next ends from the published times
+ *
+ * Safety: a message from q to p is stamped >= the sending event + reach[q][p],
+ *   and q cannot process anything before earliest[q], so nothing addressed to
+ *   p can land below end[p] - not in this window, nor relayed in a later one.
+ *   A partition with no incoming transfers runs straight to the end of the day.
+ *
+ * Time Complexity: O(E log E / P) work per thread plus O(W) barriers,
+ *   where W = number of windows
+ */
+SimulationResult TrainSimulator::runParallel() {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<unsigned char> served = computeServedBy(trains, numStations);
+
+    std::vector<LinePartition> parts;
+    for (int l = 0; l < NUM_LINES; l++) {
+        parts.push_back(LinePartition(l, &trains, &served, numStations, seed));
+    }
+
+    std::vector<std::vector<int>> reach = transferLookahead(trains, served, lookahead);
+    std::vector<int> nextTimes(NUM_LINES, INF);
+    for (int l = 0; l < NUM_LINES; l++) nextTimes[l] = parts[l].nextEventTime();
+
+    // More threads than cores only adds context switches to every barrier
+    int numWorkers = std::max(1, std::min(NUM_LINES, (int)std::thread::hardware_concurrency()));
+    WindowBarrier barrier(numWorkers);
+    int windows = 0;
+
+    auto worker = [&](int self) {
+        std::vector<int> ends(NUM_LINES, INF);
+        windowEnds(nextTimes, reach, ends);
+        while (true) {
+            for (int l = self; l < NUM_LINES; l += numWorkers) parts[l].processUntil(ends[l]);
+            barrier.wait();
+
+            for (int l = self; l < NUM_LINES; l += numWorkers) {
+                for (int from = 0; from < NUM_LINES; from++) {
+                    for (const auto& msg : parts[from].outbox) {
+                        if (msg.targetLine == l) parts[l].events.push(msg.event);
+                    }
+                }
+                nextTimes[l] = parts[l].nextEventTime();
+            }
+            barrier.wait();
+
+            // Every reader finished before the second barrier
+            for (int l = self; l < NUM_LINES; l += numWorkers) parts[l].outbox.clear();
+            if (self == 0) windows++;
+
+            int windowStart = INF;
+            for (int l = 0; l < NUM_LINES; l++) windowStart = std::min(windowStart, nextTimes[l]);
+            if (windowStart >= INF) break;
+            windowEnds(nextTimes, reach, ends);
+        }
+    };
+
+    // The calling thread is worker 0 - on a single core nothing is spawned at all
+    std::vector<std::thread> workers;
+    for (int w = 1; w < numWorkers; w++) workers.push_back(std::thread(worker, w));
+    worker(0);
+    for (auto& w : workers) w.join();
+
+    SimulationResult r = collect(parts, numStations);
+    r.windows = windows;
+    r.workers = numWorkers;
+    r.elapsedMs = millisSince(start);
+    return r;
+}
+
+// ======================================================================================
+//                                   DAY SIMULATION DRIVER
+// ======================================================================================
+
+/**
+ * Function: runDaySimulation
+ * Builds a synthetic full-day timetable and runs it sequentially and in parallel
+ *
+ * Parameters:
+ *   network - Railway network used to trace each line
+ *   headwayMinutes - Gap between consecutive departures from each terminus
+ *
+ * Timetable:
+ *   - Termini = stations with exactly one open track on that line
+ *   - From every terminus, trains depart 05:00 - 23:00 every headway minutes
+ *
+ * Output: Side-by-side timing, speedup and checksum comparison
+ */
+void runDaySimulation(RailwayNetwork* network, int headwayMinutes) {
+    if (headwayMinutes <= 0) headwayMinutes = 10;
+    int stations = adj.size();
+    int lookahead = network->getMinTravelTime();
+    if (lookahead >= INF) {
+        std::cout << RED << "No tracks in the network - nothing to simulate.\n" << RESET;
+        return;
+    }
+
+    TrainSimulator sim(stations, lookahead);
+    int services = 0;
+    for (int l = 0; l < NUM_LINES; l++) {
+        LineType line = (LineType)l;
+        int trainNo = 0;
+        for (int s = 0; s < stations; s++) {
+            int degree = 0;
+            for (const auto& edge : adj[s]) {
+                if (edge.line == line && edge.weight < INF) degree++;
+            }
+            if (degree != 1) continue;
+
+            std::vector<Edge> route = network->traceLineRoute(s, line);
+            if (route.empty()) continue;
+            services++;
+            for (int t = SERVICE_START; t <= SERVICE_END; t += headwayMinutes) {
+                SimTrain train;
+                train.trainId = (l + 1) * 10000 + trainNo++;
+                train.line = line;
+                train.originId = s;
+                train.departureTime = t;
+                train.capacity = 2000;
+                train.route = route;
+                sim.addTrain(train);
+            }
+        }
+    }
+
+    std::cout << "\n╔════════════════════════════════════════════════════════╗\n";
+    std::cout << "║       FULL-DAY SIMULATION (PARALLEL BY LINE)           ║\n";
+    std::cout << "╚════════════════════════════════════════════════════════╝\n\n";
+    std::cout << "Services: " << services << " | Trains: " << sim.getTrainCount()
+              << " | Headway: " << headwayMinutes << " min | Fastest track: " << lookahead << " min\n\n";
+
+    // Best of several runs each; every run must reproduce the first sequential result
+    SimulationResult seq = sim.runSequential();
+    SimulationResult par = sim.runParallel();
+    bool identical = seq.checksum == par.checksum;
+    for (int run = 1; run < TIMING_RUNS; run++) {
+        SimulationResult s = sim.runSequential();
+        SimulationResult p = sim.runParallel();
+        identical = identical && s.checksum == seq.checksum && p.checksum == seq.checksum;
+        seq.elapsedMs = std::min(seq.elapsedMs, s.elapsedMs);
+        par.elapsedMs = std::min(par.elapsedMs, p.elapsedMs);
+    }
+
+    std::cout << std::left << std::setw(24) << "Metric"
+              << std::setw(18) << "Sequential" << "Parallel\n";
+    std::cout << "──────────────────────────────────────────────────────────\n";
+    std::cout << std::setw(24) << "Events processed" << std::setw(18) << seq.eventsProcessed << par.eventsProcessed << "\n";
+    std::cout << std::setw(24) << "Passengers boarded" << std::setw(18) << seq.totalBoarded << par.totalBoarded << "\n";
+    std::cout << std::setw(24) << "Line transfers" << std::setw(18) << seq.totalTransfers << par.totalTransfers << "\n";
+    std::cout << std::setw(24) << "Peak train load" << std::setw(18) << seq.peakLoad << par.peakLoad << "\n";
+    std::cout << std::setw(24) << "Sync windows" << std::setw(18) << "-" << par.windows << "\n";
+    std::cout << std::setw(24) << "Worker threads" << std::setw(18) << 1 << par.workers << "\n";
+    std::cout << std::setw(24) << "Best elapsed (ms)" << std::fixed << std::setprecision(2)
+              << std::setw(18) << seq.elapsedMs << par.elapsedMs << "\n";
+    std::cout << "──────────────────────────────────────────────────────────\n";
+
+    if (par.elapsedMs > 0) {
+        std::cout << "Speedup: " << std::setprecision(2) << seq.elapsedMs / par.elapsedMs << "x\n";
+    }
+    std::cout << "Timed runs: " << TIMING_RUNS << " each | Partitions: " << NUM_LINES
+              << " | Hardware threads: " << std::thread::hardware_concurrency() << "\n";
+    if (identical) {
+        std::cout << GREEN << "✓ Results identical in every run (checksum " << std::hex << seq.checksum
+                  << std::dec << ")\n" << RESET;
+    } else {
+        std::cout << RED << "❌ Results differ between sequential and parallel runs!\n" << RESET;
+    }
+}
@@ -6,102 +6,283 @@
  */
 
 #include "../include/station.h"
+#include "../include/station_catalogue.h"
 #include "../include/scheduling.h"
 #include "../include/globals.h"
 #include "../include/analytics.h"
 #include "../include/graph.h"
 #include <cstdlib>
+#include <cstring>
 #include <algorithm>
 #include <iostream>
 
 // ======================================================================================
-//                               STATION BST IMPLEMENTATION
+//                               STATION DIRECTORY IMPLEMENTATION
 // ======================================================================================
 
-void StationBST::insertHelper(BSTNode*& node, const std::string& name, int id) {
-    if (node == nullptr) {
-        node = new BSTNode(name, id);
-        return;
+namespace {
+
+// ASCII case folding (what ::tolower does in the "C" locale), inlined
+inline unsigned char foldCase(unsigned char c) {
+    return (c >= 'A' && c <= 'Z') ? (unsigned char)(c + ('a' - 'A')) : c;
+}
+
+// Compares a stored (already lowercase) key with 'query' folded to lowercase,
+// both cut to 'limit' characters; same order as comparing lowercased strings
+int compareFolded(const char* key, size_t keyLength, const std::string& query, size_t limit) {
+    size_t n = std::min(std::min(keyLength, query.size()), limit);
+    for (size_t i = 0; i < n; i++) {
+        unsigned char a = (unsigned char)key[i];
+        unsigned char b = foldCase((unsigned char)query[i]);
+        if (a != b) return a < b ? -1 : 1;
     }
-    
-    // Lowercase comparison for BST ordering
-    std::string nameLower = name;
-    std::transform(nameLower.begin(), nameLower.end(), nameLower.begin(), ::tolower);
-    
-    if (nameLower < node->nameLower) {
-        insertHelper(node->left, name, id);
-    } else {
-        insertHelper(node->right, name, id);
+    size_t keyCut = std::min(keyLength, limit);
+    size_t queryCut = std::min(query.size(), limit);
+    return keyCut == queryCut ? 0 : (keyCut < queryCut ? -1 : 1);
+}
+
+// FNV-1a over the lowercased bytes
+uint32_t foldedHash(const char* s, size_t length) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= foldCase((unsigned char)s[i]);
+        hash *= 16777619u;
     }
+    return hash;
 }
 
-int StationBST::searchHelper(BSTNode* node, const std::string& name) const {
-    if (node == nullptr) {
-        return -1;
+bool equalsFolded(const std::string& a, const char* b, size_t length) {
+    if (a.size() != length) return false;
+    for (size_t i = 0; i < length; i++) {
+        if (foldCase((unsigned char)a[i]) != foldCase((unsigned char)b[i])) return false;
     }
-    
-    std::string nameLower = name;
-    std::transform(nameLower.begin(), nameLower.end(), nameLower.begin(), ::tolower);
-    
-    if (nameLower == node->nameLower) {
-        return node->stationId;
-    } else if (nameLower < node->nameLower) {
-        return searchHelper(node->left, name);
-    } else {
-        return searchHelper(node->right, name);
+    return true;
+}
+
+uint16_t bigram(char a, char b) {
+    return (uint16_t)(((unsigned char)a << 8) | (unsigned char)b);
+}
+
+/**
+ * Myers' bit-parallel edit distance (Hyyro's formulation for whole strings)
+ * One column of the DP matrix is kept as vertical +1/-1 delta bit vectors
+ * (Pv/Mv) over the m <= 64 pattern characters, so each text character costs
+ * a handful of word operations. peq[c] has bit i set where pattern[i] == c.
+ * The bottom cell falls by at most one per remaining character, so the scan
+ * stops once the distance cannot come back under 'cutoff'.
+ *
+ * Returns: the distance, or some value > cutoff
+ * Time Complexity: O(n) for a text of n characters
+ */
+int bitParallelDistance(const uint64_t* peq, int m, const char* text, size_t n, int cutoff) {
+    uint64_t pv = ~0ULL, mv = 0;
+    uint64_t last = 1ULL << (m - 1);
+    int score = m;
+    for (size_t j = 0; j < n; j++) {
+        uint64_t eq = peq[(unsigned char)text[j]];
+        uint64_t xv = eq | mv;
+        uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+        uint64_t ph = mv | ~(xh | pv);
+        uint64_t mh = pv & xh;
+        if (ph & last) score++;
+        else if (mh & last) score--;
+        if (score - (int)(n - 1 - j) > cutoff) return cutoff + 1;
+        ph = (ph << 1) | 1;         // Row 0 is 0, 1, 2, ...: whole-string distance
+        mh <<= 1;
+        pv = mh | ~(xv | ph);
+        mv = ph & xv;
     }
+    return score;
 }
 
-void StationBST::listHelper(BSTNode* node) const {
-    if (node == nullptr) return;
-    
-    listHelper(node->left);
-    std::cout << "  " << node->name << " (ID: " << node->stationId << ")\n";
-    listHelper(node->right);
+} // namespace
+
+int lookupCatalogueStation(const char* name, size_t length, uint32_t hash) {
+    uint8_t id = CATALOGUE_SLOTS.id[catalogueSlot(hash, CATALOGUE_SEED)];
+    if (id == CATALOGUE_EMPTY) return -1;
+    const char* key = STATION_CATALOGUE[id].name;
+    for (size_t i = 0; i < length; i++) {
+        if (key[i] == '\0' || foldCase((unsigned char)key[i]) != foldCase((unsigned char)name[i])) return -1;
+    }
+    return key[length] == '\0' ? id : -1;
 }
 
-void StationBST::matchHelper(BSTNode* node, const std::string& prefix,
-                             std::vector<std::pair<std::string, int>>& results, 
-                             int& count) const {
-    if (node == nullptr || count >= 10) return;
-    
-    // In-order traversal for lexical order
-    matchHelper(node->left, prefix, results, count);
-    
-    if (count < 10) {
-        std::string nameLower = node->nameLower;
-        std::string prefixLower = prefix;
-        std::transform(prefixLower.begin(), prefixLower.end(), prefixLower.begin(), ::tolower);
-        
-        if (nameLower.substr(0, prefixLower.length()) == prefixLower) {
-            results.push_back({node->name, node->stationId});
-            count++;
+/**
+ * Function: build
+ * Registers every station, then builds the sorted and fuzzy indexes once
+ * Time Complexity: O(n log n) for n stations
+ */
+void StationDirectory::build(const std::vector<Station>& stations) {
+    names.clear();
+    slots.clear();
+    count = 0;
+    catalogueIds = false;
+    for (const auto& station : stations) add(station.name, station.id);
+
+    // Built-in network (initializeStations, or its CSV / image round trip):
+    // catalogue names resolve through the perfect hash first
+    bool matches = names.size() >= (size_t)CATALOGUE_SIZE;
+    for (int id = 0; matches && id < CATALOGUE_SIZE; id++) {
+        matches = equalsFolded(names[id], STATION_CATALOGUE[id].name, strlen(STATION_CATALOGUE[id].name));
+    }
+    catalogueIds = matches;
+    rebuildIndexes();
+}
+
+/**
+ * Function: add
+ * Probes for the name; on a miss stores it in the id table and the hash,
+ * doubling the table when it would pass half full
+ * Time Complexity: O(|name|) average
+ */
+int StationDirectory::add(const std::string& name, int id) {
+    int existing = getStationId(name);
+    if (existing != -1 || id < 0) return existing;
+
+    if ((size_t)id >= names.size()) names.resize(id + 1);
+    names[id] = name;
+
+    if (2 * (count + 1) > slots.size()) {
+        std::vector<Slot> old;
+        old.swap(slots);
+        Slot empty = { 0, -1 };
+        slots.assign(std::max<size_t>(16, old.size() * 2), empty);
+        for (const auto& slot : old) {
+            if (slot.id != -1) insertSlot(slot.hash, slot.id);
         }
     }
-    
-    if (count < 10) {
-        matchHelper(node->right, prefix, results, count);
+    insertSlot(foldedHash(name.data(), name.size()), id);
+    count++;
+    return id;
+}
+
+void StationDirectory::insertSlot(uint32_t hash, int id) {
+    size_t mask = slots.size() - 1;
+    size_t i = hash & mask;
+    while (slots[i].id != -1) i = (i + 1) & mask;
+    slots[i].hash = hash;
+    slots[i].id = id;
+}
+
+const std::string& StationDirectory::name(int id) const {
+    static const std::string unknown;
+    return contains(id) ? names[id] : unknown;
+}
+
+/**
+ * Function: getStationId
+ * One hash of the folded bytes, then linear probing; names are compared
+ * (case-folded, in place) only when the stored hash matches
+ * Time Complexity: O(|name|) average, no allocation
+ */
+int StationDirectory::getStationId(const char* name, size_t length) const {
+    if (slots.empty()) return -1;
+    uint32_t hash = foldedHash(name, length);
+    if (catalogueIds) {
+        int id = lookupCatalogueStation(name, length, hash);
+        if (id != -1) return id;
     }
+    size_t mask = slots.size() - 1;
+    for (size_t i = hash & mask; slots[i].id != -1; i = (i + 1) & mask) {
+        if (slots[i].hash == hash && equalsFolded(names[slots[i].id], name, length)) return slots[i].id;
+    }
+    return -1;
 }
 
-void StationBST::deleteHelper(BSTNode*& node) {
-    if (node == nullptr) return;
-    deleteHelper(node->left);
-    deleteHelper(node->right);
-    delete node;
-    node = nullptr;
+/**
+ * Function: rebuildIndexes
+ * Sorts (lowercased name, id) pairs and lays the keys and display names out
+ * in one pool, then builds the bigram postings
+ */
+void StationDirectory::rebuildIndexes() {
+    std::vector<std::pair<std::string, int> > sorted;      // (key, station id)
+    sorted.reserve(count);
+    size_t poolBytes = 0;
+    for (size_t id = 0; id < names.size(); id++) {
+        if (names[id].empty()) continue;
+        std::string nameLower = names[id];
+        for (auto& c : nameLower) c = (char)foldCase((unsigned char)c);
+        poolBytes += 2 * nameLower.size();
+        sorted.push_back(std::make_pair(nameLower, (int)id));
+    }
+    std::sort(sorted.begin(), sorted.end());
+
+    entries.clear();
+    pool.clear();
+    entries.reserve(sorted.size());
+    pool.reserve(poolBytes);
+    for (const auto& item : sorted) {
+        Entry e = { (uint32_t)pool.size(), (uint32_t)item.first.size(), item.second };
+        pool += item.first;
+        pool += names[item.second];
+        entries.push_back(e);
+    }
+
+    // Fuzzy search: bigram postings and a by-length order, both grouped by
+    // key length so a query only touches names of nearby length.
+    // Sort key: gram (16 bits) | length (16 bits) | entry (32 bits)
+    std::vector<uint64_t> grams;
+    byLength.clear();
+    byLength.reserve(entries.size());
+    for (size_t i = 0; i < entries.size(); i++) {
+        const char* k = key(entries[i]);
+        uint64_t length = std::min<uint32_t>(entries[i].length, 0xFFFF);
+        for (uint32_t j = 0; j + 1 < entries[i].length; j++) {
+            grams.push_back(((uint64_t)bigram(k[j], k[j + 1]) << 48) | (length << 32) | i);
+        }
+        byLength.push_back((uint32_t)i);
+    }
+    std::sort(grams.begin(), grams.end());
+    std::stable_sort(byLength.begin(), byLength.end(), [this](uint32_t a, uint32_t b) {
+        return entries[a].length < entries[b].length;
+    });
+
+    gramKeys.clear();
+    gramOffsets.clear();
+    postings.clear();
+    postingCounts.clear();
+    for (size_t at = 0; at < grams.size(); at++) {
+        uint64_t g = grams[at];
+        if (at > 0 && g == grams[at - 1]) {
+            if (postingCounts.back() < 0xFF) postingCounts.back()++;   // Repeat within one name
+            continue;
+        }
+        uint16_t gram = (uint16_t)(g >> 48);
+        if (gramKeys.empty() || gramKeys.back() != gram) {
+            gramKeys.push_back(gram);
+            gramOffsets.push_back((uint32_t)postings.size());
+        }
+        postings.push_back((uint32_t)g);
+        postingCounts.push_back(1);
+    }
+    gramOffsets.push_back((uint32_t)postings.size());
 }
 
-void StationBST::addStation(const std::string& name, int stationId) {
-    insertHelper(root, name, stationId);
+uint32_t StationDirectory::lengthBound(const std::vector<uint32_t>& list, uint32_t begin, uint32_t end,
+                                   uint32_t length) const {
+    while (begin < end) {
+        uint32_t mid = begin + (end - begin) / 2;
+        if (std::min<uint32_t>(entries[list[mid]].length, 0xFFFF) < length) begin = mid + 1;
+        else end = mid;
+    }
+    return begin;
 }
 
-int StationBST::getStationId(const std::string& name) const {
-    return searchHelper(root, name);
+size_t StationDirectory::lowerBound(const std::string& query, size_t limit) const {
+    size_t lo = 0, hi = entries.size();
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (compareFolded(key(entries[mid]), entries[mid].length, query, limit) < 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
 }
 
-void StationBST::listStations() const {
-    if (root == nullptr) {
+void StationDirectory::listStations() const {
+    if (entries.empty()) {
         std::cout << "No stations in directory.\n";
         return;
     }
@@ -109,13 +290,160 @@ void StationBST::listStations() const {
     std::cout << "\n┌────────────────────────────────────────────────────────┐\n";
     std::cout << "│           ALL STATIONS (LEXICAL ORDER)                 │\n";
     std::cout << "└────────────────────────────────────────────────────────┘\n";
-    listHelper(root);
+    for (const auto& e : entries) {
+        std::cout << "  ";
+        std::cout.write(displayName(e), e.length);
+        std::cout << " (ID: " << e.stationId << ")\n";
+    }
 }
 
-std::vector<std::pair<std::string, int>> StationBST::listMatchingStations(const std::string& prefix) const {
+/**
+ * Function: listMatchingStations
+ * Matches of a prefix are one contiguous run of the sorted array: find its
+ * start with a binary search on the first |prefix| characters, then read
+ * forward until a key stops matching or 10 are collected
+ *
+ * Time Complexity: O(|prefix| log n + k)
+ */
+std::vector<std::pair<std::string, int>> StationDirectory::listMatchingStations(const std::string& prefix) const {
     std::vector<std::pair<std::string, int>> results;
-    int count = 0;
-    matchHelper(root, prefix, results, count);
+    size_t limit = prefix.size();
+    for (size_t i = lowerBound(prefix, limit); i < entries.size() && results.size() < 10; i++) {
+        const Entry& e = entries[i];
+        if (e.length < limit || compareFolded(key(e), e.length, prefix, limit) != 0) break;
+        results.push_back({std::string(displayName(e), e.length), e.stationId});
+    }
+    return results;
+}
+
+/**
+ * Function: listSimilarStations
+ * Typo-tolerant lookup ("Andhri" -> Andheri, "Ghatkoper" -> Ghatkopar)
+ *
+ * Algorithm:
+ * 1. Allowed distance K from the query length (1 up to 5 chars, 2 up to 10, else 3)
+ * 2. For k = 1 .. K, over names whose length is within k of the query:
+ *    - q-gram lemma: one edit destroys at most two of the query's m-1
+ *      bigram occurrences, so a name within k edits still holds any P of
+ *      them minus 2k. Take the P = 2k+3 rarest occurrences (a gram absent
+ *      from the index is rarest of all), add up each name's share from
+ *      those postings and keep names that reach P - 2k. If the query has
+ *      fewer than 2k+1 bigrams nothing can be ruled out and every name of
+ *      a fitting length is a candidate.
+ *    - Each candidate is verified once with the bit-parallel distance
+ *    - Stop at the first k with a match: a typo farther than the best
+ *      match is not offered
+ * 3. Rank by distance, then passengerCount (busier first), then name
+ *
+ * Queries are cut to 64 characters (one machine word of pattern bits).
+ * Time Complexity: O(probed postings + candidates * name length) per round
+ */
+std::vector<std::pair<std::string, int>> StationDirectory::listSimilarStations(
+        const std::string& query, const std::vector<Station>& stations, size_t limit) const {
+    std::vector<std::pair<std::string, int>> results;
+    int m = (int)std::min<size_t>(query.size(), 64);
+    if (m == 0 || entries.empty() || limit == 0) return results;
+
+    char folded[64];
+    uint64_t peq[256] = {0};
+    for (int i = 0; i < m; i++) {
+        folded[i] = (char)foldCase((unsigned char)query[i]);
+        peq[(unsigned char)folded[i]] |= 1ULL << i;
+    }
+    int maxDistance = m <= 5 ? 1 : (m <= 10 ? 2 : 3);
+
+    // Query bigrams as (gram, occurrences), plus each one's postings range
+    struct QueryGram { uint16_t gram; int count; uint32_t begin, end; };
+    QueryGram grams[63];
+    uint16_t sorted[63];
+    int occurrences = m - 1;
+    for (int i = 0; i < occurrences; i++) sorted[i] = bigram(folded[i], folded[i + 1]);
+    std::sort(sorted, sorted + occurrences);
+    int gramCount = 0;
+    for (int i = 0; i < occurrences; i++) {
+        if (gramCount > 0 && grams[gramCount - 1].gram == sorted[i]) {
+            grams[gramCount - 1].count++;
+        } else {
+            QueryGram g = { sorted[i], 1, 0, 0 };
+            grams[gramCount++] = g;
+        }
+    }
+
+    struct Match { int distance; int passengers; uint32_t entry; };
+    std::vector<Match> matches;
+    std::vector<uint8_t> verified(entries.size(), 0);
+    std::vector<uint8_t> shared(entries.size(), 0);
+    std::vector<uint32_t> touched;
+    auto verify = [&](uint32_t i) {
+        if (verified[i]) return;
+        verified[i] = 1;
+        const Entry& e = entries[i];
+        int distance = bitParallelDistance(peq, m, key(e), e.length, maxDistance);
+        if (distance > maxDistance) return;
+        int passengers = (e.stationId >= 0 && (size_t)e.stationId < stations.size())
+            ? stations[e.stationId].passengerCount : 0;
+        Match match = { distance, passengers, i };
+        matches.push_back(match);
+    };
+
+    int reached = 0;                    // Every name within 'reached' edits is in matches
+    for (int k = 1; k <= maxDistance; k++) {
+        if (k > 1 && std::any_of(matches.begin(), matches.end(),
+                                 [reached](const Match& x) { return x.distance <= reached; })) break;
+        reached = k;
+        uint32_t minLength = (uint32_t)std::max(m - k, 0);
+        uint32_t maxLength = (uint32_t)(m + k);
+
+        if (occurrences < 2 * k + 1) {
+            uint32_t from = lengthBound(byLength, 0, (uint32_t)byLength.size(), minLength);
+            uint32_t to = lengthBound(byLength, from, (uint32_t)byLength.size(), maxLength + 1);
+            for (uint32_t p = from; p < to; p++) verify(byLength[p]);
+            continue;
+        }
+
+        for (int g = 0; g < gramCount; g++) {
+            size_t at = std::lower_bound(gramKeys.begin(), gramKeys.end(), grams[g].gram) - gramKeys.begin();
+            if (at == gramKeys.size() || gramKeys[at] != grams[g].gram) {
+                grams[g].begin = grams[g].end = 0;
+                continue;
+            }
+            grams[g].begin = lengthBound(postings, gramOffsets[at], gramOffsets[at + 1], minLength);
+            grams[g].end = lengthBound(postings, grams[g].begin, gramOffsets[at + 1], maxLength + 1);
+        }
+        std::sort(grams, grams + gramCount, [](const QueryGram& a, const QueryGram& b) {
+            return a.end - a.begin < b.end - b.begin;
+        });
+
+        int probe = std::min(occurrences, 2 * k + 3);
+        int threshold = probe - 2 * k;
+        int left = probe;
+        for (int g = 0; g < gramCount && left > 0; g++) {
+            int take = std::min(grams[g].count, left);
+            left -= take;
+            for (uint32_t p = grams[g].begin; p < grams[g].end; p++) {
+                uint32_t i = postings[p];
+                int before = shared[i];
+                int after = before + std::min<int>(postingCounts[p], take);
+                if (before == 0) touched.push_back(i);
+                shared[i] = (uint8_t)after;
+                if (before < threshold && after >= threshold) verify(i);
+            }
+        }
+        for (uint32_t i : touched) shared[i] = 0;
+        touched.clear();
+    }
+
+    // Entry order is name order, so it breaks the remaining ties
+    std::sort(matches.begin(), matches.end(), [](const Match& a, const Match& b) {
+        if (a.distance != b.distance) return a.distance < b.distance;
+        if (a.passengers != b.passengers) return a.passengers > b.passengers;
+        return a.entry < b.entry;
+    });
+    for (size_t i = 0; i < matches.size() && i < limit; i++) {
+        if (matches[i].distance > reached) break;
+        const Entry& e = entries[matches[i].entry];
+        results.push_back({std::string(displayName(e), e.length), e.stationId});
+    }
     return results;
 }
 
@@ -124,8 +452,7 @@ std::vector<std::pair<std::string, int>> StationBST::listMatchingStations(const
 // ======================================================================================
 
 std::vector<Station> allStations;
-std::unordered_map<std::string, int> stationNameToId;
-std::unordered_map<int, std::string> stationIdToName;
+StationDirectory stationDirectory;
 std::vector<std::vector<Edge>> adj;
 
 // ======================================================================================
@@ -159,140 +486,31 @@ std::string getLineName(LineType l) {
 //                                   STATION INITIALIZATION
 // ======================================================================================
 
-void initializeStations(StationBST& stationDirectory, RailwayNetwork* mumbaiLocal) {
-    // WESTERN LINE (37 stations: Churchgate to Virar)
-    std::vector<std::string> western = {
-        "Churchgate", "Marine Lines", "Charni Road", "Grant Road", 
-        "Mumbai Central", "Lower Parel", "Elphinstone Road", "Dadar", 
-        "Mahalaxmi", "Byculla", "Worli", "Bandra", "Mahim Junction", 
-        "Bombay Central", "Andheri", "Vile Parle", "Vilhedev Station", 
-        "Jogeshwari", "Goregaon", "Malad", "Borivali", "Dahisar", 
-        "Mira Road", "Bhayandar", "Vasai Road", "Virar East", "Virar"
-    };
-    
-    // CENTRAL LINE (25 stations: CST to Ulhasnagar)
-    std::vector<std::string> central = {
-        "CST", "Masjid", "Sandhurst Road", "Byculla", "Dadar", 
-        "Grant Road", "Parel", "Sion", "Kurla", "Vidyavihar",
-        "Ghatkopar", "Vikhroli", "Kanjur Marg", "Mulund", "Thane",
-        "Mulund East", "Vangani", "Kalyan", "Vithalwadi", "Ulhasnagar",
-        "Ambernath", "Badlapur", "Kasara", "Dombivli East", "Dombivli"
-    };
-    
-    // HARBOUR LINE (20 stations: CST to Panvel)
-    std::vector<std::string> harbour = {
-        "CST", "Dockyard Road", "Cotton Green", "Reay Road", "Govandi",
-        "Mankhurd", "Vashi", "Turbhe", "New Panvel", "Nerul",
-        "Seawood-Darave", "Belapur CBD", "Belapur", "Kharghar", "Panvel",
-        "Khandeshwar", "Uran", "Penned", "Dahanu", "Panvel Central"
-    };
-    
-    // TRANS-HARBOUR LINE (17 stations: Shivaji Maharaj Terminus to Panvel)
-    std::vector<std::string> transHarbour = {
-        "Shivaji Maharaj Terminus", "Byculla", "Mazagon", "Wadala",
-        "Sewri", "Vashi", "Turbhe", "Nerul", "Seawood", "Belapur",
-        "Kharghar", "Panvel", "Khandeshwar", "Alibaug", "Murud",
-        "Kashid", "Dapoli"
-    };
-
-    int idCounter = 0;
-
-    // Lambda function to add or get existing station (case-insensitive)
-    auto addOrGetStation = [&](std::string name, LineType line) -> int {
-        // Convert to lowercase for case-insensitive lookup
-        std::string nameLower = name;
-        std::transform(nameLower.begin(), nameLower.end(), nameLower.begin(), ::tolower);
-        
-        // Check if station already exists
-        if (stationNameToId.find(nameLower) != stationNameToId.end()) {
-            int existingId = stationNameToId[nameLower];
-            allStations[existingId].isInterchange = true;
-            return existingId;
-        }
-        
-        Station s(idCounter, name, line);
-        allStations.push_back(s);
-        stationNameToId[nameLower] = idCounter;  // Store with lowercase key
-        stationIdToName[idCounter] = name;
-        stationDirectory.addStation(name, idCounter);
-        return idCounter++;
-    };
-
-    // Add Western Line stations
-    for (const auto& s : western) {
-        addOrGetStation(s, WESTERN);
+void initializeStations(StationDirectory& stationDirectory, RailwayNetwork* mumbaiLocal) {
+    // Stations come from the compile-time catalogue (id = catalogue index)
+    for (int id = 0; id < CATALOGUE_SIZE; id++) {
+        allStations.push_back(Station(id, STATION_CATALOGUE[id].name, STATION_CATALOGUE[id].line));
     }
 
-    // Add Central Line stations
-    for (const auto& s : central) {
-        addOrGetStation(s, CENTRAL);
+    // A stop on a line other than the station's first line is an interchange
+    for (const auto& route : CATALOGUE_ROUTES) {
+        for (int i = 0; i < route.stopCount; i++) {
+            if (STATION_CATALOGUE[route.stops[i]].line != route.line) {
+                allStations[route.stops[i]].isInterchange = true;
+            }
+        }
     }
 
-    // Add Harbour Line stations
-    for (const auto& s : harbour) {
-        addOrGetStation(s, HARBOUR);
-    }
-    
-    // Add Trans-Harbour Line stations
-    for (const auto& s : transHarbour) {
-        addOrGetStation(s, TRANS_HARBOUR);
-    }
+    // Station set is final: build the name index once
+    stationDirectory.build(allStations);
 
-    // Connect stations with realistic distances and times
-    
-    // WESTERN LINE: Connect sequential stations (2-4 km, 3-5 min)
-    for (size_t i = 0; i < western.size() - 1; ++i) {
-        std::string uNameLower = western[i];
-        std::transform(uNameLower.begin(), uNameLower.end(), uNameLower.begin(), ::tolower);
-        std::string vNameLower = western[i + 1];
-        std::transform(vNameLower.begin(), vNameLower.end(), vNameLower.begin(), ::tolower);
-        
-        int u_id = stationNameToId[uNameLower];
-        int v_id = stationNameToId[vNameLower];
-        int distance = 2 + (rand() % 3);  // 2-4 km
-        int time = 3 + (rand() % 3);      // 3-5 min
-        mumbaiLocal->addTrack(u_id, v_id, time, distance, WESTERN);
-    }
-    
-    // CENTRAL LINE: Connect sequential stations (2-4 km, 3-5 min)
-    for (size_t i = 0; i < central.size() - 1; ++i) {
-        std::string uNameLower = central[i];
-        std::transform(uNameLower.begin(), uNameLower.end(), uNameLower.begin(), ::tolower);
-        std::string vNameLower = central[i + 1];
-        std::transform(vNameLower.begin(), vNameLower.end(), vNameLower.begin(), ::tolower);
-        
-        int u_id = stationNameToId[uNameLower];
-        int v_id = stationNameToId[vNameLower];
-        int distance = 2 + (rand() % 3);  // 2-4 km
-        int time = 3 + (rand() % 3);      // 3-5 min
-        mumbaiLocal->addTrack(u_id, v_id, time, distance, CENTRAL);
-    }
-    
-    // HARBOUR LINE: Connect sequential stations (3-5 km, 4-6 min)
-    for (size_t i = 0; i < harbour.size() - 1; ++i) {
-        std::string uNameLower = harbour[i];
-        std::transform(uNameLower.begin(), uNameLower.end(), uNameLower.begin(), ::tolower);
-        std::string vNameLower = harbour[i + 1];
-        std::transform(vNameLower.begin(), vNameLower.end(), vNameLower.begin(), ::tolower);
-        
-        int u_id = stationNameToId[uNameLower];
-        int v_id = stationNameToId[vNameLower];
-        int distance = 3 + (rand() % 3);  // 3-5 km
-        int time = 4 + (rand() % 3);      // 4-6 min
-        mumbaiLocal->addTrack(u_id, v_id, time, distance, HARBOUR);
-    }
-    
-    // TRANS-HARBOUR LINE: Connect sequential stations (4-6 km, 5-7 min)
-    for (size_t i = 0; i < transHarbour.size() - 1; ++i) {
-        std::string uNameLower = transHarbour[i];
-        std::transform(uNameLower.begin(), uNameLower.end(), uNameLower.begin(), ::tolower);
-        std::string vNameLower = transHarbour[i + 1];
-        std::transform(vNameLower.begin(), vNameLower.end(), vNameLower.begin(), ::tolower);
-        
-        int u_id = stationNameToId[uNameLower];
-        int v_id = stationNameToId[vNameLower];
-        int distance = 4 + (rand() % 3);  // 4-6 km
-        int time = 5 + (rand() % 3);      // 5-7 min
-        mumbaiLocal->addTrack(u_id, v_id, time, distance, TRANS_HARBOUR);
+    // Connect sequential stops with realistic distances and times
+    // (Western/Central 2-4 km 3-5 min, Harbour 3-5 km 4-6 min, Trans-Harbour 4-6 km 5-7 min)
+    for (const auto& route : CATALOGUE_ROUTES) {
+        for (int i = 0; i + 1 < route.stopCount; i++) {
+            int distance = route.minDistance + (rand() % 3);
+            int time = route.minTime + (rand() % 3);
+            mumbaiLocal->addTrack(route.stops[i], route.stops[i + 1], time, distance, route.line);
+        }
     }
 }
@@ -0,0 +1,28 @@
+/**
+ * ======================================================================================
+ * IMPLEMENTATION: string_table.cpp
+ * DESCRIPTION: String interning for train names
+ * ======================================================================================
+ */
+
+#include "../include/string_table.h"
+
+/**
+ * Function: intern
+ * Returns the id of 's', adding it to the table on first sight
+ * Time Complexity: O(length) average
+ */
+uint32_t StringTable::intern(const std::string& s) {
+    auto it = ids.find(s);
+    if (it != ids.end()) return it->second;
+
+    uint32_t id = strings.size();
+    strings.push_back(s);
+    ids.insert({s, id});
+    return id;
+}
+
+uint32_t StringTable::intern(const char* s, size_t length) {
+    scratch.assign(s, length);   // Reuses scratch's capacity - no allocation when known
+    return intern(scratch);
+}
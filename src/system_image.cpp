@@ -0,0 +1,367 @@
+/**
+ * ======================================================================================
+ * IMPLEMENTATION: system_image.cpp
+ * DESCRIPTION: Binary system image - writer, checksum, mmap loader with offset
+ *              fix-ups, and bulk install into the live structures
+ *
+ * KEY FEATURES:
+ * - Fixed-width little-endian records, sections 8-byte aligned
+ * - Graph stored as CSR arrays (row offsets + edges)
+ * - Startup schedule reused only while its inputs are unchanged
+ * ======================================================================================
+ */
+
+#include "../include/system_image.h"
+#include "../include/globals.h"
+#include "../include/csv_manager.h"
+#include "../include/service_loader.h"
+#include <cstdio>
+#include <cstring>
+#include <sys/stat.h>
+
+namespace {
+
+const char IMAGE_MAGIC[8] = "CMTIMG1";
+
+const uint64_t FNV64_OFFSET = 14695981039346656037ULL;
+const uint64_t FNV64_PRIME = 1099511628211ULL;
+
+uint64_t fnv64(const char* data, size_t length, uint64_t hash = FNV64_OFFSET) {
+    for (size_t i = 0; i < length; i++) {
+        hash ^= (unsigned char)data[i];
+        hash *= FNV64_PRIME;
+    }
+    return hash;
+}
+
+SourceStamp stampOf(const std::string& path) {
+    SourceStamp stamp = { -1, 0 };
+    struct stat st;
+    if (stat(path.c_str(), &st) == 0) {
+        stamp.size = (int64_t)st.st_size;
+        stamp.modified = (int64_t)st.st_mtime;
+    }
+    return stamp;
+}
+
+bool sameStamp(const SourceStamp& a, const SourceStamp& b) {
+    return a.size == b.size && a.modified == b.modified;
+}
+
+// Appends a section's bytes to the payload, 8-byte aligned
+template <typename T>
+void addSection(std::string& payload, ImageSection& section, const T* data, size_t count) {
+    payload.append((8 - payload.size() % 8) % 8, '\0');
+    section.offset = sizeof(ImageHeader) + payload.size();
+    section.count = count;
+    section.bytes = count * sizeof(T);
+    if (count > 0) payload.append((const char*)data, section.bytes);
+}
+
+} // namespace
+
+// ======================================================================================
+//                                   CAPTURE / WRITE
+// ======================================================================================
+
+uint64_t hashGraph() {
+    uint64_t hash = FNV64_OFFSET;
+    for (size_t u = 0; u < adj.size(); u++) {
+        int32_t row[2] = { (int32_t)u, (int32_t)adj[u].size() };
+        hash = fnv64((const char*)row, sizeof(row), hash);
+        for (const auto& e : adj[u]) {
+            ImageEdge edge = { e.to, e.weight, e.distance, (int32_t)e.line };
+            hash = fnv64((const char*)&edge, sizeof(edge), hash);
+        }
+    }
+    return hash;
+}
+
+/**
+ * Function: captureSchedule
+ * Copies the scheduler's trains (heap order), metadata and itineraries
+ * into image form, stamped with the inputs it was built from
+ */
+ScheduleImage captureSchedule(const Scheduler& scheduler) {
+    ScheduleImage image;
+    image.valid = true;
+    image.graphHash = hashGraph();
+    image.timetable = stampOf(CSVManager::TIMETABLE_FILE);
+    image.services = stampOf(ServiceLoader::SERVICE_FILE);
+    image.trains = scheduler.getScheduledTrains();
+    image.info.reserve(image.trains.size());
+    image.stopOffsets.reserve(image.trains.size() + 1);
+    image.stopOffsets.push_back(0);
+
+    // Each distinct name once in the string pool
+    std::unordered_map<uint32_t, std::pair<uint32_t, uint32_t> > nameSlots;
+    for (const auto& t : image.trains) {
+        const TrainInfo* info = scheduler.getTrainInfo(t.trainId);
+        ImageTrainInfo record = { t.trainId, info ? info->capacity : DEFAULT_TRAIN_CAPACITY, 0, 0 };
+        if (info) {
+            auto slot = nameSlots.find(info->nameId);
+            if (slot == nameSlots.end()) {
+                const std::string& name = trainNames.get(info->nameId);
+                slot = nameSlots.insert(std::make_pair(info->nameId,
+                           std::make_pair((uint32_t)image.names.size(), (uint32_t)name.size()))).first;
+                image.names += name;
+            }
+            record.nameOffset = slot->second.first;
+            record.nameLength = slot->second.second;
+        }
+        image.info.push_back(record);
+
+        scheduler.appendItinerary(t.trainId, image.stops);
+        image.stopOffsets.push_back((uint32_t)image.stops.size());
+    }
+    return image;
+}
+
+/**
+ * Function: writeSystemImage
+ * Builds the payload in memory (stations, CSR graph, strings, schedule), checksums it and replaces the image atomically
+ */
+bool writeSystemImage(uint64_t networkSeq, const ScheduleImage& schedule, const std::string& path) {
+    ImageHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, IMAGE_MAGIC, sizeof(header.magic));
+    header.version = SYSTEM_IMAGE_VERSION;
+    header.sectionCount = IMAGE_SECTION_COUNT;
+    header.networkSeq = networkSeq;
+    header.timetable.size = header.services.size = -1;
+
+    // Strings: station names, then train names
+    std::string strings;
+    std::vector<ImageStation> stations;
+    stations.reserve(allStations.size());
+    for (const auto& s : allStations) {
+        ImageStation record = { s.id, (int32_t)s.line, s.platforms, s.passengerCount,
+                                s.isInterchange ? 1 : 0, (uint32_t)strings.size(),
+                                (uint32_t)s.name.size(), 0 };
+        strings += s.name;
+        stations.push_back(record);
+    }
+
+    std::vector<uint32_t> edgeOffsets(1, 0);
+    std::vector<ImageEdge> edges;
+    for (const auto& row : adj) {
+        for (const auto& e : row) {
+            ImageEdge edge = { e.to, e.weight, e.distance, (int32_t)e.line };
+            edges.push_back(edge);
+        }
+        edgeOffsets.push_back((uint32_t)edges.size());
+    }
+
+    std::vector<ImageTrainInfo> info;
+    if (schedule.valid) {
+        header.scheduleGraphHash = schedule.graphHash;
+        header.timetable = schedule.timetable;
+        header.services = schedule.services;
+        uint32_t base = (uint32_t)strings.size();
+        strings += schedule.names;
+        info = schedule.info;
+        for (auto& record : info) record.nameOffset += base;
+    }
+
+    std::string payload;
+    addSection(payload, header.sections[IMAGE_STATIONS], stations.data(), stations.size());
+    addSection(payload, header.sections[IMAGE_EDGE_OFFSETS], edgeOffsets.data(), edgeOffsets.size());
+    addSection(payload, header.sections[IMAGE_EDGES], edges.data(), edges.size());
+    addSection(payload, header.sections[IMAGE_STRINGS], strings.data(), strings.size());
+    if (schedule.valid) {
+        addSection(payload, header.sections[IMAGE_TRAINS], schedule.trains.data(), schedule.trains.size());
+        addSection(payload, header.sections[IMAGE_TRAIN_INFO], info.data(), info.size());
+        addSection(payload, header.sections[IMAGE_STOP_OFFSETS], schedule.stopOffsets.data(),
+                   schedule.stopOffsets.size());
+        addSection(payload, header.sections[IMAGE_STOPS], schedule.stops.data(), schedule.stops.size());
+    } else {
+        for (int s = IMAGE_TRAINS; s < IMAGE_SECTION_COUNT; s++) {
+            addSection(payload, header.sections[s], (const char*)NULL, 0);
+        }
+    }
+    header.payloadBytes = payload.size();
+    header.checksum = fnv64(payload.data(), payload.size());
+
+    std::string tmpPath = path + ".tmp";
+    FILE* file = fopen(tmpPath.c_str(), "wb");
+    if (!file) return false;
+    bool ok = fwrite(&header, 1, sizeof(header), file) == sizeof(header);
+    ok = ok && fwrite(payload.data(), 1, payload.size(), file) == payload.size();
+    ok = (fclose(file) == 0) && ok;
+    if (!ok) {
+        remove(tmpPath.c_str());
+        return false;
+    }
+#ifdef _WIN32
+    remove(path.c_str());   // rename() does not replace on Windows
+#endif
+    return rename(tmpPath.c_str(), path.c_str()) == 0;
+}
+
+// ======================================================================================
+//                                   LOADER
+// ======================================================================================
+
+SystemImage::SystemImage()
+    : valid(false), stations(NULL), edgeOffsets(NULL), edges(NULL), strings(NULL),
+      trains(NULL), trainInfo(NULL), stopOffsets(NULL), stops(NULL) {
+    memset(&header, 0, sizeof(header));
+}
+
+// Fix-up: section offset -> pointer into the mapping (NULL if out of bounds)
+const char* SystemImage::section(int id, size_t elementSize) const {
+    const ImageSection& s = header.sections[id];
+    if (s.offset % 8 != 0 || s.bytes != s.count * elementSize) return NULL;
+    if (s.offset < sizeof(ImageHeader) || s.offset + s.bytes > file.size()) return NULL;
+    return file.begin() + s.offset;
+}
+
+std::string SystemImage::text(uint32_t offset, uint32_t length) const {
+    return std::string(strings + offset, length);
+}
+
+/**
+ * Function: open
+ * Maps the image, verifies header and checksum, resolves section pointers
+ * and checks every cross-reference (string ranges, CSR offsets, edge
+ * targets, itinerary ranges) so install never reads out of bounds
+ *
+ * Returns: false if the image is missing, from another version, or damaged
+ */
+bool SystemImage::open(const std::string& path) {
+    close();
+    if (!file.open(path) || file.size() < sizeof(ImageHeader)) return false;
+    memcpy(&header, file.begin(), sizeof(header));
+    if (memcmp(header.magic, IMAGE_MAGIC, sizeof(header.magic)) != 0) return false;
+    if (header.version != SYSTEM_IMAGE_VERSION || header.sectionCount != IMAGE_SECTION_COUNT) return false;
+    if (header.payloadBytes != file.size() - sizeof(ImageHeader)) return false;
+    if (fnv64(file.begin() + sizeof(ImageHeader), header.payloadBytes) != header.checksum) return false;
+
+    stations = (const ImageStation*)section(IMAGE_STATIONS, sizeof(ImageStation));
+    edgeOffsets = (const uint32_t*)section(IMAGE_EDGE_OFFSETS, sizeof(uint32_t));
+    edges = (const ImageEdge*)section(IMAGE_EDGES, sizeof(ImageEdge));
+    strings = section(IMAGE_STRINGS, 1);
+    trains = (const Train*)section(IMAGE_TRAINS, sizeof(Train));
+    trainInfo = (const ImageTrainInfo*)section(IMAGE_TRAIN_INFO, sizeof(ImageTrainInfo));
+    stopOffsets = (const uint32_t*)section(IMAGE_STOP_OFFSETS, sizeof(uint32_t));
+    stops = (const TrainStop*)section(IMAGE_STOPS, sizeof(TrainStop));
+    if (!stations || !edgeOffsets || !edges || !strings ||
+        !trains || !trainInfo || !stopOffsets || !stops) return false;
+
+    const ImageSection* s = header.sections;
+    uint64_t stationCount = s[IMAGE_STATIONS].count;
+    uint64_t stringBytes = s[IMAGE_STRINGS].count;
+    uint64_t vertices = s[IMAGE_EDGE_OFFSETS].count - 1;
+    if (s[IMAGE_EDGE_OFFSETS].count == 0) return false;
+
+    for (uint64_t i = 0; i < stationCount; i++) {
+        if ((uint64_t)stations[i].nameOffset + stations[i].nameLength > stringBytes) return false;
+    }
+    if (edgeOffsets[0] != 0 || edgeOffsets[vertices] != s[IMAGE_EDGES].count) return false;
+    for (uint64_t u = 0; u < vertices; u++) {
+        if (edgeOffsets[u] > edgeOffsets[u + 1]) return false;
+    }
+    for (uint64_t e = 0; e < s[IMAGE_EDGES].count; e++) {
+        if (edges[e].to < 0 || (uint64_t)edges[e].to >= vertices) return false;
+    }
+
+    uint64_t trainCount = s[IMAGE_TRAINS].count;
+    if (trainCount > 0) {
+        if (s[IMAGE_TRAIN_INFO].count != trainCount || s[IMAGE_STOP_OFFSETS].count != trainCount + 1) return false;
+        if (stopOffsets[0] != 0 || stopOffsets[trainCount] != s[IMAGE_STOPS].count) return false;
+        for (uint64_t t = 0; t < trainCount; t++) {
+            if (stopOffsets[t] > stopOffsets[t + 1]) return false;
+            if ((uint64_t)trainInfo[t].nameOffset + trainInfo[t].nameLength > stringBytes) return false;
+        }
+    }
+    valid = true;
+    return true;
+}
+
+void SystemImage::close() {
+    file.close();
+    valid = false;
+}
+
+/**
+ * Function: installNetwork
+ * Replaces allStations, adj rows and the station directory with the
+ * image contents
+ *
+ * Returns: false (nothing changed) if the image graph is larger than adj
+ */
+bool SystemImage::installNetwork(StationDirectory& directory) {
+    if (!valid) return false;
+    const ImageSection* s = header.sections;
+    uint64_t stationCount = s[IMAGE_STATIONS].count;
+    uint64_t vertices = s[IMAGE_EDGE_OFFSETS].count - 1;
+    if (vertices > adj.size() || stationCount > adj.size()) return false;
+
+    allStations.clear();
+    allStations.reserve(stationCount);
+    for (uint64_t i = 0; i < stationCount; i++) {
+        const ImageStation& r = stations[i];
+        Station station(r.id, text(r.nameOffset, r.nameLength), (LineType)r.line, r.platforms);
+        station.passengerCount = r.passengerCount;
+        station.isInterchange = (r.interchange == 1);
+        allStations.push_back(std::move(station));
+    }
+
+    // CSR slice -> adjacency row, sized exactly
+    for (uint64_t u = 0; u < adj.size(); u++) {
+        adj[u].clear();
+        if (u >= vertices) continue;
+        adj[u].reserve(edgeOffsets[u + 1] - edgeOffsets[u]);
+        for (uint32_t e = edgeOffsets[u]; e < edgeOffsets[u + 1]; e++) {
+            Edge edge = { edges[e].to, edges[e].weight, edges[e].distance, (LineType)edges[e].line };
+            adj[u].push_back(edge);
+        }
+    }
+
+    directory.build(allStations);
+    return true;
+}
+
+bool SystemImage::scheduleIsCurrent() const {
+    if (!valid || header.sections[IMAGE_TRAINS].count == 0) return false;
+    return sameStamp(header.timetable, stampOf(CSVManager::TIMETABLE_FILE)) &&
+           sameStamp(header.services, stampOf(ServiceLoader::SERVICE_FILE)) &&
+           header.scheduleGraphHash == hashGraph();
+}
+
+/**
+ * Function: installSchedule
+ * Bulk-loads the stored trains (one heap build) and their itineraries;
+ * 'startup' receives the same schedule for the next image write
+ */
+bool SystemImage::installSchedule(Scheduler& scheduler, ScheduleImage& startup) const {
+    if (!scheduleIsCurrent()) return false;
+    uint64_t trainCount = header.sections[IMAGE_TRAINS].count;
+
+    TrainBatch batch;
+    batch.reserve(trainCount);
+    std::unordered_map<uint64_t, uint32_t> nameIds;     // (offset, length) -> interned id
+    for (uint64_t t = 0; t < trainCount; t++) {
+        const ImageTrainInfo& info = trainInfo[t];
+        uint64_t key = ((uint64_t)info.nameOffset << 32) | info.nameLength;
+        auto known = nameIds.find(key);
+        if (known == nameIds.end()) {
+            known = nameIds.insert(std::make_pair(key,
+                        trainNames.intern(strings + info.nameOffset, info.nameLength))).first;
+        }
+        batch.trains.push_back(trains[t]);
+        TrainInfo cold = { known->second, info.capacity };
+        batch.info.push_back(cold);
+    }
+    scheduler.scheduleTrains(std::move(batch));
+
+    std::vector<TrainStop> itinerary;
+    for (uint64_t t = 0; t < trainCount; t++) {
+        if (stopOffsets[t] == stopOffsets[t + 1]) continue;
+        itinerary.assign(stops + stopOffsets[t], stops + stopOffsets[t + 1]);
+        scheduler.setItinerary(trains[t].trainId, itinerary);
+    }
+
+    startup = captureSchedule(scheduler);
+    return true;
+}
@@ -0,0 +1,487 @@
+/**
+ * ======================================================================================
+ * IMPLEMENTATION: ticket_archive.cpp
+ * DESCRIPTION: Per-service-day ticket partitions - sealing closed days out of
+ *              tickets.csv, footer-only summaries and partition pruning
+ *
+ * KEY FEATURES:
+ * - tickets.csv only holds the open day; every closed day is one compressed
+ *   segment (delta + varint + dictionaries)
+ * - Footer: row count, entryTime min/max, revenue, per-station totals
+ * - Range and station queries skip whole partitions from their footers
+ * - Daily reports read footers only (no column is mapped)
+ * ======================================================================================
+ */
+
+#include "../include/ticket_archive.h"
+#include "../include/csv_manager.h"
+#include "../include/station.h"
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <cerrno>
+#include <map>
+#include <algorithm>
+#include <sys/stat.h>
+#include <fcntl.h>
+
+#ifdef _WIN32
+    #include <windows.h>
+    #include <direct.h>
+    #include <io.h>
+    #define MKDIR(path) _mkdir(path)
+#else
+    #include <dirent.h>
+    #include <unistd.h>
+    #define MKDIR(path) mkdir(path, 0777)
+#endif
+
+namespace {
+
+const char PARTITION_MAGIC[8] = "TKTDAY1";
+const char PARTITION_PREFIX[] = "tickets-";
+const char PARTITION_SUFFIX[] = ".seg";
+const char LEGACY_SUFFIX[] = ".col";        // Columnar partitions before segments
+
+/**
+ * Service day lookups for a run of tickets: localtime() only when a ticket
+ * falls outside the cached day (tickets.csv is written in time order)
+ */
+class ServiceDayCache {
+    time_t dayStart;
+    int day;
+
+public:
+    ServiceDayCache() : dayStart(0), day(-1) {}
+
+    int resolve(time_t t) {
+        if (day < 0 || t < dayStart || t >= dayStart + 86400) {
+            tm local = *localtime(&t);
+            day = (local.tm_year + 1900) * 10000 + (local.tm_mon + 1) * 100 + local.tm_mday;
+            dayStart = t - (local.tm_hour * 3600 + local.tm_min * 60 + local.tm_sec);
+        }
+        return day;
+    }
+};
+
+// Full-row order: entryTime first, so a partition is written in time order
+bool rowLess(const Passenger& a, const Passenger& b) {
+    if (a.entryTime != b.entryTime) return a.entryTime < b.entryTime;
+    if (a.id != b.id) return a.id < b.id;
+    if (a.sourceId != b.sourceId) return a.sourceId < b.sourceId;
+    if (a.destId != b.destId) return a.destId < b.destId;
+    if (a.ticketPrice != b.ticketPrice) return a.ticketPrice < b.ticketPrice;
+    if (a.age != b.age) return a.age < b.age;
+    if (a.type != b.type) return a.type < b.type;
+    return a.name < b.name;
+}
+
+bool rowEqual(const Passenger& a, const Passenger& b) {
+    return a.entryTime == b.entryTime && a.id == b.id && a.sourceId == b.sourceId &&
+           a.destId == b.destId && a.ticketPrice == b.ticketPrice && a.age == b.age &&
+           a.type == b.type && a.name == b.name;
+}
+
+bool replaceFile(const std::string& from, const std::string& to) {
+#ifdef _WIN32
+    remove(to.c_str());     // rename() does not replace on Windows
+#endif
+    return rename(from.c_str(), to.c_str()) == 0;
+}
+
+/**
+ * Forces a written file, or a directory's entries (renames), to disk.
+ * Windows cannot open a directory for _commit; NTFS journals the rename.
+ */
+bool syncPath(const std::string& path, bool directory) {
+#ifdef _WIN32
+    if (directory) return true;
+    int fd = _open(path.c_str(), _O_RDWR | _O_BINARY);
+    if (fd < 0) return false;
+    bool ok = _commit(fd) == 0;
+    _close(fd);
+#else
+    (void)directory;
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    bool ok = ::fsync(fd) == 0;
+    ::close(fd);
+#endif
+    return ok;
+}
+
+std::string parentDirectory(const std::string& path) {
+    size_t slash = path.find_last_of("/\\");
+    return slash == std::string::npos ? "." : path.substr(0, slash);
+}
+
+/**
+ * Builds the bytes that follow the columns: StationTotals[] then the footer
+ */
+std::string buildFooter(int serviceDay, const std::vector<Passenger>& tickets) {
+    PartitionFooter footer;
+    memset(&footer, 0, sizeof(footer));
+    memcpy(footer.magic, PARTITION_MAGIC, sizeof(footer.magic));
+    footer.version = TICKET_PARTITION_VERSION;
+    footer.serviceDay = serviceDay;
+    footer.rows = tickets.size();
+
+    int stationCount = 0;
+    for (const auto& t : tickets) {
+        if (t.sourceId >= 0 && t.sourceId < MAX_STATIONS) stationCount = std::max(stationCount, t.sourceId + 1);
+        if (t.destId >= 0 && t.destId < MAX_STATIONS) stationCount = std::max(stationCount, t.destId + 1);
+    }
+    StationTotals zero = {0, 0, 0};
+    std::vector<StationTotals> totals(stationCount, zero);
+
+    for (size_t i = 0; i < tickets.size(); i++) {
+        const Passenger& t = tickets[i];
+        int64_t entry = (int64_t)t.entryTime;
+        if (i == 0 || entry < footer.minEntryTime) footer.minEntryTime = entry;
+        if (i == 0 || entry > footer.maxEntryTime) footer.maxEntryTime = entry;
+        footer.revenue += t.ticketPrice;
+
+        bool indexed = true;
+        if (t.sourceId >= 0 && t.sourceId < stationCount) {
+            totals[t.sourceId].departures++;
+            totals[t.sourceId].revenue += t.ticketPrice;
+        } else {
+            indexed = false;
+        }
+        if (t.destId >= 0 && t.destId < stationCount) totals[t.destId].arrivals++;
+        else indexed = false;
+        if (!indexed) footer.unindexedRows++;
+    }
+    footer.stationCount = (uint32_t)stationCount;
+
+    std::string bytes;
+    if (!totals.empty()) bytes.append((const char*)totals.data(), totals.size() * sizeof(StationTotals));
+    bytes.append((const char*)&footer, sizeof(footer));
+    return bytes;
+}
+
+/**
+ * Reads the footer and totals table from the end of a partition file
+ */
+bool readFooter(const std::string& path, TicketPartition& partition) {
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file) return false;
+    bool ok = fseek(file, 0, SEEK_END) == 0;
+    long size = ok ? ftell(file) : -1;
+    PartitionFooter& footer = partition.footer;
+    ok = size >= (long)(sizeof(SegmentHeader) + sizeof(footer)) &&
+         fseek(file, size - (long)sizeof(footer), SEEK_SET) == 0 &&
+         fread(&footer, 1, sizeof(footer), file) == sizeof(footer) &&
+         memcmp(footer.magic, PARTITION_MAGIC, sizeof(footer.magic)) == 0 &&
+         footer.version == TICKET_PARTITION_VERSION &&
+         footer.stationCount <= (uint32_t)MAX_STATIONS;
+    if (ok) {
+        long totalsBytes = (long)(footer.stationCount * sizeof(StationTotals));
+        long totalsAt = size - (long)sizeof(footer) - totalsBytes;
+        partition.stations.resize(footer.stationCount);
+        ok = totalsAt >= (long)sizeof(SegmentHeader) && fseek(file, totalsAt, SEEK_SET) == 0 &&
+             (totalsBytes == 0 ||
+              fread(partition.stations.data(), 1, totalsBytes, file) == (size_t)totalsBytes);
+    }
+    fclose(file);
+    partition.path = path;
+    return ok;
+}
+
+// Service day encoded in a partition file name, or -1
+int partitionDay(const std::string& name, const char* suffixText = PARTITION_SUFFIX) {
+    size_t prefix = sizeof(PARTITION_PREFIX) - 1, suffix = strlen(suffixText);
+    if (name.size() != prefix + 8 + suffix) return -1;
+    if (name.compare(0, prefix, PARTITION_PREFIX) != 0) return -1;
+    if (name.compare(prefix + 8, suffix, suffixText) != 0) return -1;
+    int day = 0;
+    for (size_t i = prefix; i < prefix + 8; i++) {
+        if (name[i] < '0' || name[i] > '9') return -1;
+        day = day * 10 + (name[i] - '0');
+    }
+    return day;
+}
+
+std::vector<std::string> listDirectory(const std::string& dir) {
+    std::vector<std::string> names;
+#ifdef _WIN32
+    WIN32_FIND_DATAA entry;
+    HANDLE find = FindFirstFileA((dir + "\\*").c_str(), &entry);
+    if (find == INVALID_HANDLE_VALUE) return names;
+    do {
+        names.push_back(entry.cFileName);
+    } while (FindNextFileA(find, &entry));
+    FindClose(find);
+#else
+    DIR* handle = opendir(dir.c_str());
+    if (!handle) return names;
+    while (struct dirent* entry = readdir(handle)) names.push_back(entry->d_name);
+    closedir(handle);
+#endif
+    return names;
+}
+
+/**
+ * Gives every name in 'rows' an id and makes the new entries durable before
+ * a segment can refer to them; a newly created dictionary file also needs
+ * its directory entry synced
+ */
+bool internNames(const std::vector<Passenger>& rows, TicketNameDictionary& names,
+                 const std::string& dir) {
+    for (const auto& t : rows) names.intern(t.name);
+    struct stat info;
+    bool created = stat(nameDictionaryPath(dir).c_str(), &info) != 0;
+    return names.flush() && (!created || syncPath(dir, true));
+}
+
+/**
+ * Writes one day's partition: 'rows' merged with the rows already sealed
+ * for that day, exact duplicates dropped, in entryTime order. Existing
+ * partitions of either segment version are read; the result is version 2.
+ */
+bool writePartition(int day, std::vector<Passenger>& rows, const std::string& dir,
+                    TicketNameDictionary& names) {
+    std::string path = partitionPath(day, dir);
+    TicketSegment existing;
+    if (existing.open(path, &names)) {
+        std::vector<Passenger> sealed;
+        if (!existing.loadAll(sealed)) return false;
+        rows.insert(rows.end(), std::make_move_iterator(sealed.begin()),
+                    std::make_move_iterator(sealed.end()));
+    }
+    std::sort(rows.begin(), rows.end(), rowLess);
+    rows.erase(std::unique(rows.begin(), rows.end(), rowEqual), rows.end());
+    if (!internNames(rows, names, dir)) return false;
+    return writeTicketSegment(rows, path, buildFooter(day, rows), &names);
+}
+
+// Rewrites partitions still in the columnar layout as segments
+bool convertLegacyPartitions(const std::string& dir, TicketNameDictionary& names) {
+    for (const auto& name : listDirectory(dir)) {
+        int day = partitionDay(name, LEGACY_SUFFIX);
+        if (day < 0) continue;
+        std::string legacy = dir + "/" + name;
+        TicketStoreReader reader;
+        std::vector<Passenger> rows;
+        if (!reader.open(legacy) || !reader.loadAll(rows)) continue;    // Left for inspection
+        if (!writePartition(day, rows, dir, names)) return false;
+        remove(legacy.c_str());
+    }
+    return true;
+}
+
+} // namespace
+
+int serviceDayOf(time_t t) {
+    ServiceDayCache cache;
+    return cache.resolve(t);
+}
+
+std::string partitionPath(int serviceDay, const std::string& dir) {
+    char name[32];
+    snprintf(name, sizeof(name), "%s%08d%s", PARTITION_PREFIX, serviceDay, PARTITION_SUFFIX);
+    return dir + "/" + name;
+}
+
+std::string nameDictionaryPath(const std::string& dir) {
+    return dir + "/names.dict";
+}
+
+// ======================================================================================
+//                                   PARTITION FOOTER
+// ======================================================================================
+
+bool TicketPartition::mayMatch(const TicketFilter& filter) const {
+    if (footer.rows == 0) return false;
+    if (footer.maxEntryTime < filter.fromTime || footer.minEntryTime >= filter.toTime) return false;
+    if (filter.stationId >= 0 && footer.unindexedRows == 0) {
+        if (filter.stationId >= (int)stations.size()) return false;
+        const StationTotals& s = stations[filter.stationId];
+        if (s.departures == 0 && s.arrivals == 0) return false;
+    }
+    return true;
+}
+
+int TicketPartition::busiestOrigin() const {
+    int best = -1;
+    for (int i = 0; i < (int)stations.size(); i++) {
+        if (stations[i].departures > 0 && (best < 0 || stations[i].departures > stations[best].departures)) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+// ======================================================================================
+//                                   SEALING
+// ======================================================================================
+
+/**
+ * Function: sealTicketPartitions
+ * See header for the algorithm. Partitions are written and fsynced (file
+ * and archive directory) before tickets.csv is cut, so no ticket is ever
+ * only in memory or only in the page cache.
+ */
+long long sealTicketPartitions(time_t now, const std::string& dir) {
+    TicketNameDictionary names;
+    if (!names.open(nameDictionaryPath(dir), true)) return -1;
+    if (!convertLegacyPartitions(dir, names)) return -1;
+
+    std::vector<Passenger> tickets;
+    if (!CSVManager::loadTickets(tickets)) return 0;    // No tickets.csv yet
+
+    ServiceDayCache days;
+    int today = days.resolve(now);
+    std::map<int, std::vector<Passenger> > closed;
+    std::vector<Passenger> open;
+    for (auto& t : tickets) {
+        int day = days.resolve(t.entryTime);
+        if (day < today) closed[day].push_back(std::move(t));
+        else open.push_back(std::move(t));
+    }
+    if (closed.empty()) return 0;
+
+    struct stat info;
+    if (stat(dir.c_str(), &info) != 0) MKDIR(dir.c_str());
+
+    long long moved = 0;
+    for (auto& day : closed) {
+        moved += (long long)day.second.size();
+        if (!writePartition(day.first, day.second, dir, names)) return -1;
+    }
+    if (!syncPath(dir, true)) return -1;    // Partition renames durable first
+
+    // Only the open day stays in tickets.csv. tickets.col goes first: its
+    // freshness check is the CSV size, which a same-size cut would match.
+    std::string tmpPath = CSVManager::TICKET_FILE + ".tmp";
+    if (!CSVManager::saveTickets(open, tmpPath) || !syncPath(tmpPath, false) ||
+        (remove(TICKET_STORE_FILE) != 0 && errno != ENOENT) ||
+        !replaceFile(tmpPath, CSVManager::TICKET_FILE)) {
+        remove(tmpPath.c_str());
+        return -1;
+    }
+    syncPath(parentDirectory(CSVManager::TICKET_FILE), true);
+    return moved;
+}
+
+// ======================================================================================
+//                                   ARCHIVE
+// ======================================================================================
+
+/**
+ * Function: open
+ * Lists tickets-YYYYMMDD.seg in 'dir' and reads each footer; files with a
+ * bad footer are left out. Loads the name dictionary for the cursors.
+ * Returns: false if the directory has no readable partition
+ */
+bool TicketArchive::open(const std::string& dir) {
+    partitions.clear();
+    names.open(nameDictionaryPath(dir));    // Unreadable: version-2 segments fail to open
+    std::vector<std::string> names = listDirectory(dir);
+    std::vector<std::pair<int, std::string> > found;
+    for (const auto& name : names) {
+        int day = partitionDay(name);
+        if (day >= 0) found.push_back(std::make_pair(day, name));
+    }
+    std::sort(found.begin(), found.end());
+
+    for (const auto& entry : found) {
+        TicketPartition partition;
+        if (readFooter(dir + "/" + entry.second, partition) && partition.footer.serviceDay == entry.first) {
+            partitions.push_back(std::move(partition));
+        }
+    }
+    return !partitions.empty();
+}
+
+uint64_t TicketArchive::rows() const {
+    uint64_t total = 0;
+    for (const auto& p : partitions) total += p.footer.rows;
+    return total;
+}
+
+long long TicketArchive::revenue() const {
+    long long total = 0;
+    for (const auto& p : partitions) total += p.footer.revenue;
+    return total;
+}
+
+// ======================================================================================
+//                                   HISTORY CURSOR
+// ======================================================================================
+
+TicketHistoryCursor::TicketHistoryCursor()
+    : names(NULL), nextPartition(0), liveDone(true), fields(0), active(0),
+      partitionsSkipped(0), blocksSkipped(0), blocksScanned(0) {}
+
+/**
+ * Function: open
+ * Prunes partitions by footer; the live store (if any) is scanned last
+ * Returns: false if there is nothing to read at all
+ */
+bool TicketHistoryCursor::open(const TicketArchive& archive, const std::string& liveStore,
+                               const TicketFilter& filter, unsigned fields) {
+    this->filter = filter;
+    this->fields = fields;
+    this->liveStore = liveStore;
+    names = &archive.getNames();
+    partitions.clear();
+    nextPartition = 0;
+    liveDone = liveStore.empty();
+    active = 0;
+    partitionsSkipped = blocksSkipped = blocksScanned = 0;
+
+    for (const auto& p : archive.getPartitions()) {
+        if (p.mayMatch(filter)) partitions.push_back(p.path);
+        else partitionsSkipped++;
+    }
+    return !partitions.empty() || !liveDone;
+}
+
+// Opens the next readable file, carrying the finished cursor's counters over
+bool TicketHistoryCursor::openNext() {
+    if (active == 1) {
+        blocksSkipped += segmentCursor.getBlocksSkipped();
+        blocksScanned += segmentCursor.getBlocksScanned();
+    } else if (active == 2) {
+        blocksSkipped += cursor.getBlocksSkipped();
+        blocksScanned += cursor.getBlocksScanned();
+    }
+    active = 0;
+
+    while (nextPartition < partitions.size()) {
+        if (segment.open(partitions[nextPartition++], names) &&
+            segmentCursor.open(segment, filter, fields)) {
+            active = 1;
+            return true;
+        }
+    }
+    if (!liveDone) {
+        liveDone = true;
+        if (store.open(liveStore) && cursor.open(store, filter, fields)) {
+            active = 2;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool TicketHistoryCursor::next(TicketRecord& out) {
+    while (true) {
+        if (active == 1 && segmentCursor.next(out)) return true;
+        if (active == 2 && cursor.next(out)) return true;
+        if (!openNext()) return false;
+    }
+}
+
+uint32_t TicketHistoryCursor::getBlocksSkipped() const {
+    if (active == 1) return blocksSkipped + segmentCursor.getBlocksSkipped();
+    if (active == 2) return blocksSkipped + cursor.getBlocksSkipped();
+    return blocksSkipped;
+}
+
+uint32_t TicketHistoryCursor::getBlocksScanned() const {
+    if (active == 1) return blocksScanned + segmentCursor.getBlocksScanned();
+    if (active == 2) return blocksScanned + cursor.getBlocksScanned();
+    return blocksScanned;
+}
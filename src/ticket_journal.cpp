@@ -0,0 +1,395 @@
+/**
+ * ======================================================================================
+ * IMPLEMENTATION: ticket_journal.cpp
+ * DESCRIPTION: Group-commit ticket journal - booking threads hand tickets to a
+ *              lock-free buffer, one writer thread appends them to tickets.csv
+ *
+ * DATA STRUCTURES:
+ * - BoundedMPMCQueue<JournalEntry> between bookings and the writer
+ * - Reusable byte buffer: one batch of CSV rows -> one write() syscall
+ *
+ * KEY FEATURES:
+ * - Rows formatted by hand (no iostreams, no per-row allocation)
+ * - fsync per batch / per interval / never, chosen in JournalConfig
+ * - flush() durability barrier; flush and commit latency histograms
+ * ======================================================================================
+ */
+
+#include "../include/ticket_journal.h"
+#include "../include/mapped_csv.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstring>
+#include <cerrno>
+#include <sys/stat.h>
+#include <fcntl.h>
+
+#ifdef _WIN32
+    #include <io.h>
+    #define JOURNAL_OPEN(path) _open(path, _O_WRONLY | _O_CREAT | _O_APPEND | _O_BINARY, _S_IREAD | _S_IWRITE)
+    #define JOURNAL_WRITE _write
+    #define JOURNAL_FSYNC _commit
+    #define JOURNAL_CLOSE _close
+    #define JOURNAL_FSTAT(fd, st) _fstat(fd, st)
+    typedef struct _stat JournalStat;
+#else
+    #include <unistd.h>
+    #define JOURNAL_OPEN(path) ::open(path, O_WRONLY | O_CREAT | O_APPEND, 0644)
+    #define JOURNAL_WRITE ::write
+    #define JOURNAL_FSYNC ::fsync
+    #define JOURNAL_CLOSE ::close
+    #define JOURNAL_FSTAT(fd, st) ::fstat(fd, st)
+    typedef struct stat JournalStat;
+#endif
+
+namespace {
+
+const char* TICKET_HEADER = "id,name,age,type,sourceId,destId,ticketPrice,entryTime\n";
+const int IDLE_WAIT_MS = 20;    // Writer re-checks the buffer at least this often
+const int RETRY_WAIT_MS = 200;  // Pause between attempts at a failed batch
+const int CLOSE_RETRIES = 5;    // Attempts left for a failed batch once close() started
+
+long long steadyNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void appendInt(std::vector<char>& out, long long value) {
+    char digits[24];
+    int n = 0;
+    unsigned long long v = (value < 0) ? 0ULL - (unsigned long long)value : (unsigned long long)value;
+    do {
+        digits[n++] = (char)('0' + v % 10);
+        v /= 10;
+    } while (v > 0);
+    if (value < 0) out.push_back('-');
+    while (n > 0) out.push_back(digits[--n]);
+}
+
+// Same row layout as CSVManager::saveTickets (live tickets are only appended here)
+void appendRow(std::vector<char>& out, const Passenger& t) {
+    appendInt(out, t.id);
+    out.push_back(',');
+    appendCsvText(out, t.name);
+    out.push_back(',');
+    appendInt(out, t.age);
+    out.push_back(',');
+    appendInt(out, (int)t.type);
+    out.push_back(',');
+    appendInt(out, t.sourceId);
+    out.push_back(',');
+    appendInt(out, t.destId);
+    out.push_back(',');
+    appendInt(out, t.ticketPrice);
+    out.push_back(',');
+    appendInt(out, (long long)t.entryTime);
+    out.push_back('\n');
+}
+
+} // namespace
+
+// ======================================================================================
+//                                   LIFECYCLE
+// ======================================================================================
+
+TicketJournal::TicketJournal(const JournalConfig& config)
+    : config(config), pending(JOURNAL_BUFFER_CAPACITY), fd(-1), running(false),
+      writerIdle(false), failing(false), appendedCount(0), durableCount(0), lastFsyncNs(0) {
+    if (this->config.maxBatch < 1) this->config.maxBatch = 1;
+    stats.tickets = 0;
+    stats.batches = 0;
+    stats.bytes = 0;
+    stats.fsyncs = 0;
+}
+
+TicketJournal::~TicketJournal() {
+    close();
+}
+
+/**
+ * Function: open
+ * Opens the journal file for appending (header written if the file is new
+ * or empty) and starts the writer thread
+ *
+ * Returns: false if the file cannot be opened
+ */
+bool TicketJournal::open() {
+    if (fd >= 0) return true;
+    fd = JOURNAL_OPEN(config.path.c_str());
+    if (fd < 0) return false;
+
+    JournalStat st;
+    size_t headerWritten = 0;
+    if (JOURNAL_FSTAT(fd, &st) == 0 && st.st_size == 0 &&
+        !writeAll(TICKET_HEADER, strlen(TICKET_HEADER), headerWritten)) {
+        JOURNAL_CLOSE(fd);
+        fd = -1;
+        return false;
+    }
+
+    batch.reserve(config.maxBatch * 64);
+    batchQueuedNs.resize(config.maxBatch);
+    lastFsyncNs.store(steadyNowNs());
+    running.store(true);
+    writer = std::thread(&TicketJournal::writerLoop, this);
+    return true;
+}
+
+/**
+ * Function: close
+ * Stops accepting work, lets the writer drain the buffer, syncs and closes
+ *
+ * Returns: false if some appended tickets could not be persisted
+ */
+bool TicketJournal::close() {
+    if (fd < 0) return true;
+    {
+        std::lock_guard<std::mutex> guard(wakeLock);
+        running.store(false);
+    }
+    wake.notify_one();
+    writer.join();
+    bool ok = durableCount.load() == appendedCount.load();
+    if (config.durability != DURABILITY_NONE && !syncFile()) ok = false;
+    JOURNAL_CLOSE(fd);
+    fd = -1;
+    durable.notify_all();
+    return ok;
+}
+
+// ======================================================================================
+//                                   APPEND / FLUSH
+// ======================================================================================
+
+/**
+ * Function: append
+ * Copies the ticket into a buffer cell in place and returns; the writer
+ * thread persists it with the next batch
+ *
+ * Returns: false if the journal is not open
+ * Time Complexity: O(1) (yields while the buffer is full)
+ */
+bool TicketJournal::append(const Passenger& ticket) {
+    if (fd < 0) return false;
+    long long now = steadyNowNs();
+    auto fill = [&](JournalEntry& cell) {
+        cell.ticket.id = ticket.id;
+        cell.ticket.name.assign(ticket.name);
+        cell.ticket.age = ticket.age;
+        cell.ticket.type = ticket.type;
+        cell.ticket.sourceId = ticket.sourceId;
+        cell.ticket.destId = ticket.destId;
+        cell.ticket.ticketPrice = ticket.ticketPrice;
+        cell.ticket.entryTime = ticket.entryTime;
+        cell.queuedAtNs = now;
+    };
+    while (!pending.tryPushWith(fill)) {
+        wake.notify_one();
+        std::this_thread::yield();
+    }
+    appendedCount.fetch_add(1);
+
+    if (writerIdle.load()) {
+        std::lock_guard<std::mutex> guard(wakeLock);
+        wake.notify_one();
+    }
+    return true;
+}
+
+/**
+ * Function: flush
+ * Blocks until every ticket appended before the call has been written by
+ * the writer; with DURABILITY_FSYNC_INTERVAL the file is also fsynced here
+ *
+ * Returns: false without waiting further while the writer is failing to
+ * persist a batch (it keeps the batch and retries)
+ */
+bool TicketJournal::flush() {
+    if (fd < 0) return false;
+    uint64_t target = appendedCount.load();
+    std::unique_lock<std::mutex> lock(wakeLock);
+    wake.notify_one();
+    durable.wait(lock, [&]() {
+        return durableCount.load() >= target || failing.load() || !running.load();
+    });
+    lock.unlock();
+    if (durableCount.load() < target) return false;
+    if (config.durability == DURABILITY_FSYNC_INTERVAL) return syncFile();
+    return true;
+}
+
+// ======================================================================================
+//                                   WRITER THREAD
+// ======================================================================================
+
+/**
+ * Function: drainBatch
+ * Pops up to maxBatch tickets, formatting each straight into 'batch'
+ * Returns: number of tickets in the batch
+ */
+int TicketJournal::drainBatch() {
+    batch.clear();
+    int count = 0;
+    while (count < config.maxBatch &&
+           pending.tryPopWith([&](JournalEntry& cell) {
+               appendRow(batch, cell.ticket);
+               batchQueuedNs[count] = cell.queuedAtNs;
+           })) {
+        count++;
+    }
+    return count;
+}
+
+/**
+ * Function: writeAll
+ * Writes data[done..length); 'done' advances past every byte that reached
+ * the file, so a failed call can be resumed without repeating rows
+ */
+bool TicketJournal::writeAll(const char* data, size_t length, size_t& done) {
+    while (done < length) {
+        long written = JOURNAL_WRITE(fd, data + done, length - done);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        done += written;
+    }
+    return true;
+}
+
+bool TicketJournal::syncFile() {
+    if (fd < 0) return false;
+    if (JOURNAL_FSYNC(fd) != 0) return false;
+    lastFsyncNs.store(steadyNowNs());
+    std::lock_guard<std::mutex> guard(statsLock);
+    stats.fsyncs++;
+    return true;
+}
+
+/**
+ * Function: persistBatch
+ * Writes the rest of the current batch and fsyncs it as the durability
+ * policy asks; in interval mode a failed fsync only leaves 'dirty' set
+ *
+ * Returns: true once the batch may be published as durable
+ */
+bool TicketJournal::persistBatch(size_t& written, bool& dirty, long long intervalNs) {
+    if (!writeAll(batch.data(), batch.size(), written)) return false;
+    if (config.durability == DURABILITY_FSYNC_BATCH) return syncFile();
+    if (config.durability == DURABILITY_FSYNC_INTERVAL) {
+        dirty = true;
+        if (steadyNowNs() - lastFsyncNs.load() >= intervalNs && syncFile()) dirty = false;
+    }
+    return true;
+}
+
+/**
+ * Function: writerLoop
+ * Body of the journal writer thread
+ *
+ * Algorithm:
+ *   - Drain a batch; if non-empty: one write(), fsync per the durability
+ *     policy, publish durableCount and wake flush() waiters
+ *   - A failed write/fsync keeps the batch: the error is reported, flush()
+ *     callers are released with false, and the rest of the batch is retried
+ *     every RETRY_WAIT_MS. After close() a batch gets CLOSE_RETRIES more
+ *     attempts; then the writer gives up and the tickets stay unpublished
+ *   - If empty: exit when closed, else sleep on 'wake' (bounded wait, so a
+ *     missed notification only delays the batch)
+ *   - Stats are recorded per batch: write/fsync time and, per ticket,
+ *     append-to-durable latency
+ */
+void TicketJournal::writerLoop() {
+    long long intervalNs = config.fsyncIntervalMs * 1000000LL;
+    bool dirty = false;     // Written but not yet fsynced (interval mode)
+    WaitHistogram commitWaits;
+
+    while (true) {
+        int count = drainBatch();
+        if (count > 0) {
+            long long start = steadyNowNs();
+            size_t written = 0;
+            int failures = 0;
+            while (!persistBatch(written, dirty, intervalNs)) {
+                if (failures++ == 0) {
+                    std::cerr << "Ticket journal: write to " << config.path << " failed ("
+                              << strerror(errno) << "), retrying\n";
+                    std::lock_guard<std::mutex> guard(wakeLock);
+                    failing.store(true);
+                    durable.notify_all();
+                }
+                if (!running.load() && failures > CLOSE_RETRIES) {
+                    std::cerr << "Ticket journal: giving up, "
+                              << appendedCount.load() - durableCount.load()
+                              << " ticket(s) not persisted\n";
+                    return;
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(RETRY_WAIT_MS));
+            }
+            failing.store(false);
+            long long end = steadyNowNs();
+
+            commitWaits.reset();
+            for (int i = 0; i < count; i++) commitWaits.record((end - batchQueuedNs[i]) / 1000);
+            {
+                std::lock_guard<std::mutex> guard(statsLock);
+                stats.tickets += count;
+                stats.batches++;
+                stats.bytes += batch.size();
+                stats.flushUs.record((end - start) / 1000);
+                stats.commitUs.merge(commitWaits);
+            }
+            {
+                std::lock_guard<std::mutex> guard(wakeLock);
+                durableCount.fetch_add(count);
+            }
+            durable.notify_all();
+            continue;
+        }
+
+        if (dirty && steadyNowNs() - lastFsyncNs.load() >= intervalNs && syncFile()) {
+            dirty = false;
+        }
+
+        std::unique_lock<std::mutex> lock(wakeLock);
+        if (!running.load() && pending.emptyApprox()) break;
+        writerIdle.store(true);
+        if (pending.emptyApprox() && running.load()) {
+            wake.wait_for(lock, std::chrono::milliseconds(IDLE_WAIT_MS));
+        }
+        writerIdle.store(false);
+    }
+}
+
+// ======================================================================================
+//                                   STATISTICS
+// ======================================================================================
+
+JournalStats TicketJournal::getStats() {
+    std::lock_guard<std::mutex> guard(statsLock);
+    return stats;
+}
+
+void TicketJournal::showStats() {
+    if (!flush()) std::cout << "(journal is not persisting - counts below are incomplete)\n";
+    JournalStats s = getStats();
+    const char* mode = (config.durability == DURABILITY_FSYNC_BATCH) ? "fsync per batch"
+                     : (config.durability == DURABILITY_FSYNC_INTERVAL) ? "fsync per interval"
+                     : "no fsync";
+
+    std::cout << "\n--- Ticket Journal (" << config.path << ", " << mode << ") ---\n";
+    std::cout << "Tickets: " << s.tickets << " | Batches: " << s.batches
+              << " | Bytes: " << s.bytes << " | fsyncs: " << s.fsyncs << "\n";
+    if (s.batches > 0) {
+        std::streamsize oldPrecision = std::cout.precision();
+        std::cout << "Avg batch: " << std::fixed << std::setprecision(1)
+                  << (double)s.tickets / s.batches << " tickets\n";
+        std::cout.unsetf(std::ios::fixed);
+        std::cout.precision(oldPrecision);
+    }
+    std::cout << "Flush latency  (us): p50 " << s.flushUs.percentile(0.50)
+              << " | p99 " << s.flushUs.percentile(0.99) << " | max " << s.flushUs.maxUs << "\n";
+    std::cout << "Commit latency (us): p50 " << s.commitUs.percentile(0.50)
+              << " | p99 " << s.commitUs.percentile(0.99) << " | max " << s.commitUs.maxUs << "\n";
+}
@@ -0,0 +1,574 @@
+/**
+ * ======================================================================================
+ * IMPLEMENTATION: ticket_segment.cpp
+ * DESCRIPTION: Compressed ticket segments - varint / zigzag-delta column
+ *              streams, name and type dictionaries, block zone maps
+ *
+ * KEY FEATURES:
+ * - No external compression library: LEB128 varints, zigzag deltas,
+ *   frame-of-reference offsets and bit-packed dictionary codes
+ * - Every distinct name / passenger type stored once per segment
+ * - 1024-row blocks with entryTime / station min/max for block skipping
+ * - Whole segment built in memory and written with one fwrite
+ * ======================================================================================
+ */
+
+#include "../include/ticket_segment.h"
+#include <cstdio>
+#include <cstring>
+#include <unordered_map>
+#include <algorithm>
+
+#ifdef _WIN32
+    #include <io.h>
+    #define SEGMENT_FSYNC _commit
+    #define SEGMENT_FILENO _fileno
+    #define SEGMENT_TRUNCATE _chsize
+#else
+    #include <unistd.h>
+    #define SEGMENT_FSYNC ::fsync
+    #define SEGMENT_FILENO fileno
+    #define SEGMENT_TRUNCATE ::ftruncate
+#endif
+
+namespace {
+
+const char SEGMENT_MAGIC[8] = "TKTSEG1";
+const char NAMES_MAGIC[8] = { 'T', 'K', 'T', 'N', 'A', 'M', 'E', '1' };
+
+uint64_t zigzag(int64_t v) { return ((uint64_t)v << 1) ^ (uint64_t)(v >> 63); }
+int64_t unzigzag(uint64_t v) { return (int64_t)(v >> 1) ^ -(int64_t)(v & 1); }
+
+void putVarint(std::string& out, uint64_t v) {
+    while (v >= 0x80) {
+        out.push_back((char)(v | 0x80));
+        v >>= 7;
+    }
+    out.push_back((char)v);
+}
+
+// Returns: false if the varint runs past 'end' or is longer than 10 bytes
+bool getVarint(const unsigned char*& p, const unsigned char* end, uint64_t& v) {
+    v = 0;
+    for (int shift = 0; shift < 64 && p < end; shift += 7) {
+        unsigned char byte = *p++;
+        v |= (uint64_t)(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+bool isDelta(int column) { return column == TCOL_ID || column == TCOL_ENTRY_TIME; }
+bool isDictionary(int column) { return column == TCOL_TYPE || column == TCOL_NAME; }
+
+// Bits per dictionary code (0 when the dictionary has a single entry)
+uint32_t codeBits(uint32_t entries) {
+    uint32_t bits = 0;
+    while (entries > 1 && ((entries - 1) >> bits) != 0) bits++;
+    return bits;
+}
+
+uint64_t packedBytes(uint64_t rows, uint32_t bits) {
+    return (rows * bits + 7) / 8;
+}
+
+void putCodes(std::string& out, const uint32_t* codes, size_t count, uint32_t bits) {
+    size_t start = out.size();
+    out.resize(start + packedBytes(count, bits), 0);
+    unsigned char* bytes = (unsigned char*)&out[start];
+    for (size_t i = 0; bits > 0 && i < count; i++) {
+        uint64_t bit = (uint64_t)i * bits;
+        uint64_t shifted = (uint64_t)codes[i] << (bit % 8);
+        for (uint32_t k = 0; k * 8 < bit % 8 + bits; k++) bytes[bit / 8 + k] |= (unsigned char)(shifted >> (8 * k));
+    }
+}
+
+int64_t rowValue(const Passenger& t, int column) {
+    switch (column) {
+        case TCOL_ID:         return t.id;
+        case TCOL_AGE:        return t.age;
+        case TCOL_SOURCE:     return t.sourceId;
+        case TCOL_DEST:       return t.destId;
+        case TCOL_PRICE:      return t.ticketPrice;
+        case TCOL_ENTRY_TIME: return (int64_t)t.entryTime;
+        default:              return 0;
+    }
+}
+
+} // namespace
+
+// ======================================================================================
+//                                   NAME DICTIONARY
+// ======================================================================================
+
+/**
+ * Function: TicketNameDictionary::open
+ * Reads every whole entry; a torn last entry only shortens validBytes
+ * Returns: false if the file exists but is not a name dictionary
+ */
+bool TicketNameDictionary::open(const std::string& path, bool writable) {
+    this->path = path;
+    blob.clear();
+    offsets.assign(1, 0);
+    ids.clear();
+    validBytes = 0;
+    persisted = 0;
+
+    MappedFile file;
+    if (file.open(path) && file.size() > 0) {
+        if (file.size() < sizeof(NAMES_MAGIC) || memcmp(file.begin(), NAMES_MAGIC, sizeof(NAMES_MAGIC)) != 0) {
+            return false;
+        }
+        const unsigned char* begin = (const unsigned char*)file.begin();
+        const unsigned char* p = begin + sizeof(NAMES_MAGIC);
+        const unsigned char* end = (const unsigned char*)file.end();
+        blob.reserve(file.size());
+        while (p < end) {
+            uint64_t length;
+            if (!getVarint(p, end, length) || length > (uint64_t)(end - p)) break;
+            blob.append((const char*)p, (size_t)length);
+            offsets.push_back((uint32_t)blob.size());
+            p += length;
+            validBytes = p - begin;
+        }
+        if (validBytes == 0) validBytes = sizeof(NAMES_MAGIC);
+        persisted = size();
+    }
+
+    if (writable) {
+        ids.reserve(size());
+        for (uint32_t i = 0; i < size(); i++) {
+            size_t length;
+            const char* text = name(i, length);
+            ids.insert(std::make_pair(std::string(text, length), i));
+        }
+    }
+    return true;
+}
+
+uint32_t TicketNameDictionary::intern(const std::string& text) {
+    auto slot = ids.insert(std::make_pair(text, size()));
+    if (slot.second) {
+        blob.append(text);
+        offsets.push_back((uint32_t)blob.size());
+    }
+    return slot.first->second;
+}
+
+bool TicketNameDictionary::find(const std::string& text, uint32_t& id) const {
+    auto it = ids.find(text);
+    if (it == ids.end()) return false;
+    id = it->second;
+    return true;
+}
+
+/**
+ * Function: TicketNameDictionary::flush
+ * Appends the entries added since the last flush after the last whole
+ * entry (cutting off a torn tail), then fsyncs. A new file is created with
+ * its magic; the caller syncs the directory.
+ */
+bool TicketNameDictionary::flush() {
+    if (persisted == size() && validBytes > 0) return true;
+
+    std::string bytes;
+    if (validBytes == 0) bytes.append(NAMES_MAGIC, sizeof(NAMES_MAGIC));
+    for (uint32_t i = (uint32_t)persisted; i < size(); i++) {
+        size_t length;
+        const char* text = name(i, length);
+        putVarint(bytes, length);
+        bytes.append(text, length);
+    }
+
+    FILE* file = fopen(path.c_str(), validBytes == 0 ? "wb" : "r+b");
+    if (!file) return false;
+    uint64_t newBytes = validBytes + bytes.size();
+    bool ok = fseek(file, (long)validBytes, SEEK_SET) == 0 &&
+              fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size() &&
+              fflush(file) == 0 &&
+              SEGMENT_TRUNCATE(SEGMENT_FILENO(file), (long)newBytes) == 0 &&
+              SEGMENT_FSYNC(SEGMENT_FILENO(file)) == 0;
+    ok = (fclose(file) == 0) && ok;
+    if (!ok) return false;
+    validBytes = newBytes;
+    persisted = size();
+    return true;
+}
+
+// ======================================================================================
+//                                   WRITER
+// ======================================================================================
+
+/**
+ * Function: writeTicketSegment
+ * Dictionaries first (so a reader can resolve indexes block by block),
+ * then each block's header and its column streams. Written to a temp
+ * file, fsynced, then renamed over 'path'; the caller syncs the directory.
+ */
+bool writeTicketSegment(const std::vector<Passenger>& tickets, const std::string& path,
+                        const std::string& trailer, const TicketNameDictionary* names) {
+    SegmentHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SEGMENT_MAGIC, sizeof(header.magic));
+    header.version = names ? TICKET_SEGMENT_VERSION : 1;
+    header.rows = tickets.size();
+    header.blockCount = (uint32_t)((tickets.size() + TICKET_SEGMENT_BLOCK - 1) / TICKET_SEGMENT_BLOCK);
+
+    // Dictionaries: index = order of first appearance (names: shared ids)
+    std::unordered_map<std::string, uint32_t> nameIndex;
+    std::unordered_map<int, uint32_t> typeIndex;
+    std::vector<uint32_t> nameOf(tickets.size()), typeOf(tickets.size());
+    std::string body;
+    std::string typeDictionary;
+    for (size_t i = 0; i < tickets.size(); i++) {
+        if (names) {
+            if (!names->find(tickets[i].name, nameOf[i])) return false;
+        } else {
+            auto name = nameIndex.insert(std::make_pair(tickets[i].name, (uint32_t)nameIndex.size()));
+            if (name.second) {
+                putVarint(body, tickets[i].name.size());
+                body.append(tickets[i].name);
+            }
+            nameOf[i] = name.first->second;
+        }
+
+        auto type = typeIndex.insert(std::make_pair((int)tickets[i].type, (uint32_t)typeIndex.size()));
+        if (type.second) putVarint(typeDictionary, zigzag((int)tickets[i].type));
+        typeOf[i] = type.first->second;
+    }
+    header.nameCount = names ? names->size() : (uint32_t)nameIndex.size();
+    header.typeCount = (uint32_t)typeIndex.size();
+    body.append(typeDictionary);
+    uint32_t nameBits = codeBits(header.nameCount);
+    uint32_t typeBits = codeBits(header.typeCount);
+
+    std::string streams[TCOL_COUNT];
+    for (uint32_t b = 0; b < header.blockCount; b++) {
+        size_t first = (size_t)b * TICKET_SEGMENT_BLOCK;
+        size_t last = std::min(tickets.size(), first + TICKET_SEGMENT_BLOCK);
+
+        SegmentBlock block;
+        memset(&block, 0, sizeof(block));
+        block.rows = (uint32_t)(last - first);
+        block.minEntryTime = block.maxEntryTime = (int64_t)tickets[first].entryTime;
+        block.minSource = block.maxSource = tickets[first].sourceId;
+        block.minDest = block.maxDest = tickets[first].destId;
+
+        // References: first value for delta columns, minimum for the rest
+        for (int c = 0; c < TCOL_COUNT; c++) {
+            streams[c].clear();
+            block.reference[c] = isDictionary(c) ? 0 : rowValue(tickets[first], c);
+        }
+        for (size_t i = first; i < last; i++) {
+            const Passenger& t = tickets[i];
+            block.minEntryTime = std::min(block.minEntryTime, (int64_t)t.entryTime);
+            block.maxEntryTime = std::max(block.maxEntryTime, (int64_t)t.entryTime);
+            block.minSource = std::min(block.minSource, t.sourceId);
+            block.maxSource = std::max(block.maxSource, t.sourceId);
+            block.minDest = std::min(block.minDest, t.destId);
+            block.maxDest = std::max(block.maxDest, t.destId);
+            for (int c = 0; c < TCOL_COUNT; c++) {
+                if (!isDictionary(c) && !isDelta(c)) block.reference[c] = std::min(block.reference[c], rowValue(t, c));
+            }
+        }
+
+        int64_t previous[TCOL_COUNT];
+        for (int c = 0; c < TCOL_COUNT; c++) previous[c] = block.reference[c];
+        for (size_t i = first; i < last; i++) {
+            for (int c = 0; c < TCOL_COUNT; c++) {
+                if (isDictionary(c)) continue;
+                int64_t v = rowValue(tickets[i], c);
+                if (isDelta(c)) {
+                    putVarint(streams[c], zigzag((int64_t)((uint64_t)v - (uint64_t)previous[c])));
+                    previous[c] = v;
+                } else {
+                    putVarint(streams[c], (uint64_t)v - (uint64_t)block.reference[c]);
+                }
+            }
+        }
+        putCodes(streams[TCOL_TYPE], typeOf.data() + first, last - first, typeBits);
+        putCodes(streams[TCOL_NAME], nameOf.data() + first, last - first, nameBits);
+        for (int c = 0; c < TCOL_COUNT; c++) block.columnBytes[c] = (uint32_t)streams[c].size();
+        body.append((const char*)&block, sizeof(block));
+        for (int c = 0; c < TCOL_COUNT; c++) body.append(streams[c]);
+    }
+    header.segmentBytes = sizeof(header) + body.size();
+
+    std::string tmpPath = path + ".tmp";
+    FILE* file = fopen(tmpPath.c_str(), "wb");
+    if (!file) return false;
+    bool ok = fwrite(&header, 1, sizeof(header), file) == sizeof(header) &&
+              (body.empty() || fwrite(body.data(), 1, body.size(), file) == body.size()) &&
+              (trailer.empty() || fwrite(trailer.data(), 1, trailer.size(), file) == trailer.size()) &&
+              fflush(file) == 0 && SEGMENT_FSYNC(SEGMENT_FILENO(file)) == 0;
+    ok = (fclose(file) == 0) && ok;
+    if (!ok) {
+        remove(tmpPath.c_str());
+        return false;
+    }
+#ifdef _WIN32
+    remove(path.c_str());   // rename() does not replace on Windows
+#endif
+    return rename(tmpPath.c_str(), path.c_str()) == 0;
+}
+
+// ======================================================================================
+//                                   SEGMENT READER
+// ======================================================================================
+
+/**
+ * Function: open
+ * Maps the file and checks the header, both dictionaries and every block
+ * header / stream length, so decoding never reads outside the segment
+ */
+bool TicketSegment::open(const std::string& path, const TicketNameDictionary* names) {
+    valid = false;
+    sharedNames = NULL;
+    nameData.clear();
+    nameLength.clear();
+    types.clear();
+    blocks.clear();
+    streams.clear();
+    if (!map.open(path) || map.size() < sizeof(header)) return false;
+    memcpy(&header, map.begin(), sizeof(header));
+    if (memcmp(header.magic, SEGMENT_MAGIC, sizeof(header.magic)) != 0) return false;
+    if (header.version != 1 && header.version != TICKET_SEGMENT_VERSION) return false;
+    if (header.segmentBytes < sizeof(header) || header.segmentBytes > map.size()) return false;
+    if (header.blockCount != (header.rows + TICKET_SEGMENT_BLOCK - 1) / TICKET_SEGMENT_BLOCK) return false;
+
+    const unsigned char* p = (const unsigned char*)map.begin() + sizeof(header);
+    const unsigned char* end = (const unsigned char*)map.begin() + header.segmentBytes;
+    if (header.typeCount > header.rows) return false;
+    if (header.version == 1 && header.nameCount > header.rows) return false;
+    if (header.version == 2) {
+        // Ids refer to the shared dictionary, which only ever grows
+        if (names == NULL || header.nameCount > names->size()) return false;
+        sharedNames = names;
+    }
+
+    nameData.reserve(sharedNames ? 0 : header.nameCount);
+    nameLength.reserve(sharedNames ? 0 : header.nameCount);
+    for (uint32_t i = 0; !sharedNames && i < header.nameCount; i++) {
+        uint64_t length;
+        if (!getVarint(p, end, length) || length > (uint64_t)(end - p)) return false;
+        nameData.push_back((const char*)p);
+        nameLength.push_back((uint32_t)length);
+        p += length;
+    }
+    types.reserve(header.typeCount);
+    for (uint32_t i = 0; i < header.typeCount; i++) {
+        uint64_t type;
+        if (!getVarint(p, end, type)) return false;
+        types.push_back((int)unzigzag(type));
+    }
+    nameBits = codeBits(header.nameCount);
+    typeBits = codeBits(header.typeCount);
+
+    // Block headers follow variable-length streams (unaligned), so they are copied out
+    blocks.resize(header.blockCount);
+    streams.resize(header.blockCount);
+    uint64_t rowsSeen = 0;
+    for (uint32_t b = 0; b < header.blockCount; b++) {
+        if ((size_t)(end - p) < sizeof(SegmentBlock)) return false;
+        SegmentBlock& block = blocks[b];
+        memcpy(&block, p, sizeof(block));
+        p += sizeof(SegmentBlock);
+        streams[b] = p;
+        if (block.rows == 0 || block.rows > (uint32_t)TICKET_SEGMENT_BLOCK) return false;
+        if (block.columnBytes[TCOL_TYPE] != packedBytes(block.rows, typeBits)) return false;
+        if (block.columnBytes[TCOL_NAME] != packedBytes(block.rows, nameBits)) return false;
+        for (int c = 0; c < TCOL_COUNT; c++) {
+            if (block.columnBytes[c] > (uint64_t)(end - p)) return false;
+            p += block.columnBytes[c];
+        }
+        rowsSeen += block.rows;
+    }
+    if (rowsSeen != header.rows || p != end) return false;
+    valid = true;
+    return true;
+}
+
+/**
+ * Function: decodeColumn
+ * Walks to column c's stream inside block b and decodes every value
+ */
+int TicketSegment::decodeColumn(uint32_t b, int column, int64_t* out) const {
+    const SegmentBlock& block = blocks[b];
+    const unsigned char* p = streams[b];
+    for (int c = 0; c < column; c++) p += block.columnBytes[c];
+    const unsigned char* end = p + block.columnBytes[column];
+
+    if (isDictionary(column)) {
+        uint32_t limit = column == TCOL_NAME ? header.nameCount : header.typeCount;
+        uint32_t bits = column == TCOL_NAME ? nameBits : typeBits;
+        uint64_t mask = (1ULL << bits) - 1;
+        uint64_t bit = 0;
+        for (uint32_t i = 0; i < block.rows; i++, bit += bits) {
+            // A code spans at most 5 bytes (32 bits + a 7-bit shift)
+            uint64_t window = 0;
+            uint32_t shift = bit % 8;
+            for (uint32_t k = 0; k * 8 < shift + bits; k++) window |= (uint64_t)p[bit / 8 + k] << (8 * k);
+            uint64_t code = (window >> shift) & mask;
+            if (code >= limit) return -1;
+            out[i] = (int64_t)code;
+        }
+        return (int)block.rows;
+    }
+
+    int64_t previous = block.reference[column];
+    for (uint32_t i = 0; i < block.rows; i++) {
+        uint64_t v;
+        if (!getVarint(p, end, v)) return -1;
+        if (isDelta(column)) {
+            previous = (int64_t)((uint64_t)previous + (uint64_t)unzigzag(v));
+            out[i] = previous;
+        } else {
+            out[i] = (int64_t)((uint64_t)block.reference[column] + v);
+        }
+    }
+    return p == end ? (int)block.rows : -1;
+}
+
+const char* TicketSegment::name(uint32_t index, size_t& length) const {
+    if (sharedNames) return sharedNames->name(index, length);
+    length = nameLength[index];
+    return nameData[index];
+}
+
+/**
+ * Function: loadAll
+ * Rebuilds full Passenger rows (used when a day partition is merged)
+ */
+bool TicketSegment::loadAll(std::vector<Passenger>& tickets) const {
+    if (!valid) return false;
+    tickets.assign(header.rows, Passenger());
+    std::vector<int64_t> values((size_t)TCOL_COUNT * TICKET_SEGMENT_BLOCK);
+    uint64_t row = 0;
+    for (uint32_t b = 0; b < header.blockCount; b++) {
+        for (int c = 0; c < TCOL_COUNT; c++) {
+            if (decodeColumn(b, c, values.data() + (size_t)c * TICKET_SEGMENT_BLOCK) < 0) return false;
+        }
+        for (uint32_t i = 0; i < blocks[b].rows; i++, row++) {
+            const int64_t* v = values.data() + i;
+            Passenger& t = tickets[row];
+            t.id = (int)v[TCOL_ID * TICKET_SEGMENT_BLOCK];
+            t.age = (int)v[TCOL_AGE * TICKET_SEGMENT_BLOCK];
+            t.type = (PassengerType)types[v[TCOL_TYPE * TICKET_SEGMENT_BLOCK]];
+            t.sourceId = (int)v[TCOL_SOURCE * TICKET_SEGMENT_BLOCK];
+            t.destId = (int)v[TCOL_DEST * TICKET_SEGMENT_BLOCK];
+            t.ticketPrice = (int)v[TCOL_PRICE * TICKET_SEGMENT_BLOCK];
+            t.entryTime = (time_t)v[TCOL_ENTRY_TIME * TICKET_SEGMENT_BLOCK];
+            size_t length;
+            const char* text = name((uint32_t)v[TCOL_NAME * TICKET_SEGMENT_BLOCK], length);
+            t.name.assign(text, length);
+        }
+    }
+    return true;
+}
+
+// ======================================================================================
+//                                   SEGMENT CURSOR
+// ======================================================================================
+
+TicketSegmentCursor::TicketSegmentCursor()
+    : segment(NULL), fields(0), selected(0), nextSelected(0), nextBlock(0),
+      blockFirstRow(0), nextBlockFirstRow(0), blocksSkipped(0), blocksScanned(0) {}
+
+bool TicketSegmentCursor::open(const TicketSegment& segment, const TicketFilter& filter,
+                               unsigned fields) {
+    this->segment = &segment;
+    this->filter = filter;
+    this->fields = fields & TICKET_FIELD_ALL;
+    selected = nextSelected = 0;
+    nextBlock = 0;
+    blockFirstRow = nextBlockFirstRow = 0;
+    blocksSkipped = blocksScanned = 0;
+    if (!segment.isOpen()) return false;
+    values.assign((size_t)TCOL_COUNT * TICKET_SEGMENT_BLOCK, 0);
+    selection.assign(TICKET_SEGMENT_BLOCK, 0);
+    return true;
+}
+
+// Zone-map test: can any row of the block pass the filter?
+bool TicketSegmentCursor::blockMayMatch(const SegmentBlock& block) const {
+    if (filter.hasTimeRange() &&
+        (block.maxEntryTime < filter.fromTime || block.minEntryTime >= filter.toTime)) return false;
+    if (filter.stationId >= 0) {
+        bool inSource = block.minSource <= filter.stationId && filter.stationId <= block.maxSource;
+        bool inDest = block.minDest <= filter.stationId && filter.stationId <= block.maxDest;
+        if (!inSource && !inDest) return false;
+    }
+    return true;
+}
+
+/**
+ * Function: loadNextBlock
+ * Same steps as TicketCursor::loadNextBlock; a corrupt stream ends the scan
+ */
+bool TicketSegmentCursor::loadNextBlock() {
+    bool timeRange = filter.hasTimeRange();
+    bool station = filter.stationId >= 0;
+
+    while (segment && nextBlock < segment->getBlockCount()) {
+        uint32_t b = nextBlock++;
+        const SegmentBlock& block = segment->block(b);
+        blockFirstRow = nextBlockFirstRow;
+        nextBlockFirstRow += block.rows;
+        if (!blockMayMatch(block)) {
+            blocksSkipped++;
+            continue;
+        }
+        blocksScanned++;
+
+        // Predicate streams first
+        int count = (int)block.rows;
+        unsigned decoded = 0;
+        for (int c = 0; c < TCOL_COUNT; c++) {
+            bool predicate = (timeRange && c == TCOL_ENTRY_TIME) ||
+                             (station && (c == TCOL_SOURCE || c == TCOL_DEST));
+            if (!predicate) continue;
+            if (segment->decodeColumn(b, c, column(c)) != count) return false;
+            decoded |= ticketField((TicketColumnId)c);
+        }
+
+        selected = 0;
+        const int64_t* time = column(TCOL_ENTRY_TIME);
+        const int64_t* src = column(TCOL_SOURCE);
+        const int64_t* dst = column(TCOL_DEST);
+        for (int i = 0; i < count; i++) {
+            if (timeRange && (time[i] < filter.fromTime || time[i] >= filter.toTime)) continue;
+            if (station && src[i] != filter.stationId && dst[i] != filter.stationId) continue;
+            selection[selected++] = (uint16_t)i;
+        }
+        if (selected == 0) continue;
+
+        // Then the rest of the projection, only for blocks with matches
+        for (int c = 0; c < TCOL_COUNT; c++) {
+            unsigned bit = ticketField((TicketColumnId)c);
+            if ((fields & bit) && !(decoded & bit) && segment->decodeColumn(b, c, column(c)) != count) {
+                return false;
+            }
+        }
+        nextSelected = 0;
+        return true;
+    }
+    return false;
+}
+
+bool TicketSegmentCursor::next(TicketRecord& out) {
+    if (nextSelected >= selected && !loadNextBlock()) return false;
+
+    int i = selection[nextSelected++];
+    out.row = blockFirstRow + i;
+    out.id = (fields & ticketField(TCOL_ID)) ? (int)column(TCOL_ID)[i] : 0;
+    out.age = (fields & ticketField(TCOL_AGE)) ? (int)column(TCOL_AGE)[i] : 0;
+    out.type = (PassengerType)((fields & ticketField(TCOL_TYPE)) ? segment->type((uint32_t)column(TCOL_TYPE)[i]) : 0);
+    out.sourceId = (fields & ticketField(TCOL_SOURCE)) ? (int)column(TCOL_SOURCE)[i] : 0;
+    out.destId = (fields & ticketField(TCOL_DEST)) ? (int)column(TCOL_DEST)[i] : 0;
+    out.ticketPrice = (fields & ticketField(TCOL_PRICE)) ? (int)column(TCOL_PRICE)[i] : 0;
+    out.entryTime = (fields & ticketField(TCOL_ENTRY_TIME)) ? (time_t)column(TCOL_ENTRY_TIME)[i] : 0;
+    out.name = "";
+    out.nameLength = 0;
+    if (fields & ticketField(TCOL_NAME)) out.name = segment->name((uint32_t)column(TCOL_NAME)[i], out.nameLength);
+    return true;
+}
@@ -0,0 +1,554 @@
+/**
+ * ======================================================================================
+ * IMPLEMENTATION: ticket_store.cpp
+ * DESCRIPTION: Columnar ticket store - delta / frame-of-reference bit packing,
+ *              page-aligned column sections, memory-mapped column scans
+ *
+ * KEY FEATURES:
+ * - One section per column; a query maps only the sections it reads
+ * - 1024-value blocks, each with its own reference and bit width
+ * - Names kept in a separate heap so fixed-width columns stay dense
+ * - Per-block min/max for predicate pushdown in TicketCursor
+ * - Rebuilt from tickets.csv (parallel loader) when the CSV has grown
+ * ======================================================================================
+ */
+
+#include "../include/ticket_store.h"
+#include "../include/csv_manager.h"
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <sys/stat.h>
+
+namespace {
+
+const char STORE_MAGIC[8] = "TKTCOL1";
+
+int64_t columnValue(const Passenger& t, int column) {
+    switch (column) {
+        case TCOL_ID:         return t.id;
+        case TCOL_AGE:        return t.age;
+        case TCOL_TYPE:       return (int64_t)t.type;
+        case TCOL_SOURCE:     return t.sourceId;
+        case TCOL_DEST:       return t.destId;
+        case TCOL_PRICE:      return t.ticketPrice;
+        case TCOL_ENTRY_TIME: return (int64_t)t.entryTime;
+        default:              return 0;
+    }
+}
+
+// Ids and entry times grow with the file, so deltas are small
+uint32_t encodingOf(int column) {
+    if (column == TCOL_ID || column == TCOL_ENTRY_TIME) return ENCODING_DELTA;
+    if (column == TCOL_NAME) return ENCODING_HEAP;
+    return ENCODING_FOR;
+}
+
+uint64_t zigzag(int64_t v) { return ((uint64_t)v << 1) ^ (uint64_t)(v >> 63); }
+int64_t unzigzag(uint64_t v) { return (int64_t)(v >> 1) ^ -(int64_t)(v & 1); }
+
+uint32_t bitWidth(uint64_t v) {
+    uint32_t bits = 0;
+    while (v) { bits++; v >>= 1; }
+    return bits;
+}
+
+uint64_t wordsFor(uint64_t count, uint32_t width) {
+    return (count * width + 63) / 64;
+}
+
+bool writePadding(FILE* file, uint64_t& at) {
+    static const char zeros[TICKET_STORE_ALIGN] = {0};
+    uint64_t pad = (TICKET_STORE_ALIGN - at % TICKET_STORE_ALIGN) % TICKET_STORE_ALIGN;
+    at += pad;
+    return pad == 0 || fwrite(zeros, 1, pad, file) == pad;
+}
+
+/**
+ * Encodes one fixed-width column into 'file' at 'at'
+ * Per block: pick the reference (minimum for FOR, first value for DELTA),
+ * turn values into unsigned offsets, size the block to the widest offset
+ * and pack them back to back into 64-bit words.
+ */
+bool writeColumn(FILE* file, uint64_t& at, const std::vector<Passenger>& tickets,
+                 int column, ColumnInfo& info) {
+    uint64_t rows = tickets.size();
+    info.encoding = encodingOf(column);
+    info.blockCount = (uint32_t)((rows + TICKET_STORE_BLOCK - 1) / TICKET_STORE_BLOCK);
+    info.offset = at;
+
+    std::vector<ColumnBlock> blocks(info.blockCount);
+    std::vector<uint64_t> words;
+    uint64_t packed[TICKET_STORE_BLOCK];
+
+    for (uint32_t b = 0; b < info.blockCount; b++) {
+        uint64_t first = (uint64_t)b * TICKET_STORE_BLOCK;
+        int count = (int)std::min<uint64_t>(TICKET_STORE_BLOCK, rows - first);
+        ColumnBlock& block = blocks[b];
+
+        block.minValue = block.maxValue = columnValue(tickets[first], column);
+        for (int i = 1; i < count; i++) {
+            int64_t v = columnValue(tickets[first + i], column);
+            block.minValue = std::min(block.minValue, v);
+            block.maxValue = std::max(block.maxValue, v);
+        }
+
+        uint64_t widest = 0;
+        if (info.encoding == ENCODING_DELTA) {
+            block.reference = columnValue(tickets[first], column);
+            int64_t previous = block.reference;
+            for (int i = 0; i < count; i++) {
+                int64_t v = columnValue(tickets[first + i], column);
+                packed[i] = zigzag((int64_t)((uint64_t)v - (uint64_t)previous));
+                previous = v;
+                widest |= packed[i];
+            }
+        } else {
+            block.reference = block.minValue;
+            for (int i = 0; i < count; i++) {
+                packed[i] = (uint64_t)columnValue(tickets[first + i], column) - (uint64_t)block.reference;
+                widest |= packed[i];
+            }
+        }
+
+        block.width = bitWidth(widest);
+        block.count = count;
+        block.wordOffset = words.size();
+        words.resize(words.size() + wordsFor(count, block.width), 0);
+
+        uint64_t* out = words.data() + block.wordOffset;
+        uint32_t w = block.width;
+        for (int i = 0; w > 0 && i < count; i++) {
+            uint64_t bit = (uint64_t)i * w;
+            uint32_t shift = bit % 64;
+            out[bit / 64] |= packed[i] << shift;
+            if (shift + w > 64) out[bit / 64 + 1] |= packed[i] >> (64 - shift);
+        }
+    }
+
+    size_t blockBytes = blocks.size() * sizeof(ColumnBlock);
+    size_t wordBytes = words.size() * sizeof(uint64_t);
+    if (fwrite(blocks.data(), 1, blockBytes, file) != blockBytes) return false;
+    if (fwrite(words.data(), 1, wordBytes, file) != wordBytes) return false;
+    info.length = blockBytes + wordBytes;
+    at += info.length;
+    return writePadding(file, at);
+}
+
+bool writeNameHeap(FILE* file, uint64_t& at, const std::vector<Passenger>& tickets,
+                   ColumnInfo& info) {
+    info.encoding = ENCODING_HEAP;
+    info.blockCount = 0;
+    info.offset = at;
+
+    std::vector<uint64_t> offsets(tickets.size() + 1, 0);
+    for (size_t i = 0; i < tickets.size(); i++) offsets[i + 1] = offsets[i] + tickets[i].name.size();
+
+    size_t offsetBytes = offsets.size() * sizeof(uint64_t);
+    if (fwrite(offsets.data(), 1, offsetBytes, file) != offsetBytes) return false;
+    for (const auto& t : tickets) {
+        if (!t.name.empty() && fwrite(t.name.data(), 1, t.name.size(), file) != t.name.size()) return false;
+    }
+    info.length = offsetBytes + offsets.back();
+    at += info.length;
+    return writePadding(file, at);
+}
+
+long long fileSize(const std::string& path) {
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0) return -1;
+    return (long long)st.st_size;
+}
+
+} // namespace
+
+// ======================================================================================
+//                                   WRITER
+// ======================================================================================
+
+/**
+ * Function: writeTicketStore
+ * Header first (rewritten once the column offsets are known), then each
+ * column section padded to TICKET_STORE_ALIGN
+ */
+bool writeTicketStore(const std::vector<Passenger>& tickets, uint64_t sourceBytes,
+                      const std::string& path) {
+    TicketStoreHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, STORE_MAGIC, sizeof(header.magic));
+    header.version = TICKET_STORE_VERSION;
+    header.columnCount = TCOL_COUNT;
+    header.rows = tickets.size();
+    header.sourceBytes = sourceBytes;
+
+    std::string tmpPath = path + ".tmp";
+    FILE* file = fopen(tmpPath.c_str(), "wb");
+    if (!file) return false;
+
+    uint64_t at = sizeof(header);
+    bool ok = fwrite(&header, 1, sizeof(header), file) == sizeof(header) && writePadding(file, at);
+    for (int c = 0; ok && c < TCOL_NAME; c++) ok = writeColumn(file, at, tickets, c, header.columns[c]);
+    ok = ok && writeNameHeap(file, at, tickets, header.columns[TCOL_NAME]);
+    ok = ok && fseek(file, 0, SEEK_SET) == 0 && fwrite(&header, 1, sizeof(header), file) == sizeof(header);
+    ok = (fclose(file) == 0) && ok;
+    if (!ok) {
+        remove(tmpPath.c_str());
+        return false;
+    }
+#ifdef _WIN32
+    remove(path.c_str());   // rename() does not replace on Windows
+#endif
+    return rename(tmpPath.c_str(), path.c_str()) == 0;
+}
+
+/**
+ * Function: refreshTicketStore
+ * The store is a derived copy: if tickets.csv has a different size than
+ * the one recorded in the header, reload the CSV (parallel) and rewrite it
+ */
+long long refreshTicketStore(const std::string& path) {
+    TicketStoreReader reader;
+    bool haveStore = reader.open(path);
+    long long csvBytes = fileSize(CSVManager::TICKET_FILE);
+    if (csvBytes < 0) return haveStore ? (long long)reader.rows() : -1;
+    if (haveStore && reader.sourceBytes() == (uint64_t)csvBytes) return (long long)reader.rows();
+
+    std::vector<Passenger> tickets;
+    if (!CSVManager::loadTickets(tickets)) return haveStore ? (long long)reader.rows() : -1;
+    if (!writeTicketStore(tickets, (uint64_t)csvBytes, path)) return -1;
+    return (long long)tickets.size();
+}
+
+// ======================================================================================
+//                                   COLUMN READERS
+// ======================================================================================
+
+/**
+ * Function: TicketColumn::open
+ * Maps one column section and checks every block fits inside it and
+ * holds the expected number of rows, so decoding never reads past the
+ * mapping or yields more than 'rows' values
+ */
+bool TicketColumn::open(const std::string& path, const ColumnInfo& info, uint64_t rows) {
+    blocks = NULL;
+    words = NULL;
+    blockCount = 0;
+    if (info.encoding == ENCODING_HEAP) return false;
+    if (!map.openRange(path, info.offset, info.length) || map.size() != info.length) return false;
+
+    size_t blockBytes = (size_t)info.blockCount * sizeof(ColumnBlock);
+    if (blockBytes > map.size()) return false;
+    const ColumnBlock* candidate = (const ColumnBlock*)map.begin();
+    uint64_t wordCount = (map.size() - blockBytes) / sizeof(uint64_t);
+    for (uint32_t b = 0; b < info.blockCount; b++) {
+        const ColumnBlock& block = candidate[b];
+        uint64_t expected = std::min<uint64_t>(TICKET_STORE_BLOCK, rows - (uint64_t)b * TICKET_STORE_BLOCK);
+        if (block.width > 64 || block.count != expected || block.minValue > block.maxValue) return false;
+        if (block.wordOffset + wordsFor(block.count, block.width) > wordCount) return false;
+    }
+
+    blocks = candidate;
+    words = (const uint64_t*)(map.begin() + blockBytes);
+    blockCount = info.blockCount;
+    encoding = info.encoding;
+    return true;
+}
+
+int TicketColumn::decodeBlock(uint32_t b, int64_t* out) const {
+    const ColumnBlock& block = blocks[b];
+    const uint64_t* in = words + block.wordOffset;
+    uint32_t w = block.width;
+    uint64_t mask = (w == 64) ? ~0ULL : ((1ULL << w) - 1);
+    int count = (int)block.count;
+
+    int64_t running = block.reference;
+    for (int i = 0; i < count; i++) {
+        uint64_t v = 0;
+        if (w > 0) {
+            uint64_t bit = (uint64_t)i * w;
+            uint32_t shift = bit % 64;
+            v = in[bit / 64] >> shift;
+            if (shift + w > 64) v |= in[bit / 64 + 1] << (64 - shift);
+            v &= mask;
+        }
+        if (encoding == ENCODING_DELTA) {
+            running = (int64_t)((uint64_t)running + (uint64_t)unzigzag(v));
+            out[i] = running;
+        } else {
+            out[i] = (int64_t)((uint64_t)block.reference + v);
+        }
+    }
+    return count;
+}
+
+bool TicketNames::open(const std::string& path, const ColumnInfo& info, uint64_t rows) {
+    offsets = NULL;
+    bytes = NULL;
+    this->rows = 0;
+    if (info.encoding != ENCODING_HEAP) return false;
+    if (!map.openRange(path, info.offset, info.length) || map.size() != info.length) return false;
+
+    size_t offsetBytes = (size_t)(rows + 1) * sizeof(uint64_t);
+    if (offsetBytes > map.size()) return false;
+    const uint64_t* candidate = (const uint64_t*)map.begin();
+    if (candidate[rows] != map.size() - offsetBytes) return false;
+    for (uint64_t i = 0; i < rows; i++) {
+        if (candidate[i] > candidate[i + 1]) return false;
+    }
+
+    offsets = candidate;
+    bytes = map.begin() + offsetBytes;
+    this->rows = rows;
+    return true;
+}
+
+std::string TicketNames::get(uint64_t row) const {
+    size_t length;
+    const char* name = data(row, length);
+    return std::string(name, length);
+}
+
+const char* TicketNames::data(uint64_t row, size_t& length) const {
+    if (row >= rows) {
+        length = 0;
+        return "";
+    }
+    length = offsets[row + 1] - offsets[row];
+    return bytes + offsets[row];
+}
+
+// ======================================================================================
+//                                   STORE READER
+// ======================================================================================
+
+/**
+ * Function: open
+ * Reads and validates the header only; no column is mapped yet
+ */
+bool TicketStoreReader::open(const std::string& path) {
+    valid = false;
+    this->path = path;
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file) return false;
+    bool ok = fread(&header, 1, sizeof(header), file) == sizeof(header);
+    fclose(file);
+    if (!ok || memcmp(header.magic, STORE_MAGIC, sizeof(header.magic)) != 0) return false;
+    if (header.version != TICKET_STORE_VERSION || header.columnCount != TCOL_COUNT) return false;
+
+    long long size = fileSize(path);
+    uint64_t expectedBlocks = (header.rows + TICKET_STORE_BLOCK - 1) / TICKET_STORE_BLOCK;
+    for (int c = 0; c < TCOL_COUNT; c++) {
+        const ColumnInfo& info = header.columns[c];
+        if (info.encoding != encodingOf(c)) return false;
+        if (info.offset + info.length > (uint64_t)size) return false;
+        if (c != TCOL_NAME && info.blockCount != expectedBlocks) return false;
+    }
+    valid = true;
+    return true;
+}
+
+bool TicketStoreReader::openColumn(TicketColumnId id, TicketColumn& column) const {
+    if (!valid || id == TCOL_NAME || id >= TCOL_COUNT) return false;
+    return column.open(path, header.columns[id], header.rows);
+}
+
+bool TicketStoreReader::openNames(TicketNames& names) const {
+    if (!valid) return false;
+    return names.open(path, header.columns[TCOL_NAME], header.rows);
+}
+
+/**
+ * Function: totalRevenue
+ * Sums the price column - the only section mapped
+ * Returns: total fare, or -1 if the column cannot be read
+ */
+long long TicketStoreReader::totalRevenue(size_t* bytesMapped) const {
+    TicketColumn price;
+    if (!openColumn(TCOL_PRICE, price)) return -1;
+    long long total = 0;
+    price.forEach([&total](uint64_t, int64_t fare) { total += fare; });
+    if (bytesMapped) *bytesMapped = price.mappedBytes();
+    return total;
+}
+
+/**
+ * Function: originDestination
+ * Trip counts per (source, destination) pair from the two station
+ * columns, decoded a block at a time side by side
+ */
+bool TicketStoreReader::originDestination(int stations, std::vector<long long>& counts,
+                                          size_t* bytesMapped) const {
+    TicketColumn source, dest;
+    if (stations <= 0 || !openColumn(TCOL_SOURCE, source) || !openColumn(TCOL_DEST, dest)) return false;
+
+    counts.assign((size_t)stations * stations, 0);
+    int64_t from[TICKET_STORE_BLOCK], to[TICKET_STORE_BLOCK];
+    for (uint32_t b = 0; b < source.getBlockCount(); b++) {
+        int count = source.decodeBlock(b, from);
+        dest.decodeBlock(b, to);
+        for (int i = 0; i < count; i++) {
+            if (from[i] >= 0 && from[i] < stations && to[i] >= 0 && to[i] < stations) {
+                counts[from[i] * stations + to[i]]++;
+            }
+        }
+    }
+    if (bytesMapped) *bytesMapped = source.mappedBytes() + dest.mappedBytes();
+    return true;
+}
+
+/**
+ * Function: loadAll
+ * Rebuilds full Passenger rows (every column mapped)
+ */
+bool TicketStoreReader::loadAll(std::vector<Passenger>& tickets) const {
+    TicketColumn columns[TCOL_NAME];
+    TicketNames names;
+    for (int c = 0; c < TCOL_NAME; c++) {
+        if (!openColumn((TicketColumnId)c, columns[c])) return false;
+    }
+    if (!openNames(names)) return false;
+
+    tickets.assign(header.rows, Passenger());
+    columns[TCOL_ID].forEach([&](uint64_t r, int64_t v) { tickets[r].id = (int)v; });
+    columns[TCOL_AGE].forEach([&](uint64_t r, int64_t v) { tickets[r].age = (int)v; });
+    columns[TCOL_TYPE].forEach([&](uint64_t r, int64_t v) { tickets[r].type = (PassengerType)v; });
+    columns[TCOL_SOURCE].forEach([&](uint64_t r, int64_t v) { tickets[r].sourceId = (int)v; });
+    columns[TCOL_DEST].forEach([&](uint64_t r, int64_t v) { tickets[r].destId = (int)v; });
+    columns[TCOL_PRICE].forEach([&](uint64_t r, int64_t v) { tickets[r].ticketPrice = (int)v; });
+    columns[TCOL_ENTRY_TIME].forEach([&](uint64_t r, int64_t v) { tickets[r].entryTime = (time_t)v; });
+    for (uint64_t r = 0; r < header.rows; r++) tickets[r].name = names.get(r);
+    return true;
+}
+
+// ======================================================================================
+//                                   STREAMING CURSOR
+// ======================================================================================
+
+TicketCursor::TicketCursor()
+    : fields(0), opened(0), selected(0), nextSelected(0), nextBlock(0), blockCount(0),
+      blockFirstRow(0), rows(0), blocksSkipped(0), blocksScanned(0) {}
+
+/**
+ * Function: open
+ * Maps the projected columns plus the ones the filter reads (entryTime for
+ * a time range, source and dest for a station); nothing else is touched
+ *
+ * Returns: false if the store is not open or a needed column is unreadable
+ */
+bool TicketCursor::open(const TicketStoreReader& store, const TicketFilter& filter, unsigned fields) {
+    this->filter = filter;
+    this->fields = fields & TICKET_FIELD_ALL;
+    opened = this->fields;
+    if (filter.hasTimeRange()) opened |= ticketField(TCOL_ENTRY_TIME);
+    if (filter.stationId >= 0) opened |= ticketField(TCOL_SOURCE) | ticketField(TCOL_DEST);
+
+    selected = nextSelected = 0;
+    nextBlock = blockCount = 0;
+    blockFirstRow = rows = 0;
+    blocksSkipped = blocksScanned = 0;
+    if (!store.isOpen()) return false;
+
+    for (int c = 0; c < TCOL_NAME; c++) {
+        if ((opened & ticketField((TicketColumnId)c)) && !store.openColumn((TicketColumnId)c, columns[c])) {
+            return false;
+        }
+    }
+    if ((opened & ticketField(TCOL_NAME)) && !store.openNames(names)) return false;
+
+    values.assign((size_t)TCOL_NAME * TICKET_STORE_BLOCK, 0);
+    selection.assign(TICKET_STORE_BLOCK, 0);
+    rows = store.rows();
+    blockCount = (uint32_t)((rows + TICKET_STORE_BLOCK - 1) / TICKET_STORE_BLOCK);
+    return true;
+}
+
+// Zone-map test: can any row of block b pass the filter?
+bool TicketCursor::blockMayMatch(uint32_t b) const {
+    if (filter.hasTimeRange()) {
+        const ColumnBlock& time = columns[TCOL_ENTRY_TIME].block(b);
+        if (time.maxValue < filter.fromTime || time.minValue >= filter.toTime) return false;
+    }
+    if (filter.stationId >= 0) {
+        const ColumnBlock& src = columns[TCOL_SOURCE].block(b);
+        const ColumnBlock& dst = columns[TCOL_DEST].block(b);
+        bool inSource = src.minValue <= filter.stationId && filter.stationId <= src.maxValue;
+        bool inDest = dst.minValue <= filter.stationId && filter.stationId <= dst.maxValue;
+        if (!inSource && !inDest) return false;
+    }
+    return true;
+}
+
+/**
+ * Function: loadNextBlock
+ * Advances to the next block with at least one matching row, leaving its
+ * selected row indexes in 'selection' and projected columns in 'values'
+ * Returns: false when the store is exhausted
+ */
+bool TicketCursor::loadNextBlock() {
+    bool timeRange = filter.hasTimeRange();
+    bool station = filter.stationId >= 0;
+
+    while (nextBlock < blockCount) {
+        uint32_t b = nextBlock++;
+        blockFirstRow = (uint64_t)b * TICKET_STORE_BLOCK;
+        if (!blockMayMatch(b)) {
+            blocksSkipped++;
+            continue;
+        }
+        blocksScanned++;
+
+        // Predicate columns first
+        int count = (int)std::min<uint64_t>(TICKET_STORE_BLOCK, rows - blockFirstRow);
+        unsigned decoded = 0;
+        for (int c = 0; c < TCOL_NAME; c++) {
+            bool predicate = (timeRange && c == TCOL_ENTRY_TIME) ||
+                             (station && (c == TCOL_SOURCE || c == TCOL_DEST));
+            if (predicate) {
+                columns[c].decodeBlock(b, column(c));
+                decoded |= ticketField((TicketColumnId)c);
+            }
+        }
+
+        selected = 0;
+        const int64_t* time = column(TCOL_ENTRY_TIME);
+        const int64_t* src = column(TCOL_SOURCE);
+        const int64_t* dst = column(TCOL_DEST);
+        for (int i = 0; i < count; i++) {
+            if (timeRange && (time[i] < filter.fromTime || time[i] >= filter.toTime)) continue;
+            if (station && src[i] != filter.stationId && dst[i] != filter.stationId) continue;
+            selection[selected++] = (uint16_t)i;
+        }
+        if (selected == 0) continue;
+
+        // Then the rest of the projection, only for blocks with matches
+        for (int c = 0; c < TCOL_NAME; c++) {
+            unsigned bit = ticketField((TicketColumnId)c);
+            if ((fields & bit) && !(decoded & bit)) columns[c].decodeBlock(b, column(c));
+        }
+        nextSelected = 0;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * Function: next
+ * Returns: true and fills 'out' with the next matching ticket, false at end
+ */
+bool TicketCursor::next(TicketRecord& out) {
+    if (nextSelected >= selected && !loadNextBlock()) return false;
+
+    int i = selection[nextSelected++];
+    out.row = blockFirstRow + i;
+    out.id = (fields & ticketField(TCOL_ID)) ? (int)column(TCOL_ID)[i] : 0;
+    out.age = (fields & ticketField(TCOL_AGE)) ? (int)column(TCOL_AGE)[i] : 0;
+    out.type = (PassengerType)((fields & ticketField(TCOL_TYPE)) ? column(TCOL_TYPE)[i] : 0);
+    out.sourceId = (fields & ticketField(TCOL_SOURCE)) ? (int)column(TCOL_SOURCE)[i] : 0;
+    out.destId = (fields & ticketField(TCOL_DEST)) ? (int)column(TCOL_DEST)[i] : 0;
+    out.ticketPrice = (fields & ticketField(TCOL_PRICE)) ? (int)column(TCOL_PRICE)[i] : 0;
+    out.entryTime = (fields & ticketField(TCOL_ENTRY_TIME)) ? (time_t)column(TCOL_ENTRY_TIME)[i] : 0;
+    out.name = "";
+    out.nameLength = 0;
+    if (fields & ticketField(TCOL_NAME)) out.name = names.data(out.row, out.nameLength);
+    return true;
+}
@@ -3,20 +3,129 @@
  * IMPLEMENTATION: ticketing.cpp
  * DESCRIPTION: Implementation of TicketSystem with Multi-Queue Management
  * 
- * DATA STRUCTURE: Multiple Custom MyQueue instances
+ * DATA STRUCTURE: Three bounded lock-free MPMC queues (mpmc_queue.h)
  * - generalQueue: Standard passengers
  * - ladiesQueue: Female passengers (priority over general)
  * - seniorQueue: Senior citizens (highest priority)
  * 
- * PROCESSING ORDER: Senior → Ladies → General
- * This implements a priority-based queue system using multiple queues
+ * PROCESSING ORDER: Deficit round robin, weighted Senior > Ladies > General,
+ * with max-wait promotion so no lane starves under a rush.
+ * The lanes can be filled from many booking threads and drained by several
+ * counter threads at once (startCounters / stopCounters).
+ * 
+ * TICKET PIPELINE: emplace() into a lane cell → swapped out by a counter →
+ * swapped into the TicketLedger on issue → TicketHandle. Heap buffers
+ * (names) circulate around this loop instead of being copied per ticket.
  * ======================================================================================
  */
 
 #include "../include/ticketing.h"
 #include "../include/globals.h"
+#include "../include/passenger_flow.h"
 #include <iostream>
+#include <iomanip>
 #include <cstdlib>
+#include <random>
+#include <chrono>
+#include <algorithm>
+
+// ======================================================================================
+//                                   TICKET LEDGER
+// ======================================================================================
+
+TicketLedger::TicketLedger(size_t capacity) : issued(0) {
+    size_t size = 2;
+    while (size < capacity) size <<= 1;
+    slots = new Slot[size];
+    mask = size - 1;
+    for (size_t i = 0; i < size; i++) {
+        slots[i].busy.store(false, std::memory_order_relaxed);
+        slots[i].serial = 0;
+        slots[i].ticket.name.reserve(TICKET_NAME_RESERVE);
+    }
+}
+
+/**
+ * Function: record
+ * Claims the next serial and swaps 'p' into its slot
+ * Returns: handle of the new ticket
+ */
+TicketHandle TicketLedger::record(Passenger& p) {
+    TicketHandle handle;
+    handle.serial = issued.fetch_add(1, std::memory_order_relaxed) + 1;
+    Slot& slot = slots[handle.serial & mask];
+    lock(slot);
+    std::swap(slot.ticket, p);
+    slot.serial = handle.serial;
+    unlock(slot);
+    return handle;
+}
+
+namespace {
+
+const char* LANE_NAMES[LANE_COUNT] = { "Senior", "Ladies", "General" };
+
+long long steadyNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+int laneOf(PassengerType type) {
+    if (type == SENIOR) return SENIOR_LANE;
+    if (type == LADIES) return LADIES_LANE;
+    return GENERAL_LANE;
+}
+
+} // namespace
+
+// ======================================================================================
+//                                   WAIT-TIME HISTOGRAM
+// ======================================================================================
+
+void WaitHistogram::reset() {
+    std::fill(counts, counts + BUCKETS, 0LL);
+    samples = 0;
+    totalUs = 0;
+    maxUs = 0;
+}
+
+void WaitHistogram::record(long long waitUs) {
+    if (waitUs < 0) waitUs = 0;
+    int bucket = 0;
+    while (bucket < BUCKETS - 1 && (1LL << bucket) <= waitUs) bucket++;
+    counts[bucket]++;
+    samples++;
+    totalUs += waitUs;
+    maxUs = std::max(maxUs, waitUs);
+}
+
+void WaitHistogram::merge(const WaitHistogram& other) {
+    for (int b = 0; b < BUCKETS; b++) counts[b] += other.counts[b];
+    samples += other.samples;
+    totalUs += other.totalUs;
+    maxUs = std::max(maxUs, other.maxUs);
+}
+
+/**
+ * Function: percentile
+ * Walks the buckets until the cumulative count reaches p * samples
+ * Returns: upper edge of that bucket (capped at the observed maximum)
+ */
+long long WaitHistogram::percentile(double p) const {
+    if (samples == 0) return 0;
+    long long rank = std::max(1LL, (long long)(p * samples + 0.999999));
+    long long seen = 0;
+    for (int b = 0; b < BUCKETS; b++) {
+        seen += counts[b];
+        if (seen >= rank) return std::min(1LL << b, maxUs);
+    }
+    return maxUs;
+}
+
+// The first visit moves the cursor onto the senior lane and tops it up
+LaneSchedule::LaneSchedule() : cursor(LANE_COUNT - 1) {
+    std::fill(deficit, deficit + LANE_COUNT, 0);
+}
 
 // ======================================================================================
 //                                   TICKET SYSTEM IMPLEMENTATION
@@ -31,9 +140,55 @@
  *   - Revenue tracking variables
  *   - Ticket counter
  */
-TicketSystem::TicketSystem() {
-    totalTicketsSold = 0;
-    totalRevenue = 0;
+TicketSystem::TicketSystem(bool trackStations)
+    : generalQueue(TICKET_LANE_CAPACITY), ladiesQueue(TICKET_LANE_CAPACITY),
+      seniorQueue(TICKET_LANE_CAPACITY), totalTicketsSold(0), totalRevenue(0),
+      trackStations(trackStations), countersOpen(false),
+      maxWaitNs(DEFAULT_MAX_WAIT_MS * 1000000LL) {
+    setLaneWeights(DEFAULT_SENIOR_WEIGHT, DEFAULT_LADIES_WEIGHT, DEFAULT_GENERAL_WEIGHT);
+    long long now = steadyNowNs();
+    for (int l = 0; l < LANE_COUNT; l++) lastServedNs[l].store(now);
+}
+
+TicketSystem::~TicketSystem() {
+    stopCounters();
+}
+
+/**
+ * Function: emplace
+ * Lock-free insert into the passenger's lane; safe from any thread.
+ * The passenger is written field by field into the claimed cell, so the
+ * name is copied into the buffer the cell already owns (no allocation once
+ * the lanes are warm). The entry is stamped with the enqueue time for the
+ * wait histograms.
+ * 
+ * Returns: false if the lane is full (caller decides to retry or turn away)
+ * Time Complexity: O(1) + name length
+ */
+bool TicketSystem::emplace(int id, const std::string& name, int age, PassengerType type,
+                           int sourceId, int destId) {
+    long long now = steadyNowNs();
+    return lane(laneOf(type)).tryPushWith([&](LaneEntry& cell) {
+        Passenger& p = cell.passenger;
+        p.id = id;
+        p.name.assign(name);
+        p.age = age;
+        p.type = type;
+        p.sourceId = sourceId;
+        p.destId = destId;
+        p.ticketPrice = 0;
+        p.entryTime = 0;
+        cell.queuedAtNs = now;
+    });
+}
+
+// Moves an already-built passenger into its lane
+bool TicketSystem::enqueue(Passenger&& p) {
+    long long now = steadyNowNs();
+    return lane(laneOf(p.type)).tryPushWith([&](LaneEntry& cell) {
+        cell.passenger = std::move(p);
+        cell.queuedAtNs = now;
+    });
 }
 
 /**
@@ -41,89 +196,136 @@ TicketSystem::TicketSystem() {
  * Adds a passenger to the appropriate queue based on passenger type
  * 
  * Parameters:
- *   p - Passenger object containing passenger details
+ *   p - Passenger details (copied into the lane cell in place)
  * 
  * Queue Selection Logic:
  *   - LADIES type → ladiesQueue
  *   - SENIOR type → seniorQueue
  *   - GENERAL/DISABILITY type → generalQueue
  * 
- * Time Complexity: O(1) - Custom MyQueue push operation
- * 
- * Uses: Custom MyQueue data structure (demonstrating linked list-based queue)
+ * Time Complexity: O(1) - lock-free queue push
  */
-void TicketSystem::joinQueue(Passenger p) {
-    if (p.type == LADIES) {
-        ladiesQueue.push(p);
-        std::cout << ">> Passenger " << p.name << " joined LADIES Queue.\n";
-    } else if (p.type == SENIOR) {
-        seniorQueue.push(p);
-        std::cout << ">> Passenger " << p.name << " joined SENIOR Queue.\n";
+void TicketSystem::joinQueue(const Passenger& p) {
+    const char* lane = (p.type == LADIES) ? "LADIES" : (p.type == SENIOR) ? "SENIOR" : "GENERAL";
+    if (emplace(p.id, p.name, p.age, p.type, p.sourceId, p.destId)) {
+        std::cout << ">> Passenger " << p.name << " joined " << lane << " Queue.\n";
     } else {
-        generalQueue.push(p);
-        std::cout << ">> Passenger " << p.name << " joined GENERAL Queue.\n";
+        std::cout << ">> " << lane << " Queue full - passenger " << p.name << " turned away.\n";
     }
 }
 
+BoundedMPMCQueue<LaneEntry>& TicketSystem::lane(int laneId) {
+    if (laneId == SENIOR_LANE) return seniorQueue;
+    if (laneId == LADIES_LANE) return ladiesQueue;
+    return generalQueue;
+}
+
 /**
- * Function: processQueues
- * Processes all queues in priority order using custom MyQueue operations
+ * Function: popLane
+ * Pops from one lane by swapping with 'entry', so the cell keeps entry's
+ * old buffers for the next passenger. The lane counts as served either
+ * way - an empty lane is not starving, so it must not be promoted the
+ * moment someone joins it.
+ */
+bool TicketSystem::popLane(int laneId, LaneEntry& entry, long long now) {
+    bool popped = lane(laneId).tryPopSwap(entry);
+    lastServedNs[laneId].store(now, std::memory_order_relaxed);
+    return popped;
+}
+
+/**
+ * Function: nextPassenger
+ * Picks the next passenger to serve
  * 
- * Processing Order (Priority-based):
- *   1. Senior Citizens Queue (Highest Priority)
- *   2. Ladies Queue (Medium Priority)
- *   3. General Queue (Standard Priority)
+ * Parameters:
+ *   entry - Receives the popped lane entry
+ *   schedule - Caller's deficit round robin state
+ *   laneId - Receives the lane the passenger came from
+ *   now - Current steady-clock time (ns)
  * 
  * Algorithm:
- *   - For each queue in priority order:
- *     - While queue is not empty:
- *       - Get front passenger (MyQueue::front())
- *       - Remove from queue (MyQueue::pop())
- *       - Process ticket (fare calculation, revenue update)
+ *   1. Promotion: any lane with passengers that has not been served for
+ *      maxWaitNs is popped first
+ *   2. Deficit round robin: the lane under the cursor issues tickets while
+ *      its deficit is positive (one unit per ticket). When it runs out, or
+ *      the lane is empty (credit dropped), the cursor moves on and the next
+ *      lane's deficit grows by its weight.
  * 
- * Time Complexity: O(n) where n = total passengers in all queues
+ * Each counter thread keeps its own LaneSchedule, so the scheduler needs no
+ * shared lock; across counters the lanes still receive service in
+ * proportion to their weights.
  * 
- * Uses: Custom MyQueue data structure for FIFO processing within each priority level
+ * Time Complexity: O(LANE_COUNT) per call
+ */
+bool TicketSystem::nextPassenger(LaneEntry& entry, LaneSchedule& schedule, int& laneId, long long now) {
+    for (int l = 0; l < LANE_COUNT; l++) {
+        if (now - lastServedNs[l].load(std::memory_order_relaxed) > maxWaitNs &&
+            !lane(l).emptyApprox() && popLane(l, entry, now)) {
+            laneId = l;
+            return true;
+        }
+    }
+    
+    // At most one visit with leftover credit plus one top-up per lane
+    for (int visit = 0; visit <= LANE_COUNT; visit++) {
+        int l = schedule.cursor;
+        if (schedule.deficit[l] > 0) {
+            if (popLane(l, entry, now)) {
+                schedule.deficit[l]--;
+                laneId = l;
+                return true;
+            }
+            schedule.deficit[l] = 0;
+        }
+        schedule.cursor = (l + 1) % LANE_COUNT;
+        schedule.deficit[schedule.cursor] += laneWeights[schedule.cursor];
+    }
+    return false;
+}
+
+int TicketSystem::getWaitingPassengers() const {
+    return seniorQueue.sizeApprox() + ladiesQueue.sizeApprox() + generalQueue.sizeApprox();
+}
+
+/**
+ * Function: processQueues
+ * Serves every waiting passenger in deficit round robin order
+ * 
+ * Algorithm:
+ *   - While nextPassenger() yields a passenger:
+ *     - Record its queue wait in the lane's histogram
+ *     - Process ticket (fare calculation, revenue update)
+ *   - With the default weights a full round issues 4 senior, 2 ladies and
+ *     1 general ticket, so the general lane keeps moving in a rush
+ * 
+ * Time Complexity: O(n) where n = total passengers in all queues
  * 
  * Real-world scenario: Ticket counter processes waiting passengers
  */
 void TicketSystem::processQueues() {
     std::cout << "\n--- Processing Ticket Queues ---\n";
     
-    // Process Senior Citizens first (Highest Priority)
-    int seniorCount = 0;
-    while (!seniorQueue.empty()) {
-        Passenger p = seniorQueue.front();
-        seniorQueue.pop();
-        processTicket(p);
-        seniorCount++;
-    }
-    if (seniorCount > 0) {
-        std::cout << "  [Priority] Processed " << seniorCount << " senior citizen(s)\n";
-    }
-
-    // Process Ladies (Medium Priority)
-    int ladiesCount = 0;
-    while (!ladiesQueue.empty()) {
-        Passenger p = ladiesQueue.front();
-        ladiesQueue.pop();
-        processTicket(p);
-        ladiesCount++;
-    }
-    if (ladiesCount > 0) {
-        std::cout << "  [Priority] Processed " << ladiesCount << " ladies queue passenger(s)\n";
-    }
-
-    // Process General (Standard Priority)
-    int generalCount = 0;
-    while (!generalQueue.empty()) {
-        Passenger p = generalQueue.front();
-        generalQueue.pop();
-        processTicket(p);
-        generalCount++;
+    LaneSchedule schedule;
+    LaneEntry entry;
+    int laneId;
+    int served[LANE_COUNT] = { 0, 0, 0 };
+    
+    long long now = steadyNowNs();
+    while (nextPassenger(entry, schedule, laneId, now)) {
+        {
+            std::lock_guard<std::mutex> guard(waitStatsLock);
+            laneWaits[laneId].record((now - entry.queuedAtNs) / 1000);
+        }
+        processTicket(entry.passenger);
+        served[laneId]++;
+        now = steadyNowNs();
     }
-    if (generalCount > 0) {
-        std::cout << "  [Standard] Processed " << generalCount << " general queue passenger(s)\n";
+    
+    for (int l = 0; l < LANE_COUNT; l++) {
+        if (served[l] > 0) {
+            std::cout << "  [Weight " << laneWeights[l] << "] Processed " << served[l]
+                      << " " << LANE_NAMES[l] << " lane passenger(s)\n";
+        }
     }
     
     std::cout << "--------------------------------\n";
@@ -134,7 +336,9 @@ void TicketSystem::processQueues() {
  * Processes individual ticket: fare calculation, revenue tracking, station updates
  * 
  * Parameters:
- *   p - Passenger object to process
+ *   p - Passenger to process; handed to the ledger, left holding a recycled record
+ * 
+ * Returns: handle of the issued ticket
  * 
  * Fare Calculation:
  *   - Base fare: Rs. 10
@@ -147,21 +351,19 @@ void TicketSystem::processQueues() {
  *   3. Increment total tickets sold counter
  *   4. Add to total revenue
  *   5. Display ticket details
- *   6. Update station passenger count (for analytics)
+ *   6. Update station passenger count; record boarding / alighting in
+ *      passengerFlow (for analytics)
+ *   7. Record in the ledger (swap, no copy)
  * 
  * Time Complexity: O(1)
  * 
  * Revenue Tracking: Maintains cumulative total for financial analytics
  */
-void TicketSystem::processTicket(Passenger p) {
+TicketHandle TicketSystem::processTicket(Passenger& p) {
     // Fare calculation (base + distance-based component)
     int fare = 10 + (rand() % 50);  // Rs. 10-59
     p.ticketPrice = fare;
     
-    // Update system statistics
-    totalTicketsSold++;
-    totalRevenue += fare;
-    
     // Display ticket information
     std::cout << "[TICKET ISSUED] " << p.name << " | Fare: Rs. " << fare << " | Type: ";
     if (p.type == SENIOR) std::cout << "Senior";
@@ -170,11 +372,135 @@ void TicketSystem::processTicket(Passenger p) {
     std::cout << std::endl;
     
     // Update station analytics (passenger flow tracking)
-    if (p.sourceId >= 0 && (size_t)p.sourceId < allStations.size()) {
-        allStations[p.sourceId].passengerCount++;
+    if (trackStations) {
+        if (p.sourceId >= 0 && (size_t)p.sourceId < allStations.size()) {
+            std::lock_guard<std::mutex> guard(stationMergeLock);
+            allStations[p.sourceId].passengerCount++;
+        }
+        time_t now = time(NULL);
+        passengerFlow.record(p.sourceId, FLOW_BOARDING, now);
+        passengerFlow.record(p.destId, FLOW_ALIGHTING, now);
+    }
+    
+    return issueTicket(p);
+}
+
+void TicketSystem::addStationLoad(int stationId, int passengers) {
+    if (stationId < 0 || (size_t)stationId >= allStations.size()) return;
+    std::lock_guard<std::mutex> guard(stationMergeLock);
+    allStations[stationId].passengerCount += passengers;
+}
+
+/**
+ * Function: issueTicket
+ * Counts the sale and moves the passenger (fare already set) into the ledger
+ * 
+ * Returns: handle for later lookups via withTicket()
+ * Time Complexity: O(1)
+ */
+TicketHandle TicketSystem::issueTicket(Passenger& p) {
+    totalTicketsSold++;
+    totalRevenue += p.ticketPrice;
+    return ledger.record(p);
+}
+
+// ======================================================================================
+//                                   CONCURRENT COUNTERS
+// ======================================================================================
+
+/**
+ * Function: counterLoop
+ * Body of one ticket counter thread
+ * 
+ * Algorithm:
+ *   - Pop the next passenger (own DRR state); issue the ticket silently
+ *   - Totals, station counts and wait histograms are kept locally and flushed
+ *     every FLUSH_EVERY tickets (and when idle), so counters do not fight over
+ *     shared cache lines on every ticket; timed station flow goes straight
+ *     to this thread's passengerFlow shard
+ *   - When all lanes are empty: exit if the counters are closing, else yield
+ */
+void TicketSystem::counterLoop(int counterId) {
+    const int FLUSH_EVERY = 256;
+    std::minstd_rand rng(counterId * 7919 + 1);
+    std::vector<int> stationFlow(trackStations ? allStations.size() : 0, 0);
+    int tickets = 0;
+    long long revenue = 0;
+    LaneSchedule schedule;
+    WaitHistogram waits[LANE_COUNT];
+    
+    auto flush = [&]() {
+        totalTicketsSold += tickets;
+        totalRevenue += revenue;
+        tickets = 0;
+        revenue = 0;
+        {
+            std::lock_guard<std::mutex> guard(waitStatsLock);
+            for (int l = 0; l < LANE_COUNT; l++) {
+                laneWaits[l].merge(waits[l]);
+                waits[l].reset();
+            }
+        }
+        if (!trackStations) return;
+        std::lock_guard<std::mutex> guard(stationMergeLock);
+        for (size_t s = 0; s < stationFlow.size() && s < allStations.size(); s++) {
+            allStations[s].passengerCount += stationFlow[s];
+            stationFlow[s] = 0;
+        }
+    };
+    
+    LaneEntry entry;
+    Passenger& p = entry.passenger;
+    int laneId;
+    while (true) {
+        long long now = steadyNowNs();
+        if (nextPassenger(entry, schedule, laneId, now)) {
+            waits[laneId].record((now - entry.queuedAtNs) / 1000);
+            int fare = 10 + (int)(rng() % 50);  // Rs. 10-59, as processTicket
+            p.ticketPrice = fare;
+            tickets++;
+            revenue += fare;
+            if (trackStations) {
+                if (p.sourceId >= 0 && p.sourceId < (int)stationFlow.size()) stationFlow[p.sourceId]++;
+                int bucket = flowBucketOf(time(NULL));
+                passengerFlow.recordBucket(p.sourceId, FLOW_BOARDING, bucket);
+                passengerFlow.recordBucket(p.destId, FLOW_ALIGHTING, bucket);
+            }
+            ledger.record(p);
+            if (tickets == FLUSH_EVERY) flush();
+        } else if (!countersOpen.load(std::memory_order_acquire)) {
+            break;  // Closed and drained
+        } else {
+            if (tickets > 0) flush();
+            std::this_thread::yield();
+        }
+    }
+    flush();
+}
+
+/**
+ * Function: startCounters
+ * Opens 'count' ticket counters, each a worker thread draining the lanes
+ */
+void TicketSystem::startCounters(int count) {
+    if (!counters.empty()) return;
+    countersOpen.store(true, std::memory_order_release);
+    for (int i = 0; i < count; i++) {
+        counters.push_back(std::thread(&TicketSystem::counterLoop, this, i));
     }
 }
 
+/**
+ * Function: stopCounters
+ * Closes the counters; workers finish every waiting passenger before exiting.
+ * Booking threads must have finished enqueueing before this is called.
+ */
+void TicketSystem::stopCounters() {
+    countersOpen.store(false, std::memory_order_release);
+    for (auto& counter : counters) counter.join();
+    counters.clear();
+}
+
 /**
  * Function: showStats
  * Displays comprehensive ticketing analytics and revenue report
@@ -182,8 +508,9 @@ void TicketSystem::processTicket(Passenger p) {
  * Statistics Shown:
  *   - Total number of tickets sold
  *   - Total revenue collected (in Rupees)
+ *   - Per lane: DRR weight, tickets served, p50 / p99 / max queue wait
  * 
- * Time Complexity: O(1)
+ * Time Complexity: O(LANE_COUNT * WaitHistogram::BUCKETS)
  * 
  * Use Case: Financial reporting, performance metrics, capacity analysis
  */
@@ -198,5 +525,125 @@ void TicketSystem::showStats() {
         std::cout << "Average Fare: Rs. " << avgFare << std::endl;
     }
     
+    std::cout << "\n--- Lane Waits (max-wait promotion: " << maxWaitNs / 1000000 << " ms) ---\n";
+    std::cout << std::left << std::setw(10) << "Lane" << std::setw(8) << "Weight"
+              << std::setw(10) << "Served" << std::setw(12) << "p50 (us)"
+              << std::setw(12) << "p99 (us)" << "Max (us)\n";
+    for (int l = 0; l < LANE_COUNT; l++) {
+        WaitHistogram waits = getLaneWaits(l);
+        std::cout << std::left << std::setw(10) << LANE_NAMES[l] << std::setw(8) << laneWeights[l]
+                  << std::setw(10) << waits.samples << std::setw(12) << waits.percentile(0.50)
+                  << std::setw(12) << waits.percentile(0.99) << waits.maxUs << "\n";
+    }
+    std::cout << std::right;
+    
     std::cout << "=========================================\n";
 }
+
+/**
+ * Function: setLaneWeights
+ * Sets the DRR quantum (tickets per round) of each lane; call while no
+ * counters are open
+ */
+void TicketSystem::setLaneWeights(int senior, int ladies, int general) {
+    laneWeights[SENIOR_LANE] = std::max(1, senior);
+    laneWeights[LADIES_LANE] = std::max(1, ladies);
+    laneWeights[GENERAL_LANE] = std::max(1, general);
+}
+
+void TicketSystem::setMaxWaitMs(int ms) {
+    maxWaitNs = std::max(1, ms) * 1000000LL;
+}
+
+WaitHistogram TicketSystem::getLaneWaits(int laneId) {
+    std::lock_guard<std::mutex> guard(waitStatsLock);
+    return laneWaits[laneId];
+}
+
+// ======================================================================================
+//                                   COUNTER RUSH SIMULATION
+// ======================================================================================
+
+/**
+ * Function: runCounterRush
+ * Rush-hour stress run on a private TicketSystem (global stats untouched)
+ * 
+ * Parameters:
+ *   counters - Counter worker threads
+ *   bookingThreads - Producer threads (UTS app, ATVMs, windows)
+ *   passengers - Total passengers across all producers
+ * 
+ * Mix: 10% senior, 30% ladies, 60% general. A producer that finds its lane
+ * full yields and retries (back-pressure from the bounded queue).
+ * Passengers are emplaced straight into the lane cells.
+ */
+CounterRushResult runCounterRush(int counters, int bookingThreads, int passengers) {
+    TicketSystem rush(false);
+    int stationCount = allStations.empty() ? 1 : (int)allStations.size();
+    
+    auto start = std::chrono::steady_clock::now();
+    rush.startCounters(counters);
+    
+    std::vector<std::thread> producers;
+    for (int b = 0; b < bookingThreads; b++) {
+        producers.push_back(std::thread([&rush, b, bookingThreads, passengers, stationCount]() {
+            const std::string name = "Rush Hour Passenger";
+            for (int i = b; i < passengers; i += bookingThreads) {
+                PassengerType type = (i % 10 == 0) ? SENIOR : (i % 10 < 4) ? LADIES : GENERAL;
+                while (!rush.emplace(i, name, 30, type, i % stationCount, (i * 7) % stationCount)) {
+                    std::this_thread::yield();
+                }
+            }
+        }));
+    }
+    for (auto& producer : producers) producer.join();
+    rush.stopCounters();
+    
+    CounterRushResult result;
+    result.counters = counters;
+    result.bookingThreads = bookingThreads;
+    result.passengers = rush.getTotalTickets();
+    result.elapsedMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+    result.ticketsPerSecond = result.elapsedMs > 0 ? result.passengers * 1000.0 / result.elapsedMs : 0;
+    for (int l = 0; l < LANE_COUNT; l++) result.p99WaitUs[l] = rush.getLaneWaits(l).percentile(0.99);
+    return result;
+}
+
+void showCounterRushScaling(int passengers) {
+    int cores = std::max(1u, std::thread::hardware_concurrency());
+    int bookingThreads = std::max(2, cores / 2);
+    std::streamsize oldPrecision = std::cout.precision();
+    
+    std::cout << "\n========== Rush Hour: Concurrent Ticket Counters ==========\n";
+    std::cout << "Passengers: " << passengers << " | Booking threads: " << bookingThreads
+              << " | Cores: " << cores << "\n\n";
+    std::cout << std::left << std::setw(12) << "Counters"
+              << std::setw(14) << "Time (ms)"
+              << std::setw(18) << "Tickets/sec"
+              << std::setw(10) << "Speedup"
+              << "p99 wait S/L/G (us)\n";
+    std::cout << "------------------------------------------------------------------------------\n";
+    
+    double baseline = 0;
+    for (int counters = 1; ; counters *= 2) {
+        if (counters > cores) counters = cores;
+        CounterRushResult r = runCounterRush(counters, bookingThreads, passengers);
+        if (baseline == 0) baseline = r.ticketsPerSecond;
+        
+        std::cout << std::left << std::setw(12) << r.counters
+                  << std::setw(14) << std::fixed << std::setprecision(1) << r.elapsedMs
+                  << std::setw(18) << std::setprecision(0) << r.ticketsPerSecond
+                  << std::setprecision(2) << std::setw(10)
+                  << (baseline > 0 ? r.ticketsPerSecond / baseline : 0)
+                  << r.p99WaitUs[SENIOR_LANE] << " / " << r.p99WaitUs[LADIES_LANE]
+                  << " / " << r.p99WaitUs[GENERAL_LANE] << "\n";
+        if (r.passengers != passengers) {
+            std::cout << "  ! " << passengers - r.passengers << " passengers not served\n";
+        }
+        if (counters == cores) break;
+    }
+    std::cout << "------------------------------------------------------------------------------\n";
+    std::cout.unsetf(std::ios::fixed);
+    std::cout.precision(oldPrecision);
+}